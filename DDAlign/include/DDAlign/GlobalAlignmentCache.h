@@ -34,6 +34,12 @@ namespace dd4hep {
      *  Internaly the instances are fragmented to subdetectors defined
      *  by the next-to-top level detector elements.
      *
+     *  In batched mode a commit first applies all node changes without
+     *  any overlap check. The voxels of every affected mother volume are
+     *  then rebuilt exactly once and the requested overlap checks are
+     *  executed on the final geometry. The overlap candidates of a mother
+     *  volume are only searched if one of its aligned daughters requested a check.
+     *
      *  \author   M.Frank
      *  \version  1.0
      *  \ingroup  DD4HEP_ALIGN
@@ -49,6 +55,17 @@ namespace dd4hep {
       typedef std::map<unsigned int, TGeoPhysicalNode*>   Cache;
       typedef std::map<std::string,GlobalAlignmentCache*> SubdetectorAlignments;
 
+      /// Deferred operations of a batched commit
+      /**
+       *  \version  1.0
+       *  \ingroup  DD4HEP_ALIGN
+       */
+      class Staging  {
+      public:
+        /// All aligned physical nodes with the requested overlap precision (<0: no check)
+        std::vector<std::pair<TGeoPhysicalNode*,double> > nodes;
+      };
+
     protected:
       Detector&       m_detDesc;
       /// Cache of subdetectors
@@ -64,6 +81,10 @@ namespace dd4hep {
       int         m_refCount;
       /// Flag to indicate the top instance
       bool        m_top;
+      /// Flag to apply the changes of a commit in batched mode
+      bool        m_batched = false;
+      /// Staging area of the currently running batched commit (if any)
+      Staging*    m_staging = 0;
 
     protected:
       /// Default constructor initializing variables
@@ -80,6 +101,8 @@ namespace dd4hep {
       void apply(const std::vector<Entry*> &changes);
       /// Add a new entry to the cache. The key is the placement path
       bool insert(GlobalAlignment alignment);
+      /// Execute the deferred voxel rebuilds and overlap checks of a batched commit
+      void finalize(Staging& staging);
 
     public:
       /// Create and install a new instance tree
@@ -92,6 +115,10 @@ namespace dd4hep {
       int release();
       /// Access the section name
       const std::string& name() const   {   return m_sdPath;  }
+      /// Access the batched commit flag
+      bool batched() const              {   return m_batched;  }
+      /// Enable or disable batched commits
+      void setBatched(bool value)       {   m_batched = value; }
       /// Close existing transaction stack and apply all alignments
       void commit(GlobalAlignmentStack& stack);
       /// Retrieve the cache section corresponding to the path of an entry.
@@ -44,6 +44,10 @@ namespace dd4hep {
       GlobalAlignmentOperator(GlobalAlignmentCache& c, Nodes& n) : cache(c), nodes(n) {}
       /// Insert alignment entry
       void insert(GlobalAlignment alignment)  const;
+      /// Check if the alignments are applied within a batched commit
+      bool staging()  const;
+      /// Stage an aligned node for the final voxel rebuild and overlap check (precision<0: no check)
+      void stage(GlobalAlignment alignment, double precision)  const;
     };
 
     /// Select alignment operations according to certain criteria
@@ -20,6 +20,11 @@
 
 // ROOT include files
 #include <TGeoManager.h>
+#include <TGeoVoxelFinder.h>
+#include <TGeoPhysicalNode.h>
+
+// C/C++ include files
+#include <map>
 
 using namespace dd4hep::align;
 using Entry = GlobalAlignmentStack::StackEntry;
@@ -198,12 +203,22 @@ void GlobalAlignmentCache::apply(GlobalAlignmentStack& stack)    {
       detelt_updates.emplace(e->detector.path(),e->detector);
     }
   }
+  Staging staging;
   for(sd_entries_t::iterator i=all.begin(); i!=all.end(); ++i)  {
     DetElement det((*i).first);
     GlobalAlignmentCache* sd_cache = subdetectorAlignments(det.placement().name());
+    /// Ensure the staging area is detached from the section also in the event of exceptions
+    struct StagingGuard  {
+      GlobalAlignmentCache* c;
+      StagingGuard(GlobalAlignmentCache* sd, Staging* s) : c(sd) { c->m_staging = s; }
+      ~StagingGuard()  { c->m_staging = 0; }
+    } guard(sd_cache, m_batched ? &staging : 0);
     sd_cache->apply( (*i).second );
     (*i).second.clear();
   }
+  if ( m_batched )  {
+    finalize(staging);
+  }
 
   printout(INFO,"GlobalAlignmentCache","Alignments were applied. Refreshing physical nodes....");
   mgr.GetCurrentNavigator()->ResetAll();
@@ -235,6 +250,43 @@ void GlobalAlignmentCache::apply(GlobalAlignmentStack& stack)    {
   }
 }
 
+/// Execute the deferred voxel rebuilds and overlap checks of a batched commit
+void GlobalAlignmentCache::finalize(Staging& staging)   {
+  std::map<TGeoVolume*,bool> volumes;
+  std::size_t num_voxels = 0, num_checks = 0;
+  // Collect the mother volumes and if any of their aligned daughters requested an overlap check
+  for( const auto& n : staging.nodes )  {
+    TGeoPhysicalNode* pn = n.first;
+    TGeoVolume*       vm = pn->GetLevel() > 0 ? pn->GetVolume(pn->GetLevel()-1) : 0;
+    if ( vm )  {
+      volumes[vm] |= n.second >= 0e0;
+    }
+  }
+  // Rebuild the voxels of every mother volume only once
+  for( const auto& v : volumes )  {
+    TGeoVoxelFinder* voxels = v.first->GetVoxels();
+    if ( voxels && voxels->NeedRebuild() )  {
+      voxels->Voxelize();
+      if ( v.second ) v.first->FindOverlaps();
+      ++num_voxels;
+    }
+  }
+  // Now check the overlaps of the aligned nodes in the final geometry
+  for( const auto& n : staging.nodes )  {
+    if ( n.second >= 0e0 )  {
+      TGeoNode* node = n.first->GetNode();
+      if ( node )  {
+        node->CheckOverlaps(n.second);
+        ++num_checks;
+      }
+    }
+  }
+  printout(INFO,"GlobalAlignmentCache",
+           "Batched commit: %ld aligned nodes, %ld volumes voxelized, %ld overlap checks.",
+           long(staging.nodes.size()), long(num_voxels), long(num_checks));
+  staging.nodes.clear();
+}
+
 /// Apply a vector of SD entries of ordered alignments to the geometry structure
 void GlobalAlignmentCache::apply(const std::vector<Entry*>& changes)   {
   std::map<std::string,std::pair<TGeoPhysicalNode*,Entry*> > nodes;
@@ -29,6 +29,16 @@ void GlobalAlignmentOperator::insert(GlobalAlignment alignment)  const   {
   }
 }
 
+bool GlobalAlignmentOperator::staging()  const   {
+  return cache.m_staging != 0;
+}
+
+void GlobalAlignmentOperator::stage(GlobalAlignment alignment, double precision)  const   {
+  if ( cache.m_staging )   {
+    cache.m_staging->nodes.emplace_back(alignment.ptr(), precision);
+  }
+}
+
 void GlobalAlignmentSelector::operator()(Entries::value_type e)  const {
   TGeoPhysicalNode* pn = 0;
   nodes.emplace(e->path,std::make_pair(pn,e));
@@ -109,6 +119,8 @@ template <> void GlobalAlignmentActor<DDAlign_standard_operations::node_reset>::
 template <> void GlobalAlignmentActor<DDAlign_standard_operations::node_align>::operator()(Nodes::value_type& n) const  {
   Entry&     e       = *n.second.second;
   bool       overlap = GlobalAlignmentStack::overlapDefined(e);
+  bool       check   = GlobalAlignmentStack::checkOverlap(e);
+  bool       batched = staging();
   DetElement det     = e.detector;
 
   if ( !det->global_alignment.isValid() && !GlobalAlignmentStack::hasMatrix(e) )  {
@@ -140,15 +152,19 @@ template <> void GlobalAlignmentActor<DDAlign_standard_operations::node_align>::
   else if ( delta.checkFlag(Delta::HAVE_TRANSLATION) )
     trafo = Transform3D(delta.translation);
 
-  if ( GlobalAlignmentStack::checkOverlap(e) && overlap )
+  // In batched mode the overlap checks are deferred until all nodes are aligned
+  if ( check && !batched && overlap )
     align = no_vol ? ad.align(trafo,ovl_precision,e.overlap) : ad.align(e.path,trafo,ovl_precision,e.overlap);
-  else if ( GlobalAlignmentStack::checkOverlap(e) )
+  else if ( check && !batched )
     align = no_vol ? ad.align(trafo,ovl_precision) : ad.align(e.path,trafo,ovl_precision);
   else
     align = no_vol ? ad.align(trafo) : ad.align(e.path,trafo);
 
   if ( align.isValid() )  {
+    // Deferred check with the same arguments as above: a zero precision disables the check
+    bool check_ovl = check && ovl_precision != 0e0;
     insert(align);
+    stage(align, check_ovl ? (overlap ? e.overlap : 0.001) : -1e0);
     return;
   }
   except("GlobalAlignmentActor","Failed to apply alignment for "+e.path);
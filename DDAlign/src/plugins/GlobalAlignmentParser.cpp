@@ -29,6 +29,7 @@
 
 // C/C++ include files
 #include <stdexcept>
+#include <cstring>
 
 namespace dd4hep  {
 
@@ -273,13 +274,19 @@ long dd4hep::setup_Alignment(dd4hep::Detector& description, const xml_h& e)  {
 DECLARE_XML_DOC_READER(global_alignment,setup_Alignment)
 
 /** Basic entry point to install the alignment cache in a Detector instance
+ *
+ *  Arguments: -batch   Apply the alignments of a transaction in batched mode
  *
  *  @author  M.Frank
  *  @version 1.0
  *  @date    01/04/2014
  */
-static long install_Alignment(dd4hep::Detector& description, int, char**) {
-  GlobalAlignmentCache::install(description);
+static long install_Alignment(dd4hep::Detector& description, int argc, char** argv) {
+  GlobalAlignmentCache* cache = GlobalAlignmentCache::install(description);
+  for(int i = 0; i < argc && argv[i]; ++i)  {
+    if ( 0 == ::strncmp(argv[i],"-batch",4) )
+      cache->setBatched(true);
+  }
   return 1;
 }
 DECLARE_APPLY(DD4hep_GlobalAlignmentInstall,install_Alignment)
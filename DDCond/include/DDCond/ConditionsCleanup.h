@@ -15,6 +15,10 @@
 
 // Framework include files
 #include "DDCond/ConditionsPool.h"
+#include "DDCond/ConditionsIOVIndex.h"
+
+// C/C++ include files
+#include <vector>
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
@@ -43,6 +47,14 @@ namespace dd4hep {
       virtual bool operator()(const ConditionsIOVPool& iov_pool)  const;
       /// Request cleanup operation of regular conditiions pool
       virtual bool operator()(const ConditionsPool& pool)  const;
+      /// Optional fast pre-selection of the pools to be inspected using the IOV index
+      /** If true is returned, only the pools with the entry numbers in 'candidates'
+       *  are passed to operator()(const ConditionsPool&). Otherwise all pools are inspected.
+       *  The default implementation returns false.
+       */
+      virtual bool preselect(const ConditionsIOVPool&  iov_pool,
+                             const ConditionsIOVIndex& index,
+                             std::vector<std::size_t>& candidates)  const;
     };
 
    /// Base class to handle conditions cleanups
@@ -67,6 +79,39 @@ namespace dd4hep {
       /// Request cleanup operation of regular conditiions pool
       virtual bool operator()(const ConditionsPool& pool)  const  override;
     };
+
+    /// Cleanup of all conditions pools with a validity ending before a given IOV key value
+    /**
+     *  Uses the IOV index of the pools: only the expired pools are visited.
+     *
+     *  \version 1.0
+     *  \ingroup DD4HEP_CONDITIONS
+     */
+    class ConditionsExpiredCleanup : public ConditionsCleanup {
+    public:
+      /// IOV type to be cleaned
+      const IOVType*      iovType = 0;
+      /// All pools with an upper IOV key below this value are removed
+      IOV::Key_value_type limit   = IOV::MIN_KEY;
+    public:
+      /// Initializing constructor
+      ConditionsExpiredCleanup(const IOVType* typ, IOV::Key_value_type lim)
+        : iovType(typ), limit(lim)  {}
+      /// Copy constructor
+      ConditionsExpiredCleanup(const ConditionsExpiredCleanup& c) = default;
+      /// Default destructor
+      virtual ~ConditionsExpiredCleanup() = default;
+      /// Assignment operator
+      ConditionsExpiredCleanup& operator=(const ConditionsExpiredCleanup& c) = default;
+      /// Request cleanup operation of IOV POOL
+      virtual bool operator()(const ConditionsIOVPool& iov_pool)  const  override;
+      /// Request cleanup operation of regular conditiions pool
+      virtual bool operator()(const ConditionsPool& pool)  const  override;
+      /// Pre-select the expired pools using the IOV index
+      virtual bool preselect(const ConditionsIOVPool&  iov_pool,
+                             const ConditionsIOVIndex& index,
+                             std::vector<std::size_t>& candidates)  const  override;
+    };
   } /* End namespace cond                   */
 } /* End namespace dd4hep                   */
 
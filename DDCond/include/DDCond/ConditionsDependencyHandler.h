@@ -18,6 +18,11 @@
 #include "DD4hep/ConditionDerived.h"
 #include "DDCond/ConditionsPool.h"
 #include "DDCond/ConditionsManager.h"
+#include "DD4hep/detail/ConditionsArena.h"
+
+// C/C++ include files
+#include <atomic>
+#include <memory>
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
@@ -44,11 +49,21 @@ namespace dd4hep {
      *  ConditionResolver interface in order to allow for upgrades of
      *  this implementation which might not be polymorph.
      *
+     *  If the conditions manager property "DerivedConditionsThreads" is larger
+     *  than 1, both passes are executed concurrently: the dependency graph
+     *  is built from the declared dependencies of the items to be computed and
+     *  independent callbacks are executed by a pool of worker threads as soon
+     *  as all their declared dependencies are available. Conditions accessed
+     *  through undeclared dependencies are computed on demand or waited for.
+     *  If the declared dependencies are circular the sequential mode is used.
+     *
      *  \author  M.Frank
      *  \version 1.0
      */
     class ConditionsDependencyHandler : public ConditionResolver {
     public:
+      /// Forward declaration of the concurrent work scheduler
+      class Scheduler;
       /// Obect state definitions
       enum State  {  INVALID, CREATED, RESOLVED };
       /// Helper structure to define the current update item
@@ -105,13 +120,19 @@ namespace dd4hep {
       Work*                       m_block = 0;
       /// Current item of the block
       Work*                       m_currentWork = 0;
+      /// Scheduler of the concurrent execution (if enabled)
+      std::unique_ptr<Scheduler>  m_scheduler;
+      /// Arena for the derived conditions: the one of the creating thread (if any)
+      detail::ConditionsArena*    m_arena = 0;
     public:
       /// Number of callbacks to the handler for monitoring
-      mutable size_t              num_callback;
+      mutable std::atomic<size_t> num_callback;
 
     protected:
       /// Internal call to trigger update callback
       void do_callback(Work* dep);
+      /// Access to the item currently worked on by this thread
+      Work*& currentWork();
 
     public:
       /// Initializing constructor
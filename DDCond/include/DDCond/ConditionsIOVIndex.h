@@ -0,0 +1,96 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+//==========================================================================
+#ifndef DDCOND_CONDITIONSIOVINDEX_H
+#define DDCOND_CONDITIONSIOVINDEX_H
+
+// Framework include files
+#include "DD4hep/IOV.h"
+
+// C/C++ include files
+#include <map>
+#include <memory>
+#include <vector>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for implementation details of the AIDA detector description toolkit
+  namespace cond {
+
+    /// Forward declarations
+    class ConditionsPool;
+
+    /// Interval index over the IOV ranges of the conditions pools of one IOV type
+    /**
+     *  The entries are kept in the order of the IOV keys (lower bound first).
+     *  A max-segment tree over the upper bounds allows to find all IOV ranges
+     *  containing a given range in O(log(N) + K), an array sorted by the upper
+     *  bounds answers overlap and expiry queries with binary searches.
+     *
+     *  The index is immutable once built. It is rebuilt by the ConditionsIOVPool
+     *  whenever the pool elements change. Query results are entry numbers in
+     *  ascending IOV key order, i.e. the iteration order of the elements map.
+     *
+     *  \version 1.0
+     *  \ingroup DD4HEP_CONDITIONS
+     */
+    class ConditionsIOVIndex  {
+    public:
+      typedef std::shared_ptr<ConditionsPool>       Element;
+      typedef std::map<IOV::Key, Element>           Elements;
+      typedef const Elements::value_type*           Entry;
+      typedef IOV::Key_value_type                   value_type;
+
+    protected:
+      /// Index entries in IOV key order
+      std::vector<Entry>       m_entries;
+      /// Lower bounds of the entries (sorted)
+      std::vector<value_type>  m_lower;
+      /// Entry numbers sorted by the upper bound of the IOV range
+      std::vector<std::size_t> m_byUpper;
+      /// Upper bounds in the order of m_byUpper
+      std::vector<value_type>  m_upper;
+      /// Max-segment tree of the upper bounds (leaves in entry order)
+      std::vector<value_type>  m_maxUpper;
+      /// Number of leaves of the segment tree
+      std::size_t              m_leaves = 0;
+
+      /// Collect all entries in [0,limit) with an upper bound >= value
+      void _collect(std::size_t node, std::size_t lo, std::size_t hi,
+                    std::size_t limit, value_type value,
+                    std::vector<std::size_t>& result)  const;
+
+    public:
+      /// Default constructor
+      ConditionsIOVIndex() = default;
+      /// Default destructor
+      ~ConditionsIOVIndex() = default;
+      /// (Re)build the index from the elements of an IOV pool
+      void build(const Elements& elements);
+      /// Remove all entries
+      void clear();
+      /// Number of indexed entries
+      std::size_t size()  const                 {  return m_entries.size();   }
+      /// Check if the index has entries
+      bool empty()  const                       {  return m_entries.empty();  }
+      /// Access index entry
+      Entry entry(std::size_t i)  const         {  return m_entries[i];       }
+      /// Entries with an IOV range fully containing the requested range
+      std::size_t containing(const IOV::Key& range, std::vector<std::size_t>& result)  const;
+      /// Entries contained in the range or overlapping with one of its ends
+      /** Same selection as IOV::key_is_contained || IOV::key_overlaps_lower_end || IOV::key_overlaps_higher_end */
+      std::size_t overlapping(const IOV::Key& range, std::vector<std::size_t>& result)  const;
+      /// Entries, whose validity ends before the given value (upper bound < value)
+      std::size_t endingBefore(value_type value, std::vector<std::size_t>& result)  const;
+    };
+  }        /* End namespace cond                            */
+}          /* End namespace dd4hep                          */
+#endif // DDCOND_CONDITIONSIOVINDEX_H
@@ -15,10 +15,14 @@
 
 // Framework include files
 #include "DDCond/ConditionsPool.h"
+#include "DDCond/ConditionsIOVIndex.h"
 
 // C/C++ include files
 #include <map>
+#include <mutex>
+#include <atomic>
 #include <memory>
+#include <shared_mutex>
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
@@ -31,6 +35,17 @@ namespace dd4hep {
      *  Purely internal class to the conditions manager implementation.
      *  Not at all to be accessed by clients!
      *
+     *  The selection functions may be called concurrently: they only take a shared lock.
+     *  Modifications of the elements (registration of new IOV pools, cleanup)
+     *  and insertions into the hosted conditions pools require the exclusive lock.
+     *  User pools populating the IOV pool with loaded or computed conditions
+     *  are serialized with the populate lock.
+     *
+     *  The selections use an interval index over the IOV keys of the elements,
+     *  which is rebuilt whenever the elements change. The aging of pools, which
+     *  do not match a selection, is accounted with a selection counter and is
+     *  only propagated to ConditionsPool::age_value when the pool is cleaned.
+     *
      *  \author  M.Frank
      *  \version 1.0
      *  \ingroup DD4HEP_CONDITIONS
@@ -42,16 +57,44 @@ namespace dd4hep {
       /// Shortcut name for the actual conditions container
       typedef std::map<IOV::Key, Element >    Elements;      
 
-      /// Container of IOV dependent conditions pools
+      /// Container of IOV dependent conditions pools. Modify only using insert() or clean()!
+      /** Direct modifications must be followed by a call to invalidateIndex().  */
       Elements elements;     //! Not ROOT persistent
       /// Reference to the IOV container
       const IOVType* type;   //! Not ROOT persistent
-      
+      /// Reader-writer lock protecting the elements and the content of the hosted pools
+      mutable std::shared_timed_mutex lock;   //! Not ROOT persistent
+      /// Lock serializing the user pools, which populate this IOV pool with loaded or computed conditions
+      std::mutex populateLock;   //! Not ROOT persistent
+
+    protected:
+      /// Interval index of the elements
+      ConditionsIOVIndex       m_index;         //! Not ROOT persistent
+      /// Lock protecting a lazy rebuild of the index under the shared lock
+      std::mutex               m_indexLock;     //! Not ROOT persistent
+      /// Generation of the elements: incremented with every modification
+      std::atomic<unsigned long> m_generation {1};      //! Not ROOT persistent
+      /// Generation of the elements when the index was built
+      std::atomic<unsigned long> m_indexGeneration {0}; //! Not ROOT persistent
+      /// Number of selections contributing to the aging of the pools
+      std::atomic<long>        m_epoch {0};     //! Not ROOT persistent
+
+      /// Mark pools selected by an aging selection
+      void _select(ConditionsPool* pool, long epoch);
+      /// Propagate the accumulated aging to all pools. Requires the exclusive lock.
+      void _updateAges();
+
     public:
       /// Default constructor
       ConditionsIOVPool(const IOVType* type);
       /// Default destructor
       virtual ~ConditionsIOVPool();
+      /// Register a new conditions pool. Requires the exclusive lock.
+      bool insert(const IOV::Key& key, Element pool);
+      /// Access the interval index of the elements. Requires at least the shared lock.
+      const ConditionsIOVIndex& index();
+      /// Force a rebuild of the index after direct modifications of the elements. Requires the exclusive lock.
+      void invalidateIndex()   {  ++m_generation;  }
       /// Retrieve  a condition set given the key according to their validity
       size_t select(Condition::key_type key, const IOV& req_validity, RangeConditions& result);
       /// Retrieve  a condition set given the key according to their validity
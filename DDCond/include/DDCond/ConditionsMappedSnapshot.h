@@ -0,0 +1,166 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+//==========================================================================
+#ifndef DDCOND_CONDITIONSMAPPEDSNAPSHOT_H
+#define DDCOND_CONDITIONSMAPPEDSNAPSHOT_H
+
+// Framework include files
+#include "DDCond/ConditionsPool.h"
+#include "DDCond/ConditionsManager.h"
+
+// C/C++ include files
+#include <map>
+#include <list>
+#include <string>
+#include <vector>
+#include <memory>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for implementation details of the AIDA detector description toolkit
+  namespace cond {
+
+    /// Forward declarations
+    class ConditionsIOVPool;
+
+    /// Helper to save and load conditions snapshots in a memory mapped binary format
+    /**
+     *  Compact, versioned binary counterpart of the ConditionsRootPersistency.
+     *  The snapshot file is mapped into memory when opened (copy-on-write) and
+     *  nothing is read until conditions are imported:
+     *
+     *  - Plain data payloads (fundamental types, Position, RotationZYX,
+     *    Translation3D, alignment Delta) are not copied: the conditions
+     *    data blocks point directly into the mapped file. Processes mapping
+     *    the same file share the physical memory of these payloads.
+     *  - Vectors of fundamental types are stored as contiguous arrays
+     *    and are materialized with a single copy without any parsing.
+     *  - All other payloads are stored in their string representation
+     *    and converted using the data grammar when imported.
+     *
+     *  Snapshots may also be published to a shared memory arena, which worker
+     *  processes on the same node attach to read-only (see publish() and attach()).
+     *  Then the plain data payloads of all processes are backed by one single
+     *  copy in physical memory. Such payloads must not be modified.
+     *
+     *  Derived conditions are not saved: they shall be recomputed.
+     *  Since imported conditions may reference the mapped memory, the snapshot
+     *  object must stay alive as long as the imported conditions are in use.
+     *
+     *  Usage:
+     *    ConditionsMappedSnapshot snap;
+     *    snap.add("run-pools", *manager.iovPool(*iov_typ));
+     *    snap.save("Conditions.snapshot");
+     *    ...
+     *    auto in = ConditionsMappedSnapshot::open("Conditions.snapshot");
+     *    in->import("*", "run", manager);
+     *
+     *  Sharing between processes:
+     *    snap.publish("alignments");                   // Once per node
+     *    auto in = ConditionsMappedSnapshot::attach("alignments");
+     *
+     *  \version 1.0
+     */
+    class ConditionsMappedSnapshot  {
+    public:
+      typedef std::vector<Condition>                                  pool_type;
+      typedef std::pair<std::string,std::pair<std::pair<std::string,int>,IOV::Key> > iov_key_type;
+      typedef std::list<std::pair<iov_key_type, pool_type> >          persistent_type;
+      typedef std::map<Condition::key_type,Condition>                 loaded_type;
+
+      /// Mapping modes of snapshot files
+      enum MapMode  {
+        /// Private copy-on-write mapping: payloads may be modified by the process
+        COPY_ON_WRITE   = 0,
+        /// Shared read-only mapping: payloads are immutable
+        SHARED_READONLY = 1
+      };
+
+      /// Conditions pools to be saved
+      persistent_type pools {};
+      /// Time spent in the last save, open or import operation
+      float           duration = 0;
+
+    protected:
+      /// Start of the mapped file
+      const unsigned char* m_address = 0;
+      /// Length of the mapped file
+      std::size_t          m_length  = 0;
+      /// Name of the mapped file
+      std::string          m_fileName;
+      /// Mapping mode of the file
+      int                  m_mode    = COPY_ON_WRITE;
+
+      /// Create and register the conditions of one mapped pool
+      std::size_t _import(std::size_t pool_index,
+                          const std::vector<Condition::key_type>* keys,
+                          ConditionsManager mgr,
+                          loaded_type* loaded);
+
+    public:
+      /// Default constructor
+      ConditionsMappedSnapshot() = default;
+      /// No copy constructor
+      ConditionsMappedSnapshot(const ConditionsMappedSnapshot& copy) = delete;
+      /// Default destructor. Unmaps the file.
+      virtual ~ConditionsMappedSnapshot();
+      /// No assignment
+      ConditionsMappedSnapshot& operator=(const ConditionsMappedSnapshot& copy) = delete;
+
+      /// Clear object content and release allocated memory
+      void clear();
+      /// Add conditions content to be saved. Note, that dependent conditions shall not be saved!
+      std::size_t add(const std::string& identifier, const IOV& iov, std::vector<Condition>& conditions);
+      /// Add conditions content to be saved. Note, that dependent conditions shall not be saved!
+      std::size_t add(const std::string& identifier, ConditionsPool& pool);
+      /// Add conditions content to be saved. Note, that dependent conditions shall not be saved!
+      std::size_t add(const std::string& identifier, const UserPool& pool);
+      /// Add conditions content to be saved. Note, that dependent conditions shall not be saved!
+      std::size_t add(const std::string& identifier, const ConditionsIOVPool& pool);
+      /// Save the data content to a snapshot file. Returns the number of bytes written.
+      std::size_t save(const std::string& file_name);
+      /// Publish the data content to the shared memory arena of the given name
+      /** The arena is replaced atomically: processes attaching concurrently either
+       *  see the previous or the new content. Existing attachments stay valid.
+       *  Returns the number of bytes written.
+       */
+      std::size_t publish(const std::string& arena);
+
+      /// Map a snapshot file into memory
+      static std::unique_ptr<ConditionsMappedSnapshot> open(const std::string& file_name,
+                                                            int mode = COPY_ON_WRITE);
+      /// Attach read-only to a shared memory arena created with publish()
+      static std::unique_ptr<ConditionsMappedSnapshot> attach(const std::string& arena);
+      /// Location of a shared memory arena (/dev/shm if present, else the temporary directory)
+      static std::string arenaPath(const std::string& arena);
+      /// Check if the payloads are mapped read-only
+      bool isReadOnly()  const                {  return m_mode == SHARED_READONLY;  }
+      /// Name of the mapped file
+      const std::string& fileName()  const    {  return m_fileName;      }
+      /// Check if a snapshot file is mapped
+      bool isMapped()  const                  {  return 0 != m_address;  }
+      /// Number of conditions in the mapped file
+      std::size_t numConditions()  const;
+      /// Import all conditions of the mapped pools with matching identifier and IOV type
+      std::size_t import(const std::string& id, const std::string& iov_type, ConditionsManager mgr);
+      /// Import the requested conditions from the mapped pools valid for the required IOV
+      /** The IOV of the imported conditions is intersected with 'validity'.
+       *  Conditions already present in the conditions manager are not created twice.
+       */
+      std::size_t import(const IOV& required,
+                         const std::vector<Condition::key_type>& keys,
+                         ConditionsManager mgr,
+                         loaded_type& loaded,
+                         IOV& validity);
+    };
+  }        /* End namespace cond                            */
+}          /* End namespace dd4hep                          */
+#endif // DDCOND_CONDITIONSMAPPEDSNAPSHOT_H
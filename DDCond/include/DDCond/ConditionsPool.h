@@ -19,6 +19,7 @@
 #include "DDCond/ConditionsManager.h"
 
 // C/C++ include files
+#include <atomic>
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
@@ -63,8 +64,14 @@ namespace dd4hep {
       };
       /// The IOV of the conditions hosted
       IOV* iov;
-      /// Aging value
-      int  age_value;
+      /// Aging value. Atomic, since it is updated by concurrent selections.
+      /** Note: The value is only updated when the pool is selected or cleaned.
+       *  In between the actual age is age_value plus the number of selections
+       *  of the hosting ConditionsIOVPool since age_epoch.
+       */
+      std::atomic<int> age_value;
+      /// Selection count of the hosting ConditionsIOVPool at the last aging update (-1: not registered)
+      std::atomic<long> age_epoch;
 
     public:
       /// Listener invocation when a condition is registered to the cache
@@ -0,0 +1,119 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+//==========================================================================
+#ifndef DDCOND_CONDITIONSPREFETCHER_H
+#define DDCOND_CONDITIONSPREFETCHER_H
+
+// Framework include files
+#include "DDCond/ConditionsSlice.h"
+
+// C/C++ include files
+#include <future>
+#include <memory>
+#include <mutex>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for implementation details of the AIDA detector description toolkit
+  namespace cond {
+
+    /// Asynchronous preparation of conditions slices for upcoming IOVs
+    /**
+     *  When the event loop is about to reach a new IOV (e.g. the next run
+     *  number is known from the input), prefetch() loads the conditions using
+     *  the ConditionsDataLoader and computes the derived conditions on a
+     *  background thread into a fresh ConditionsSlice.
+     *
+     *  The event loop calls get() for every required IOV:
+     *  - if the current slice is valid, it is returned immediately,
+     *  - if the prefetched slice covers the IOV, it is swapped in
+     *    (waiting for the background preparation to finish if necessary),
+     *  - otherwise a new slice is prepared synchronously.
+     *
+     *  Slices handed out by get() stay valid as long as they are referenced
+     *  by the client, even if the prefetcher already swapped in the next one.
+     *
+     *  Note:
+     *  The registration of conditions to the manager (registerUnlocked,
+     *  blockRegister) takes the lock of the IOV pool. Conditions may hence
+     *  be registered while a prefetch is running.
+     *
+     *  The user context passed to prefetch() is not copied. It is used by the
+     *  background thread and must stay valid until the prefetched slice was
+     *  taken by get() or the prefetch was discarded (by a prefetch() for
+     *  another IOV, clear() or the destructor).
+     *
+     *  \version 1.0
+     *  \ingroup DD4HEP_CONDITIONS
+     */
+    class ConditionsPrefetcher  {
+    public:
+      typedef std::shared_ptr<ConditionsSlice>   Slice;
+      typedef std::shared_ptr<ConditionsContent> Content;
+
+    protected:
+      /// Reference to the conditions manager
+      ConditionsManager       m_manager;
+      /// Conditions content of all slices
+      Content                 m_content;
+      /// Flags applied to newly created slices (see ConditionsSlice::flags)
+      unsigned long           m_sliceFlags = 0;
+      /// Currently active slice
+      Slice                   m_current;
+      /// Slice being prepared in the background
+      Slice                   m_next;
+      /// IOV requested for the background preparation
+      IOV                     m_nextIOV {0};
+      /// Result handle of the background preparation
+      std::future<ConditionsManager::Result> m_pending;
+      /// Protection of the slice handles
+      mutable std::mutex      m_lock;
+
+      /// Create a new empty slice
+      Slice _newSlice()  const;
+      /// Wait for the background preparation and take the result. Requires the lock.
+      Slice _wait(ConditionsManager::Result& result);
+      /// Check if the background preparation finished. Requires the lock.
+      bool _ready()  const;
+
+    public:
+      /// Initializing constructor
+      ConditionsPrefetcher(ConditionsManager mgr, const Content& content, unsigned long slice_flags=0);
+      /// Inhibit copy constructor
+      ConditionsPrefetcher(const ConditionsPrefetcher& copy) = delete;
+      /// Default destructor. Waits for a pending background preparation
+      ~ConditionsPrefetcher();
+      /// Inhibit assignment
+      ConditionsPrefetcher& operator=(const ConditionsPrefetcher& copy) = delete;
+
+      /// Start the asynchronous preparation of a slice for the expected IOV
+      /** Returns false if no new preparation was started, because the current
+       *  or the already prefetched slice covers the IOV.
+       *  A previously pending preparation for another IOV is discarded.
+       *  The user context must outlive the background preparation.
+       */
+      bool prefetch(const IOV& iov, ConditionUpdateUserContext* ctxt=0);
+      /// Check if a prefetched slice (ready or not) is available for the IOV
+      bool isPrefetched(const IOV& iov)  const;
+      /// Access a slice valid for the required IOV. Swaps in the prefetched slice if possible.
+      /** Waits only for a pending preparation of the same IOV. A pending
+       *  preparation for another IOV is left alone and the slice is
+       *  prepared synchronously.
+       */
+      Slice get(const IOV& iov, ConditionUpdateUserContext* ctxt=0);
+      /// Access the current slice (may be empty)
+      Slice current()  const;
+      /// Wait for and drop any pending prefetch. Releases the current slice.
+      void clear();
+    };
+  }        /* End namespace cond               */
+}          /* End namespace dd4hep                   */
+#endif // DDCOND_CONDITIONSPREFETCHER_H
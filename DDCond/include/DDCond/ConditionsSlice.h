@@ -17,6 +17,7 @@
 #include "DD4hep/Conditions.h"
 #include "DD4hep/ConditionsMap.h"
 #include "DD4hep/ConditionDerived.h"
+#include "DD4hep/detail/ConditionsArena.h"
 
 #include "DDCond/ConditionsPool.h"
 #include "DDCond/ConditionsContent.h"
@@ -114,6 +115,8 @@ namespace dd4hep {
       ContainedPools            used_pools;
       /// Flag to steer conditions management
       unsigned long             flags = 0;
+      /// Optional arena for the derived conditions computed for this slice (see useArena)
+      std::shared_ptr<detail::ConditionsArena> arena;
       
     protected:
       /// If flag conditonsManager["OutputUnloadedConditions"]=true: will contain conditions not loaded
@@ -149,6 +152,13 @@ namespace dd4hep {
       void refPools()       { this->flags |= REF_POOLS;                                      }
       /// Set flag to not reference the used pools during prepare (and drop possibly pending)
       void derefPools();
+      /// Allocate the derived conditions and their payloads from an arena owned by the slice
+      /** The arena moves to a new memory chunk at every reset(). Chunks are
+       *  released as a whole once all conditions allocated from them are gone.
+       *  Derived conditions are registered to the IOV pools: a condition
+       *  valid for many IOVs keeps its chunk until the pool is purged.
+       */
+      void useArena(std::size_t chunk_size = detail::ConditionsArena::DEFAULT_CHUNK_SIZE);
       /// Access the map of conditions from the desired content
       const ConditionsContent::Conditions& conditions() const { return content->conditions();}
       /// Access the map of computational conditions from the desired content
@@ -0,0 +1,97 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+//==========================================================================
+#ifndef DDCOND_CONDITIONSXMLSTREAMREADER_H
+#define DDCOND_CONDITIONSXMLSTREAMREADER_H
+
+// Framework include files
+#include "DD4hep/Conditions.h"
+#include "DDCond/ConditionsManager.h"
+
+// C/C++ include files
+#include <set>
+#include <map>
+#include <string>
+#include <vector>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for implementation details of the AIDA detector description toolkit
+  namespace cond {
+
+    /// Streaming reader of XML conditions repositories
+    /**
+     *  Reads the same file format as the DOM based plugin
+     *  DD4hep_ConditionsXMLRepositoryParser:
+     *  <repository>, <manager>, <iov_type>, <iov>, <detelement> sections with
+     *  <value>, <pressure>, <temperature>, <sequence>, <mapping> and
+     *  <alignment_delta> conditions. Referenced files (attribute 'ref') are
+     *  read recursively.
+     *
+     *  The input is tokenized in fixed size blocks and every condition is
+     *  converted and registered as soon as its closing tag is seen: no
+     *  document tree is built and the memory footprint does not depend on
+     *  the file size. Conditions are registered to the IOV pools in blocks.
+     *  Numeric attributes, which are plain numbers, are converted directly;
+     *  only expressions are passed to the expression evaluator and the unit
+     *  values are evaluated once per unit.
+     *
+     *  Optionally only conditions with selected keys are created.
+     *
+     *  \version 1.0
+     *  \ingroup DD4HEP_CONDITIONS
+     */
+    class ConditionsXmlStreamReader  {
+    public:
+      /// Conversion state. Local to every parse() call
+      class State;
+
+    protected:
+      /// Reference to the detector description
+      Detector&                     m_detector;
+      /// Conditions manager receiving the conditions
+      ConditionsManager             m_manager;
+      /// Optional selection of condition keys to be created
+      std::set<Condition::key_type> m_keys;
+      /// Cache of evaluated unit values
+      std::map<std::string,double>  m_units;
+
+      /// Process one file
+      void _parse(const std::string& file_name, State& state);
+      /// Fast conversion of numeric attribute values
+      double _number(const std::string& value);
+      /// Evaluate unit, cache the result
+      double _unit(const std::string& unit);
+
+    public:
+      /// Number of conditions created by the last call to parse()
+      std::size_t numConditions = 0;
+      /// Number of files read by the last call to parse()
+      std::size_t numFiles      = 0;
+
+    public:
+      /// Initializing constructor
+      ConditionsXmlStreamReader(Detector& description, ConditionsManager mgr);
+      /// Inhibit copy constructor
+      ConditionsXmlStreamReader(const ConditionsXmlStreamReader& copy) = delete;
+      /// Default destructor
+      ~ConditionsXmlStreamReader() = default;
+      /// Inhibit assignment
+      ConditionsXmlStreamReader& operator=(const ConditionsXmlStreamReader& copy) = delete;
+
+      /// Only create conditions with the given keys. An empty selection accepts all.
+      void select(const std::vector<Condition::key_type>& keys);
+      /// Read conditions file. Returns the number of conditions registered
+      std::size_t parse(const std::string& file_name);
+    };
+  }        /* End namespace cond               */
+}          /* End namespace dd4hep                   */
+#endif // DDCOND_CONDITIONSXMLSTREAMREADER_H
@@ -62,6 +62,8 @@ namespace dd4hep {
       std::string             m_userType;
       /// Property: Conditions loader type (default: "multi" -> DD4hep_Conditions_multi_Loader)
       std::string             m_loaderType;
+      /// Property: Name of a shared conditions arena to be attached by the loader (requires multi-loader)
+      std::string             m_sharedArena;
 
       /// Collection of IOV types managed
       std::vector<IOVType>    m_iovTypes;
@@ -13,6 +13,7 @@
 
 // Framework include files
 #include "DDCond/ConditionsCleanup.h"
+#include "DDCond/ConditionsIOVPool.h"
 
 using namespace dd4hep::cond;
 
@@ -28,6 +29,14 @@ bool ConditionsCleanup::operator()(const ConditionsPool & /* iov_pool */) const
   return true;
 }
 
+/// Optional fast pre-selection of the pools to be inspected using the IOV index
+bool ConditionsCleanup::preselect(const ConditionsIOVPool&  /* iov_pool   */,
+                                  const ConditionsIOVIndex& /* index      */,
+                                  std::vector<std::size_t>& /* candidates */)  const
+{
+  return false;
+}
+
 /// Request cleanup operation of IOV POOL
 bool ConditionsFullCleanup::operator()(const ConditionsIOVPool & /* iov_pool */) const
 {
@@ -39,3 +48,24 @@ bool ConditionsFullCleanup::operator()(const ConditionsPool & /* iov_pool */) co
 {
   return true;
 }
+
+/// Request cleanup operation of IOV POOL
+bool ConditionsExpiredCleanup::operator()(const ConditionsIOVPool& iov_pool) const
+{
+  return iov_pool.type == iovType;
+}
+
+/// Request cleanup operation of regular conditiions pool
+bool ConditionsExpiredCleanup::operator()(const ConditionsPool& pool) const
+{
+  return pool.iov && pool.iov->keyData.second < limit;
+}
+
+/// Pre-select the expired pools using the IOV index
+bool ConditionsExpiredCleanup::preselect(const ConditionsIOVPool&  /* iov_pool */,
+                                         const ConditionsIOVIndex& index,
+                                         std::vector<std::size_t>& candidates)  const
+{
+  index.endingBefore(limit, candidates);
+  return true;
+}
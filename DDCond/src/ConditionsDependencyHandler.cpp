@@ -16,11 +16,24 @@
 #include <DDCond/ConditionsManagerObject.h>
 #include <DD4hep/ConditionsProcessor.h>
 #include <DD4hep/Printout.h>
+#include <DD4hep/detail/WorkerPool.h>
 #include <TTimeStamp.h>
 
+// C/C++ include files
+#include <condition_variable>
+#include <algorithm>
+#include <shared_mutex>
+#include <exception>
+#include <thread>
+#include <mutex>
+#include <deque>
+
 using namespace dd4hep::cond;
 
 namespace {
+  /// Item currently worked on by this thread if the handler executes concurrently
+  thread_local ConditionsDependencyHandler::Work* s_currentWork = nullptr;
+
   std::string dependency_name(const ConditionDependency* d)  {
 #if defined(DD4HEP_CONDITIONS_HAVE_NAME)
     return d->target.name;
@@ -59,13 +72,223 @@ ConditionsDependencyHandler::Work::resolve(Work*& current)   {
   return condition;
 }
 
+/// Concurrent execution of the dependency handler's work items
+/**
+ *  The items are scheduled according to the graph of their declared
+ *  dependencies: an item is handed to a worker thread once all the items
+ *  it depends on are processed. Items accessed by callbacks outside this
+ *  order are processed on demand by the accessing thread or, if another
+ *  thread already works on them, waited for.
+ */
+class ConditionsDependencyHandler::Scheduler  {
+public:
+  /// Processing passes: 1rst pass create, 2nd pass resolve
+  enum Pass   { CREATE = 0, RESOLVE = 1 };
+  /// Processing state of an item within one pass
+  enum Status { IDLE = 0, CLAIMED = 1, DONE = 2 };
+  /// Scheduling information of one work item
+  struct Slot  {
+    /// Indices of the items with a declared dependency to this item
+    std::vector<std::size_t> children;
+    /// Number of declared dependencies to other items
+    std::size_t              num_parents = 0;
+    /// Number of dependencies not yet processed in the current pass
+    std::size_t              pending     = 0;
+    /// Processing status per pass
+    Status                   status[2]   = { IDLE, IDLE };
+    /// Thread processing the item per pass
+    std::thread::id          owner[2];
+  };
+  typedef std::pair<std::size_t, Pass> Wait;
+
+  /// Reference to the handler
+  ConditionsDependencyHandler& handler;
+  /// Scheduling information indexed by the position of the item in the work block
+  std::vector<Slot>                 slots;
+  /// Items ready to be processed
+  std::deque<std::size_t>           ready;
+  /// Items currently waited for by threads: used to detect dead-locks
+  std::map<std::thread::id, Wait>   waiting;
+  /// Lock protecting the scheduling information
+  std::mutex                        lock;
+  /// Signal changes of the scheduling information
+  std::condition_variable           signal;
+  /// Lock protecting the user pool against concurrent insertions
+  std::shared_timed_mutex           pool_lock;
+  /// First error encountered by any thread
+  std::exception_ptr                error;
+  /// Number of items processed in the current pass
+  std::size_t                       num_done    = 0;
+  /// Number of threads to be used
+  std::size_t                       num_threads = 1;
+
+public:
+  /// Initializing constructor
+  Scheduler(ConditionsDependencyHandler& h, std::size_t nthreads)
+    : handler(h), slots(h.m_todo.size()), num_threads(nthreads)
+  {
+    for( const auto& i : handler.m_todo )   {
+      std::size_t idx = index(i.second);
+      for( const auto& d : i.second->context.dependency->dependencies )   {
+        auto j = handler.m_todo.find(d.hash);
+        if ( j != handler.m_todo.end() && j->second != i.second )  {
+          slots[index(j->second)].children.emplace_back(idx);
+          ++slots[idx].num_parents;
+        }
+      }
+    }
+  }
+  /// Index of a work item
+  std::size_t index(const Work* w)  const   {
+    return std::size_t(w - handler.m_block);
+  }
+  /// Check if the declared dependencies are free of cycles
+  bool acyclic()  const   {
+    std::vector<std::size_t> pending(slots.size()), todo;
+    for( std::size_t i = 0; i < slots.size(); ++i )   {
+      pending[i] = slots[i].num_parents;
+      if ( 0 == pending[i] ) todo.emplace_back(i);
+    }
+    std::size_t num_sorted = 0;
+    while ( !todo.empty() )   {
+      std::size_t idx = todo.back();
+      todo.pop_back();
+      ++num_sorted;
+      for( std::size_t c : slots[idx].children )
+        if ( 0 == --pending[c] ) todo.emplace_back(c);
+    }
+    return num_sorted == slots.size();
+  }
+  /// Check if the thread 'owner' (directly or indirectly) waits for the calling thread
+  bool waits_for_me(std::thread::id owner)  const   {
+    const std::thread::id me = std::this_thread::get_id();
+    for( std::size_t n = 0; n <= waiting.size(); ++n )   {
+      if ( owner == me ) return true;
+      auto i = waiting.find(owner);
+      if ( i == waiting.end() ) return false;
+      const Slot& slot = slots[i->second.first];
+      // The waiting thread was already signalled, but did not yet wake up
+      if ( slot.status[i->second.second] != CLAIMED ) return false;
+      owner = slot.owner[i->second.second];
+    }
+    return true;
+  }
+  /// Process the work item for the given pass unless this is already done
+  void process(Work* w, Pass pass)   {
+    std::size_t idx = index(w);
+    Slot& slot = slots[idx];
+    std::unique_lock<std::mutex> guard(lock);
+    while ( slot.status[pass] == CLAIMED )   {
+      if ( waits_for_me(slot.owner[pass]) )   {
+        // Circular access: resolution accepts cross-dependencies like the
+        // sequential handler, creation cannot be completed.
+        if ( pass == RESOLVE ) return;
+        except("DependencyHandler",
+               "++ Handler caught in infinite recursion loop. Key:%s",
+               w->context.dependency->target.toString().c_str());
+      }
+      waiting[std::this_thread::get_id()] = Wait(idx, pass);
+      signal.wait(guard);
+      waiting.erase(std::this_thread::get_id());
+    }
+    if ( slot.status[pass] == DONE )   {
+      return;
+    }
+    if ( error )   {
+      except("DependencyHandler","++ Processing aborted due to a previous error.");
+    }
+    slot.status[pass] = CLAIMED;
+    slot.owner[pass]  = std::this_thread::get_id();
+    guard.unlock();
+    try  {
+      if ( pass == CREATE )   {
+        if ( !w->condition )  {
+          handler.do_callback(w);
+          if ( !w->condition )  {
+            except("DependencyHandler",
+                   "Derived condition was not created after calling the creation callback!");
+          }
+        }
+      }
+      else if ( w->state != RESOLVED )   {
+        Work*& current = s_currentWork;
+        if ( current )   {     // Access from another item's callback
+          w->resolve(current);
+        }
+        else   {               // Top level item of a worker thread
+          current = w;
+          w->resolve(current);
+          current = nullptr;
+        }
+      }
+    }
+    catch(...)   {
+      guard.lock();
+      if ( !error ) error = std::current_exception();
+      slot.status[pass] = DONE;
+      signal.notify_all();
+      throw;
+    }
+    guard.lock();
+    slot.status[pass] = DONE;
+    signal.notify_all();
+  }
+  /// Worker thread: process items as long as there are some ready
+  void work(Pass pass)   {
+    dd4hep::detail::ConditionsArena::Scope arena(handler.m_arena);
+    std::unique_lock<std::mutex> guard(lock);
+    s_currentWork = nullptr;
+    for(;;)   {
+      while ( ready.empty() && !error && num_done < slots.size() )
+        signal.wait(guard);
+      if ( ready.empty() || error )
+        break;
+      std::size_t idx = ready.front();
+      ready.pop_front();
+      guard.unlock();
+      try  {
+        process(handler.m_block + idx, pass);
+      }
+      catch(...)   {
+        guard.lock();
+        if ( !error ) error = std::current_exception();
+        signal.notify_all();
+        break;
+      }
+      guard.lock();
+      ++num_done;
+      for( std::size_t c : slots[idx].children )   {
+        if ( 0 == --slots[c].pending ) ready.emplace_back(c);
+      }
+      signal.notify_all();
+    }
+  }
+  /// Execute one pass using the shared worker threads. The calling thread participates.
+  void execute(Pass pass)   {
+    Work* previous = s_currentWork;
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      ready.clear();
+      num_done = 0;
+      for( std::size_t i = 0; i < slots.size(); ++i )   {
+        slots[i].pending = slots[i].num_parents;
+        if ( 0 == slots[i].pending ) ready.emplace_back(i);
+      }
+    }
+    std::size_t nthreads = std::min(num_threads, slots.size());
+    dd4hep::detail::WorkerPool::instance().run(nthreads, [this, pass] { work(pass); });
+    s_currentWork = previous;
+    if ( error ) std::rethrow_exception(error);
+  }
+};
+
 /// Default constructor
 ConditionsDependencyHandler::ConditionsDependencyHandler(ConditionsManager   mgr,
                                                          UserPool&           pool,
                                                          const Dependencies& dependencies,
                                                          ConditionUpdateUserContext* user_param)
   : m_manager(mgr.access()), m_pool(pool), m_dependencies(dependencies),
-    m_userParam(user_param), num_callback(0)
+    m_userParam(user_param), m_arena(detail::ConditionsArena::current()), num_callback(0)
 {
   const IOV& iov = m_pool.validity();
   unsigned char* p = new unsigned char[dependencies.size()*sizeof(Work)];
@@ -76,10 +299,22 @@ ConditionsDependencyHandler::ConditionsDependencyHandler(ConditionsManager   mgr
     p += sizeof(Work);
   }
   m_iovType = iov.iovType;
+  int nthreads = m_manager->derivedThreads();
+  if ( nthreads < 0 ) nthreads = int(std::thread::hardware_concurrency());
+  if ( nthreads > 1 && m_todo.size() > 1 )   {
+    m_scheduler.reset(new Scheduler(*this, std::size_t(nthreads)));
+    if ( !m_scheduler->acyclic() )   {
+      printout(WARNING,"DependencyHandler",
+               "+++ Circular dependencies among %ld derived conditions. "
+               "Using sequential processing.", m_todo.size());
+      m_scheduler.reset();
+    }
+  }
 }
 
 /// Default destructor
 ConditionsDependencyHandler::~ConditionsDependencyHandler()   {
+  m_scheduler.reset();
   m_todo.clear();
   if ( m_block ) delete [] m_block;
   m_block = 0;
@@ -90,9 +325,22 @@ dd4hep::Detector& ConditionsDependencyHandler::detectorDescription() const  {
   return m_manager->detectorDescription();
 }
 
+/// Access to the item currently worked on by this thread
+ConditionsDependencyHandler::Work*& ConditionsDependencyHandler::currentWork()   {
+  return m_scheduler ? s_currentWork : m_currentWork;
+}
+
 /// 1rst pass: Compute/create the missing conditions
 void ConditionsDependencyHandler::compute()   {
   m_state = CREATED;
+  if ( m_scheduler )   {
+    TTimeStamp start;
+    m_scheduler->execute(Scheduler::CREATE);
+    TTimeStamp stop;
+    printout(DEBUG,"DependencyHandler","Computed %ld derived conditions with %ld threads [%7.5f seconds]",
+             m_todo.size(), m_scheduler->num_threads, stop.AsDouble()-start.AsDouble());
+    return;
+  }
   for( const auto& i : m_todo )   {
     if ( !i.second->condition )  {
       do_callback(i.second);
@@ -114,11 +362,16 @@ void ConditionsDependencyHandler::resolve()    {
   Work* w;
 
   m_state = RESOLVED;
+  if ( m_scheduler )   {
+    m_scheduler->execute(Scheduler::RESOLVE);
+  }
   for( const auto& c : m_todo )   {
     w = c.second;
-    m_currentWork = w;
-    if ( w->state != RESOLVED )   {
-      w->resolve(m_currentWork);
+    if ( !m_scheduler )   {
+      m_currentWork = w;
+      if ( w->state != RESOLVED )   {
+        w->resolve(m_currentWork);
+      }
     }
     ++num_resolved;
     // Fill an empty map of condition vectors for the block inserts
@@ -160,12 +413,20 @@ void ConditionsDependencyHandler::resolve()    {
 
 /// Interface to handle multi-condition inserts by callbacks: One single insert
 bool ConditionsDependencyHandler::registerOne(const IOV& iov, Condition cond)    {
+  if ( m_scheduler )   {
+    std::lock_guard<std::shared_timed_mutex> guard(m_scheduler->pool_lock);
+    return m_pool.registerOne(iov, cond);
+  }
   return m_pool.registerOne(iov, cond);
 }
 
 /// Handle multi-condition inserts by callbacks: block insertions of conditions with identical IOV
 std::size_t
 ConditionsDependencyHandler::registerMany(const IOV& iov, const std::vector<Condition>& values)   {
+  if ( m_scheduler )   {
+    std::lock_guard<std::shared_timed_mutex> guard(m_scheduler->pool_lock);
+    return m_pool.registerMany(iov, values);
+  }
   return m_pool.registerMany(iov, values);
 }
 
@@ -190,8 +451,14 @@ ConditionsDependencyHandler::getByItem(Condition::itemkey_type key)   {
       }
     };
     item_selector proc(key);
-    m_pool.scan(conditionsProcessor(proc));
-    for (auto c : proc.conditions ) m_currentWork->do_intersection(c->iov);
+    if ( m_scheduler )   {
+      std::shared_lock<std::shared_timed_mutex> guard(m_scheduler->pool_lock);
+      m_pool.scan(conditionsProcessor(proc));
+    }
+    else   {
+      m_pool.scan(conditionsProcessor(proc));
+    }
+    for (auto c : proc.conditions ) currentWork()->do_intersection(c->iov);
     return proc.conditions;
   }
   except("DependencyHandler",
@@ -205,8 +472,15 @@ ConditionsDependencyHandler::get(Condition::detkey_type det_key)   {
   if ( m_state == RESOLVED )   {
     ConditionKey::KeyMaker lower(det_key, Condition::FIRST_ITEM_KEY);
     ConditionKey::KeyMaker upper(det_key, Condition::LAST_ITEM_KEY);
-    std::vector<Condition> conditions = m_pool.get(lower.hash, upper.hash);
-    for (auto c : conditions ) m_currentWork->do_intersection(c->iov);
+    std::vector<Condition> conditions;
+    if ( m_scheduler )   {
+      std::shared_lock<std::shared_timed_mutex> guard(m_scheduler->pool_lock);
+      conditions = m_pool.get(lower.hash, upper.hash);
+    }
+    else   {
+      conditions = m_pool.get(lower.hash, upper.hash);
+    }
+    for (auto c : conditions ) currentWork()->do_intersection(c->iov);
     return conditions;
   }
   except("DependencyHandler",
@@ -227,26 +501,40 @@ ConditionsDependencyHandler::get(Condition::key_type key,
                                  bool throw_if_not)
 {
   /// If we are not already resolving here, we follow the normal procedure
-  Condition c = m_pool.get(key);
+  Condition c;
+  if ( m_scheduler )   {
+    std::shared_lock<std::shared_timed_mutex> guard(m_scheduler->pool_lock);
+    c = m_pool.get(key);
+  }
+  else   {
+    c = m_pool.get(key);
+  }
   if ( c.isValid() )  {
-    m_currentWork->do_intersection(c->iov);
+    currentWork()->do_intersection(c->iov);
     return c;
   }
   auto i = m_todo.find(key);
-  if ( i != m_todo.end() )   {
+  if ( i != m_todo.end() && m_scheduler )   {
+    Work* w = i->second;
+    m_scheduler->process(w, Scheduler::CREATE);
+    m_scheduler->process(w, Scheduler::RESOLVE);
+    if ( w->condition )
+      return w->condition;
+  }
+  else if ( i != m_todo.end() )   {
     Work* w = i->second;
     if ( w->state == RESOLVED )   {
       return w->condition;
     }
     else if ( w->state == CREATED )   {
-      return w->resolve(m_currentWork);
+      return w->resolve(currentWork());
     }
     else if ( w->state == INVALID )  {
       do_callback(w);
       if ( w->condition && w->state == RESOLVED ) // cross-dependencies...
         return w->condition;
       else if ( w->condition )
-        return w->resolve(m_currentWork);
+        return w->resolve(currentWork());
     }
   }
   if ( throw_if_not )  {
@@ -293,8 +581,9 @@ ConditionsDependencyHandler::get(Condition::key_type key,
 void ConditionsDependencyHandler::do_callback(Work* work)   {
   const ConditionDependency* dep = work->context.dependency;
   try  {
-    Work* previous  = m_currentWork;
-    m_currentWork   = work;
+    Work*& current  = currentWork();
+    Work*  previous = current;
+    current         = work;
     if ( work->callstack > 0 )   {
       // if we end up here it means a previous construction call never finished
       // because the bugger tried to access another condition, which in turn
@@ -313,7 +602,7 @@ void ConditionsDependencyHandler::do_callback(Work* work)   {
     ++work->callstack;
     work->condition = (*dep->callback)(dep->target, work->context).ptr();
     --work->callstack;
-    m_currentWork   = previous;
+    current         = previous;
     if ( work->condition )  {
       if ( !work->iov )  {
         work->_iov = IOV(m_iovType,IOV::Key(IOV::MIN_KEY, IOV::MAX_KEY));
@@ -0,0 +1,113 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+//==========================================================================
+
+// Framework include files
+#include <DDCond/ConditionsIOVIndex.h>
+
+// C/C++ include files
+#include <algorithm>
+
+using namespace dd4hep::cond;
+
+/// Remove all entries
+void ConditionsIOVIndex::clear()   {
+  m_entries.clear();
+  m_lower.clear();
+  m_byUpper.clear();
+  m_upper.clear();
+  m_maxUpper.clear();
+  m_leaves = 0;
+}
+
+/// (Re)build the index from the elements of an IOV pool
+void ConditionsIOVIndex::build(const Elements& elements)   {
+  std::size_t n = elements.size();
+  clear();
+  m_entries.reserve(n);
+  m_lower.reserve(n);
+  for( const auto& e : elements )  {
+    m_entries.emplace_back(&e);
+    m_lower.emplace_back(e.first.first);
+  }
+  m_byUpper.resize(n);
+  for( std::size_t i=0; i<n; ++i ) m_byUpper[i] = i;
+  std::stable_sort(m_byUpper.begin(), m_byUpper.end(), [this](std::size_t a, std::size_t b)
+                   { return m_entries[a]->first.second < m_entries[b]->first.second; });
+  m_upper.reserve(n);
+  for( std::size_t i : m_byUpper )
+    m_upper.emplace_back(m_entries[i]->first.second);
+
+  const value_type min_key = IOV::MIN_KEY;
+  for( m_leaves = 1; m_leaves < n; m_leaves <<= 1 ) {}
+  m_maxUpper.assign(2*m_leaves, min_key);
+  for( std::size_t i=0; i<n; ++i )
+    m_maxUpper[m_leaves+i] = m_entries[i]->first.second;
+  for( std::size_t i=m_leaves-1; i>0; --i )
+    m_maxUpper[i] = std::max(m_maxUpper[2*i], m_maxUpper[2*i+1]);
+}
+
+/// Collect all entries in [0,limit) with an upper bound >= value
+void ConditionsIOVIndex::_collect(std::size_t node, std::size_t lo, std::size_t hi,
+                                  std::size_t limit, value_type value,
+                                  std::vector<std::size_t>& result)  const
+{
+  if ( lo >= limit || m_maxUpper[node] < value )
+    return;
+  else if ( hi-lo == 1 )
+    result.emplace_back(lo);
+  else  {
+    std::size_t mid = (lo+hi)/2;
+    _collect(2*node,   lo,  mid, limit, value, result);
+    _collect(2*node+1, mid, hi,  limit, value, result);
+  }
+}
+
+/// Entries with an IOV range fully containing the requested range
+std::size_t ConditionsIOVIndex::containing(const IOV::Key& range, std::vector<std::size_t>& result)  const   {
+  std::size_t len = result.size();
+  if ( !m_entries.empty() )   {
+    // Candidates: lower bound <= range.first. Of these select upper bound >= range.second
+    std::size_t limit = std::upper_bound(m_lower.begin(), m_lower.end(), range.first) - m_lower.begin();
+    _collect(1, 0, m_leaves, limit, range.second, result);
+  }
+  return result.size() - len;
+}
+
+/// Entries contained in the range or overlapping with one of its ends
+std::size_t ConditionsIOVIndex::overlapping(const IOV::Key& range, std::vector<std::size_t>& result)  const   {
+  std::size_t len = result.size();
+  if ( !m_entries.empty() )   {
+    // Lower bound within the range: contiguous in entry order
+    std::size_t lo_begin = std::lower_bound(m_lower.begin(), m_lower.end(), range.first)  - m_lower.begin();
+    std::size_t lo_end   = std::upper_bound(m_lower.begin(), m_lower.end(), range.second) - m_lower.begin();
+    for( std::size_t i=lo_begin; i<lo_end; ++i )
+      result.emplace_back(i);
+    // Upper bound within the range, but not yet selected by the lower bound
+    std::size_t up_begin = std::lower_bound(m_upper.begin(), m_upper.end(), range.first)  - m_upper.begin();
+    std::size_t up_end   = std::upper_bound(m_upper.begin(), m_upper.end(), range.second) - m_upper.begin();
+    for( std::size_t i=up_begin; i<up_end; ++i )   {
+      std::size_t e = m_byUpper[i];
+      if ( e < lo_begin || e >= lo_end )
+        result.emplace_back(e);
+    }
+    std::sort(result.begin()+len, result.end());
+  }
+  return result.size() - len;
+}
+
+/// Entries, whose validity ends before the given value (upper bound < value)
+std::size_t ConditionsIOVIndex::endingBefore(value_type value, std::vector<std::size_t>& result)  const   {
+  std::size_t len = result.size();
+  std::size_t end = std::lower_bound(m_upper.begin(), m_upper.end(), value) - m_upper.begin();
+  result.insert(result.end(), m_byUpper.begin(), m_byUpper.begin()+end);
+  std::sort(result.begin()+len, result.end());
+  return result.size() - len;
+}
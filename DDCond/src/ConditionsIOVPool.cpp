@@ -20,8 +20,16 @@
 
 #include <DD4hep/detail/ConditionsInterna.h>
 
+// C/C++ include files
+#include <mutex>
+
 using namespace dd4hep::cond;
 
+namespace {
+  typedef std::shared_lock<std::shared_timed_mutex> read_lock_t;
+  typedef std::lock_guard<std::shared_timed_mutex>  write_lock_t;
+}
+
 /// Default constructor
 ConditionsIOVPool::ConditionsIOVPool(const IOVType* typ) : type(typ)  {
   InstanceCount::increment(this);
@@ -38,16 +46,64 @@ ConditionsIOVPool::~ConditionsIOVPool()  {
   InstanceCount::decrement(this);
 }
 
+/// Register a new conditions pool. Requires the exclusive lock.
+bool ConditionsIOVPool::insert(const IOV::Key& key, Element pool)   {
+  if ( elements.emplace(key, pool).second )   {
+    pool->age_epoch = m_epoch.load();
+    invalidateIndex();
+    return true;
+  }
+  return false;
+}
+
+/// Access the interval index of the elements. Requires at least the shared lock.
+const ConditionsIOVIndex& ConditionsIOVPool::index()   {
+  // Under the shared lock the elements cannot change: concurrent readers either
+  // see a valid index or all of them wait for the one rebuilding it.
+  unsigned long generation = m_generation.load();
+  if ( m_indexGeneration.load() != generation )   {
+    std::lock_guard<std::mutex> guard(m_indexLock);
+    if ( m_indexGeneration.load() != generation )   {
+      long epoch = m_epoch.load();
+      m_index.build(elements);
+      for( const auto& e : elements )  {
+        long unset = -1;   // Pools inserted directly into the elements
+        e.second->age_epoch.compare_exchange_strong(unset, epoch);
+      }
+      m_indexGeneration = generation;
+    }
+  }
+  return m_index;
+}
+
+/// Mark pools selected by an aging selection
+void ConditionsIOVPool::_select(ConditionsPool* pool, long epoch)   {
+  long last = pool->age_epoch.load();
+  while( last < epoch && !pool->age_epoch.compare_exchange_weak(last, epoch) ) {}
+  pool->age_value = 0;
+}
+
+/// Propagate the accumulated aging to all pools. Requires the exclusive lock.
+void ConditionsIOVPool::_updateAges()   {
+  long epoch = m_epoch.load();
+  for( const auto& e : elements )  {
+    ConditionsPool* p = e.second.get();
+    if ( p->age_epoch >= 0 )
+      p->age_value += int(epoch - p->age_epoch);
+    p->age_epoch = epoch;
+  }
+}
+
 size_t ConditionsIOVPool::select(Condition::key_type key, const IOV& req_validity, RangeConditions& result)
 {
+  read_lock_t guard(lock);
   if ( !elements.empty() )  {
+    const ConditionsIOVIndex& idx = index();
+    std::vector<std::size_t> matches;
     size_t len = result.size();
-    const IOV::Key req_key = req_validity.key(); // 16 bytes => better copy!
-    for( const auto& e : elements )  {
-      if ( IOV::key_contains_range(e.first, req_key) )  {
-        e.second->select(key, result);
-      }
-    }
+    idx.containing(req_validity.key(), matches);
+    for( std::size_t i : matches )
+      idx.entry(i)->second->select(key, result);
     return result.size() - len;
   }
   return 0;
@@ -55,27 +111,43 @@ size_t ConditionsIOVPool::select(Condition::key_type key, const IOV& req_validit
 
 size_t ConditionsIOVPool::selectRange(Condition::key_type key, const IOV& req_validity, RangeConditions& result)
 {
+  read_lock_t guard(lock);
   size_t len = result.size();
-  const IOV::Key range = req_validity.key();
-  for( const auto& e : elements )  {
-    const IOV::Key& k = e.first;
-    if ( IOV::key_is_contained(k,range) )
-      // IOV test contained in key. Take it!
-      e.second->select(key, result);
-    else if ( IOV::key_overlaps_lower_end(k,range) )
-      // IOV overlap on test on the lower end of key
-      e.second->select(key, result);
-    else if ( IOV::key_overlaps_higher_end(k,range) )
-      // IOV overlap of test on the higher end of key
-      e.second->select(key, result);
+  if ( !elements.empty() )  {
+    const ConditionsIOVIndex& idx = index();
+    std::vector<std::size_t> matches;
+    // IOV test contained in key or overlapping on the lower or higher end of key
+    idx.overlapping(req_validity.key(), matches);
+    for( std::size_t i : matches )
+      idx.entry(i)->second->select(key, result);
   }
   return result.size() - len;
 }
 
 /// Invoke cache cleanup with user defined policy
 int ConditionsIOVPool::clean(const ConditionsCleanup& cleaner)   {
- Elements rest;
+  write_lock_t guard(lock);
+  std::vector<std::size_t> candidates;
+  const ConditionsIOVIndex& idx = index();
   int count = 0;
+  _updateAges();
+  // Let the cleaner pre-select the candidates using the index if it wishes so
+  if ( cleaner.preselect(*this, idx, candidates) )   {
+    std::vector<IOV::Key> remove;
+    for( std::size_t i : candidates )   {
+      const auto& e = *idx.entry(i);
+      if ( cleaner (*e.second) )   {
+        count += e.second->size();
+        e.second->print("Remove");
+        remove.emplace_back(e.first);
+      }
+    }
+    for( const auto& k : remove )
+      elements.erase(k);
+    invalidateIndex();
+    return count;
+  }
+  Elements rest;
   for( const auto& e : elements )  {
     const ConditionsPool* p = e.second.get();
     if ( cleaner (*p) )   {
@@ -86,13 +158,16 @@ int ConditionsIOVPool::clean(const ConditionsCleanup& cleaner)   {
     rest.insert(e);
   }
   elements = std::move(rest);
+  invalidateIndex();
   return count;  
 }
 
 /// Remove all key based pools with an age beyon the minimum age
 int ConditionsIOVPool::clean(int max_age)   {
+  write_lock_t guard(lock);
   Elements rest;
   int count = 0;
+  _updateAges();
   for( const auto& e : elements )  {
     if ( e.second->age_value >= max_age )   {
       count += e.second->size();
@@ -103,6 +178,7 @@ int ConditionsIOVPool::clean(int max_age)   {
     }
   }
   elements = std::move(rest);
+  invalidateIndex();
   return count;
 }
 
@@ -111,17 +187,18 @@ size_t ConditionsIOVPool::select(const IOV&        req_validity,
                                  RangeConditions&  valid,
                                  IOV&              cond_validity)
 {
+  read_lock_t guard(lock);
   size_t num_selected = 0;
   if ( !elements.empty() )  {
-    const IOV::Key req_key = req_validity.key(); // 16 bytes => better copy!
-    for( const auto& i : elements )  {
-      if ( !IOV::key_contains_range(i.first, req_key) )  {
-        ++i.second->age_value;
-        continue;
-      }
-      cond_validity.iov_intersection(i.first);
-      num_selected += i.second->select_all(valid);
-      i.second->age_value = 0;
+    const ConditionsIOVIndex& idx = index();
+    std::vector<std::size_t> matches;
+    long epoch = ++m_epoch;     // All pools not selected age by one unit
+    idx.containing(req_validity.key(), matches);
+    for( std::size_t i : matches )  {
+      const auto& e = *idx.entry(i);
+      cond_validity.iov_intersection(e.first);
+      num_selected += e.second->select_all(valid);
+      _select(e.second.get(), epoch);
     }
   }
   return num_selected;
@@ -132,18 +209,19 @@ size_t ConditionsIOVPool::select(const IOV&              req_validity,
                                  const ConditionsSelect& predicate_processor,
                                  IOV&                    cond_validity)
 {
+  read_lock_t guard(lock);
   size_t num_selected = 0, pool_selected = 0;
   if ( !elements.empty() )  {
-    const IOV::Key req_key = req_validity.key(); // 16 bytes => better copy!
-    for( const auto& i : elements )  {
-      if ( !IOV::key_contains_range(i.first, req_key) )  {
-        ++i.second->age_value;
-        continue;
-      }
-      cond_validity.iov_intersection(i.first);
-      pool_selected = i.second->select_all(predicate_processor);
+    const ConditionsIOVIndex& idx = index();
+    std::vector<std::size_t> matches;
+    long epoch = ++m_epoch;     // All pools not selected age by one unit
+    idx.containing(req_validity.key(), matches);
+    for( std::size_t i : matches )  {
+      const auto& e = *idx.entry(i);
+      cond_validity.iov_intersection(e.first);
+      pool_selected = e.second->select_all(predicate_processor);
       num_selected += pool_selected;
-      i.second->age_value = 0;
+      _select(e.second.get(), epoch);
     }
   }
   return num_selected;
@@ -164,14 +242,15 @@ size_t ConditionsIOVPool::select(const IOV& req_validity,
 /// Select all ACTIVE conditions, which do match the IOV requirement
 size_t ConditionsIOVPool::select(const IOV& req_validity, Elements&  valid)
 {
+  read_lock_t guard(lock);
   size_t num_selected = 0;
   if ( !elements.empty() )   {
-    const IOV::Key req_key = req_validity.key(); // 16 bytes => better copy!
-    for( const auto& i : elements )  {
-      if ( !IOV::key_contains_range(i.first, req_key) )  {
-        continue;
-      }
-      valid[i.first] = i.second;
+    const ConditionsIOVIndex& idx = index();
+    std::vector<std::size_t> matches;
+    idx.containing(req_validity.key(), matches);
+    for( std::size_t i : matches )  {
+      const auto& e = *idx.entry(i);
+      valid[e.first] = e.second;
       ++num_selected;
     }
   }
@@ -193,14 +272,15 @@ size_t ConditionsIOVPool::select(const IOV&        req_validity,
 /// Select all ACTIVE conditions, which do match the IOV requirement
 size_t ConditionsIOVPool::select(const IOV& req_validity, std::vector<Element>& valid)
 {
+  read_lock_t guard(lock);
   size_t num_selected = 0;
   if ( !elements.empty() )   {
-    const IOV::Key req_key = req_validity.key(); // 16 bytes => better copy!
-    for( const auto& i : elements )  {
-      if ( !IOV::key_contains_range(i.first, req_key) )  {
-        continue;
-      }
-      valid.emplace_back(i.second);
+    const ConditionsIOVIndex& idx = index();
+    std::vector<std::size_t> matches;
+    idx.containing(req_validity.key(), matches);
+    valid.reserve(valid.size()+matches.size());
+    for( std::size_t i : matches )  {
+      valid.emplace_back(idx.entry(i)->second);
       ++num_selected;
     }
   }
@@ -0,0 +1,640 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+//==========================================================================
+
+// Framework include files
+#include <DD4hep/Printout.h>
+#include <DD4hep/Objects.h>
+#include <DD4hep/AlignmentData.h>
+#include <DD4hep/detail/ConditionsInterna.h>
+#include <DDCond/ConditionsIOVPool.h>
+#include <DDCond/ConditionsMappedSnapshot.h>
+
+#include <TTimeStamp.h>
+
+// C/C++ include files
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <fstream>
+#include <mutex>
+#include <shared_mutex>
+#include <typeinfo>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+using namespace dd4hep::cond;
+
+// Local namespace for anonymous stuff
+namespace  {
+
+  /// File signature and format version of the snapshot files
+  const char          SNAPSHOT_MAGIC[8] = { 'D','D','4','H','C','S','N','P' };
+  const std::uint32_t SNAPSHOT_VERSION  = 1;
+  /// Marker to detect files written on machines with different byte order
+  const std::uint32_t BYTE_ORDER_MARK   = 0x01020304;
+  /// Alignment of the payloads within the file
+  const std::size_t   DATA_ALIGNMENT    = 16;
+
+  /// Encoding of the condition payloads
+  enum Encoding  { PLAIN_DATA = 1, ARRAY_DATA = 2, STRING_DATA = 3 };
+
+  /// Serializes the existence check and the registration of concurrent imports
+  /** E.g. the multi-loader reads several snapshots in parallel, which may
+   *  contain the same conditions for the same IOV pool.
+   */
+  std::mutex s_registerLock;
+
+  /// File header. All offsets are relative to the start of the file
+  struct FileHeader  {
+    char          magic[8];
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint64_t num_pools;
+    std::uint64_t num_conditions;
+    std::uint64_t pools;
+    std::uint64_t conditions;
+    std::uint64_t strings;
+    std::uint64_t data;
+    std::uint64_t length;
+  };
+
+  /// Conditions pool: IOV and range of condition records sorted by hash
+  struct PoolRecord  {
+    std::int64_t  lower;
+    std::int64_t  upper;
+    std::uint64_t first;
+    std::uint64_t count;
+    std::uint64_t identifier;   // offset in the string table
+    std::uint64_t iov_name;     // offset in the string table
+    std::uint32_t iov_type;
+    std::uint32_t spare;
+  };
+
+  /// Single condition: key, grammar and payload location
+  struct ConditionRecord  {
+    std::uint64_t hash;
+    std::uint64_t grammar;
+    std::uint64_t name;         // offset in the string table
+    std::uint64_t type;         // offset in the string table
+    std::uint64_t data;         // offset of the payload
+    std::uint64_t length;       // length of the payload in bytes
+    std::uint32_t flags;
+    std::uint32_t encoding;
+  };
+
+  /// Binary encoding of payload types which do not need parsing
+  struct Codec  {
+    const std::type_info* type;
+    Encoding              encoding;
+    /// Access to the contiguous array of an ARRAY_DATA payload
+    const void* (*array_data)(const void* object, std::size_t& length);
+    /// Assign the array to an ARRAY_DATA payload
+    void        (*array_assign)(void* object, const void* data, std::size_t length);
+  };
+
+  template <typename T> const void* vector_data(const void* object, std::size_t& length)   {
+    const std::vector<T>* v = (const std::vector<T>*)object;
+    length = v->size()*sizeof(T);
+    return v->data();
+  }
+  template <typename T> void vector_assign(void* object, const void* data, std::size_t length)   {
+    const T* p = (const T*)data;
+    ((std::vector<T>*)object)->assign(p, p+length/sizeof(T));
+  }
+  template <typename T> Codec plain_codec()  {
+    return { &typeid(T), PLAIN_DATA, nullptr, nullptr };
+  }
+  template <typename T> Codec array_codec()  {
+    return { &typeid(std::vector<T>), ARRAY_DATA, vector_data<T>, vector_assign<T> };
+  }
+
+  /// Access the binary codec of a payload type (if any)
+  const Codec* codec(const std::type_info& typ)   {
+    static const std::vector<Codec> codecs = {
+      plain_codec<int>(),    plain_codec<unsigned int>(),
+      plain_codec<long>(),   plain_codec<unsigned long>(),
+      plain_codec<float>(),  plain_codec<double>(),
+      plain_codec<dd4hep::Position>(),
+      plain_codec<dd4hep::RotationZYX>(),
+      plain_codec<dd4hep::Translation3D>(),
+      plain_codec<dd4hep::Delta>(),
+      array_codec<int>(),    array_codec<long>(),
+      array_codec<float>(),  array_codec<double>()
+    };
+    for( const auto& c : codecs )
+      if ( *c.type == typ ) return &c;
+    return nullptr;
+  }
+
+  /// Helper to select conditions
+  struct Scanner : public dd4hep::Condition::Processor   {
+    ConditionsMappedSnapshot::pool_type& pool;
+    /// Constructor
+    Scanner(ConditionsMappedSnapshot::pool_type& p) : pool(p) {}
+    /// Conditions callback for object processing
+    virtual int process(dd4hep::Condition c)  const override  {
+      pool.emplace_back(c.ptr());
+      return 1;
+    }
+  };
+
+  struct DurationStamp  {
+    TTimeStamp start;
+    ConditionsMappedSnapshot* object = 0;
+    DurationStamp(ConditionsMappedSnapshot* obj) : object(obj)  {
+    }
+    ~DurationStamp()  {
+      TTimeStamp stop;
+      object->duration = stop.AsDouble()-start.AsDouble();
+    }
+  };
+
+  /// Keep only conditions which can be saved and take a reference
+  std::size_t adopt(ConditionsMappedSnapshot::pool_type& pool)   {
+    auto last = std::remove_if(pool.begin(), pool.end(), [](dd4hep::Condition c)  {
+        return !c->is_bound() || c->testFlag(dd4hep::Condition::DERIVED);
+      });
+    pool.erase(last, pool.end());
+    for(auto c : pool) c.ptr()->addRef();
+    return pool.size();
+  }
+
+  /// Round up to the payload alignment
+  std::size_t aligned(std::size_t offset)   {
+    return (offset + DATA_ALIGNMENT - 1) & ~(DATA_ALIGNMENT - 1);
+  }
+}
+
+/// Default destructor
+ConditionsMappedSnapshot::~ConditionsMappedSnapshot()    {
+  clear();
+  if ( m_address )  {
+    ::munmap((void*)m_address, m_length);
+    m_address = 0;
+    m_length  = 0;
+  }
+}
+
+/// Clear object content and release allocated memory
+void ConditionsMappedSnapshot::clear()  {
+  for (auto& p : pools )  {
+    for(Condition c : p.second )
+      c.ptr()->release();
+    p.second.clear();
+  }
+  pools.clear();
+}
+
+/// Add conditions content to be saved. Note, that dependent conditions shall not be saved!
+std::size_t ConditionsMappedSnapshot::add(const std::string& identifier,
+                                          const IOV& iov,
+                                          std::vector<Condition>& conditions)
+{
+  DurationStamp stamp(this);
+  pools.emplace_back(std::pair<iov_key_type, pool_type>());
+  pool_type&    ent = pools.back().second;
+  iov_key_type& key = pools.back().first;
+  key.first         = identifier;
+  key.second.first  = make_pair(iov.iovType->name,iov.type);
+  key.second.second = iov.key();
+  ent               = conditions;
+  return adopt(ent);
+}
+
+/// Add conditions content to be saved. Note, that dependent conditions shall not be saved!
+std::size_t ConditionsMappedSnapshot::add(const std::string& identifier, ConditionsPool& pool)    {
+  DurationStamp stamp(this);
+  pools.emplace_back(std::pair<iov_key_type, pool_type>());
+  pool_type&    ent = pools.back().second;
+  iov_key_type& key = pools.back().first;
+  const IOV*    iov = pool.iov;
+  key.first         = identifier;
+  key.second.first  = make_pair(iov->iovType->name,iov->type);
+  key.second.second = iov->key();
+  pool.select_all(ent);
+  return adopt(ent);
+}
+
+/// Add conditions content to be saved. Note, that dependent conditions shall not be saved!
+std::size_t ConditionsMappedSnapshot::add(const std::string& identifier, const ConditionsIOVPool& pool)    {
+  std::size_t count = 0;
+  DurationStamp stamp(this);
+  std::shared_lock<std::shared_timed_mutex> guard(pool.lock);
+  for( const auto& p : pool.elements )  {
+    pools.emplace_back(std::pair<iov_key_type, pool_type>());
+    pool_type&    ent = pools.back().second;
+    iov_key_type& key = pools.back().first;
+    const IOV*    iov = p.second->iov;
+    key.first         = identifier;
+    key.second.first  = make_pair(iov->iovType->name,iov->type);
+    key.second.second = p.first;
+    p.second->select_all(ent);
+    count += adopt(ent);
+  }
+  return count;
+}
+
+/// Add conditions content to be saved. Note, that dependent conditions shall not be saved!
+std::size_t ConditionsMappedSnapshot::add(const std::string& identifier, const UserPool& pool)    {
+  DurationStamp stamp(this);
+  pools.emplace_back(std::pair<iov_key_type, pool_type>());
+  pool_type&    ent = pools.back().second;
+  iov_key_type& key = pools.back().first;
+  const IOV&    iov = pool.validity();
+  key.first         = identifier;
+  key.second.first  = make_pair(iov.iovType->name,iov.type);
+  key.second.second = iov.key();
+  pool.scan(Scanner(ent));
+  return adopt(ent);
+}
+
+/// Save the data content to a snapshot file. Returns the number of bytes written.
+std::size_t ConditionsMappedSnapshot::save(const std::string& file_name)    {
+  DurationStamp stamp(this);
+  std::vector<PoolRecord>      pool_records;
+  std::vector<ConditionRecord> records;
+  std::vector<unsigned char>   payload;
+  std::string                  strings;
+  std::map<std::string,std::uint64_t> string_offsets;
+
+  auto add_string = [&strings, &string_offsets](const std::string& s)  {
+    auto ret = string_offsets.emplace(s, strings.length());
+    if ( ret.second ) strings.append(s.c_str(), s.length()+1);
+    return ret.first->second;
+  };
+  auto add_payload = [&payload](const void* data, std::size_t len)  {
+    std::size_t offset = aligned(payload.size());
+    payload.resize(offset+len);
+    if ( len > 0 ) ::memcpy(&payload[offset], data, len);
+    return offset;
+  };
+
+  for( auto& p : pools )   {
+    const iov_key_type& key = p.first;
+    pool_type conditions = p.second;
+    std::sort(conditions.begin(), conditions.end(),
+              [](Condition a, Condition b) { return a->hash < b->hash; });
+    PoolRecord pr;
+    ::memset(&pr, 0, sizeof(pr));
+    pr.lower      = key.second.second.first;
+    pr.upper      = key.second.second.second;
+    pr.first      = records.size();
+    pr.count      = conditions.size();
+    pr.identifier = add_string(key.first);
+    pr.iov_name   = add_string(key.second.first.first);
+    pr.iov_type   = std::uint32_t(key.second.first.second);
+    pool_records.emplace_back(pr);
+
+    for( Condition c : conditions )   {
+      const Condition::Object* o  = c.ptr();
+      const BasicGrammar*      gr = o->data.grammar;
+      const Codec*             cd = codec(gr->type());
+      ConditionRecord r;
+      ::memset(&r, 0, sizeof(r));
+      r.hash    = o->hash;
+      r.grammar = gr->hash();
+      r.flags   = o->flags;
+#if defined(DD4HEP_CONDITIONS_HAVE_NAME)
+      r.name    = add_string(o->name);
+      r.type    = add_string(o->type);
+#else
+      r.name    = add_string("");
+      r.type    = add_string("");
+#endif
+      if ( cd && cd->encoding == PLAIN_DATA )   {
+        r.encoding = PLAIN_DATA;
+        r.length   = gr->sizeOf();
+        r.data     = add_payload(o->data.ptr(), r.length);
+      }
+      else if ( cd && cd->encoding == ARRAY_DATA )   {
+        std::size_t len = 0;
+        const void* ptr = cd->array_data(o->data.ptr(), len);
+        r.encoding = ARRAY_DATA;
+        r.length   = len;
+        r.data     = add_payload(ptr, len);
+      }
+      else   {
+        std::string rep = o->data.str();
+        r.encoding = STRING_DATA;
+        r.length   = rep.length();
+        r.data     = add_payload(rep.c_str(), rep.length());
+      }
+      records.emplace_back(r);
+    }
+  }
+
+  FileHeader hdr;
+  ::memset(&hdr, 0, sizeof(hdr));
+  ::memcpy(hdr.magic, SNAPSHOT_MAGIC, sizeof(hdr.magic));
+  hdr.version        = SNAPSHOT_VERSION;
+  hdr.byte_order     = BYTE_ORDER_MARK;
+  hdr.num_pools      = pool_records.size();
+  hdr.num_conditions = records.size();
+  hdr.pools          = sizeof(FileHeader);
+  hdr.conditions     = hdr.pools + pool_records.size()*sizeof(PoolRecord);
+  hdr.strings        = hdr.conditions + records.size()*sizeof(ConditionRecord);
+  hdr.data           = aligned(hdr.strings + strings.length());
+  hdr.length         = hdr.data + payload.size();
+  // Payload offsets are stored relative to the start of the file
+  for( auto& r : records ) r.data += hdr.data;
+
+  std::ofstream out(file_name, std::ios::binary);
+  if ( !out )   {
+    except("ConditionsMappedSnapshot","+++ FAILED to open snapshot file %s in write-mode [%s]",
+           file_name.c_str(), ::strerror(errno));
+  }
+  const char padding[DATA_ALIGNMENT] = { 0 };
+  out.write((const char*)&hdr, sizeof(hdr));
+  out.write((const char*)pool_records.data(), pool_records.size()*sizeof(PoolRecord));
+  out.write((const char*)records.data(), records.size()*sizeof(ConditionRecord));
+  out.write(strings.data(), strings.length());
+  out.write(padding, hdr.data - hdr.strings - strings.length());
+  out.write((const char*)payload.data(), payload.size());
+  if ( !out )   {
+    except("ConditionsMappedSnapshot","+++ FAILED to write snapshot file %s", file_name.c_str());
+  }
+  printout(DEBUG,"ConditionsMappedSnapshot","+++ Saved %ld conditions of %ld pools to %s [%ld bytes]",
+           long(records.size()), long(pool_records.size()), file_name.c_str(), long(hdr.length));
+  return hdr.length;
+}
+
+/// Publish the data content to the shared memory arena of the given name
+std::size_t ConditionsMappedSnapshot::publish(const std::string& arena)    {
+  std::string path = arenaPath(arena);
+  std::string temp = path + "." + std::to_string(::getpid()) + ".tmp";
+  std::size_t len  = 0;
+  try  {
+    len = save(temp);
+    // Readable by all worker processes, regardless of the umask
+    ::chmod(temp.c_str(), S_IRUSR|S_IWUSR|S_IRGRP|S_IROTH);
+  }
+  catch(...)  {
+    ::unlink(temp.c_str());
+    throw;
+  }
+  if ( ::rename(temp.c_str(), path.c_str()) != 0 )   {
+    int err = errno;
+    ::unlink(temp.c_str());
+    except("ConditionsMappedSnapshot","+++ FAILED to publish shared conditions arena %s [%s]",
+           path.c_str(), ::strerror(err));
+  }
+  printout(INFO,"ConditionsMappedSnapshot","+++ Published shared conditions arena %s [%ld bytes]",
+           path.c_str(), long(len));
+  return len;
+}
+
+/// Location of a shared memory arena (/dev/shm if present, else the temporary directory)
+std::string ConditionsMappedSnapshot::arenaPath(const std::string& arena)   {
+  if ( arena.empty() || arena.find('/') != std::string::npos )   {
+    except("ConditionsMappedSnapshot","+++ Invalid shared conditions arena name: '%s'", arena.c_str());
+  }
+  std::string dir = "/dev/shm";
+  if ( ::access(dir.c_str(), W_OK|X_OK) != 0 )   {
+    const char* tmp = ::getenv("TMPDIR");
+    dir = tmp ? tmp : "/tmp";
+  }
+  return dir + "/dd4hep_conditions_" + arena;
+}
+
+/// Attach read-only to a shared memory arena created with publish()
+std::unique_ptr<ConditionsMappedSnapshot>
+ConditionsMappedSnapshot::attach(const std::string& arena)   {
+  return open(arenaPath(arena), SHARED_READONLY);
+}
+
+/// Map a snapshot file into memory
+std::unique_ptr<ConditionsMappedSnapshot>
+ConditionsMappedSnapshot::open(const std::string& file_name, int mode)   {
+  std::unique_ptr<ConditionsMappedSnapshot> snap(new ConditionsMappedSnapshot());
+  DurationStamp stamp(snap.get());
+  struct stat st;
+  int fd = ::open(file_name.c_str(), O_RDONLY);
+  if ( fd < 0 || ::fstat(fd, &st) != 0 )   {
+    int err = errno;
+    if ( fd >= 0 ) ::close(fd);
+    except("ConditionsMappedSnapshot","+++ FAILED to open snapshot file %s [%s]",
+           file_name.c_str(), ::strerror(err));
+  }
+  std::size_t length = std::size_t(st.st_size);
+  if ( length < sizeof(FileHeader) )   {
+    ::close(fd);
+    except("ConditionsMappedSnapshot","+++ %s is no conditions snapshot file.", file_name.c_str());
+  }
+  // Private writable mapping: the pages are shared between all processes
+  // mapping the file as long as nobody modifies the payloads.
+  // Shared read-only mapping: the pages are always shared, writes fault.
+  void* address = mode == SHARED_READONLY
+    ? ::mmap(0, length, PROT_READ, MAP_SHARED, fd, 0)
+    : ::mmap(0, length, PROT_READ|PROT_WRITE, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if ( address == MAP_FAILED )   {
+    except("ConditionsMappedSnapshot","+++ FAILED to map snapshot file %s [%s]",
+           file_name.c_str(), ::strerror(errno));
+  }
+  snap->m_address  = (const unsigned char*)address;
+  snap->m_length   = length;
+  snap->m_fileName = file_name;
+  snap->m_mode     = mode;
+
+  const FileHeader* hdr = (const FileHeader*)address;
+  if ( ::memcmp(hdr->magic, SNAPSHOT_MAGIC, sizeof(hdr->magic)) != 0 )
+    except("ConditionsMappedSnapshot","+++ %s is no conditions snapshot file.", file_name.c_str());
+  if ( hdr->byte_order != BYTE_ORDER_MARK )
+    except("ConditionsMappedSnapshot","+++ %s was written with a different byte order.", file_name.c_str());
+  if ( hdr->version != SNAPSHOT_VERSION )
+    except("ConditionsMappedSnapshot","+++ Unsupported format version %u of %s.",
+           hdr->version, file_name.c_str());
+  // Check the layout before any record is accessed. The record counts are bounded
+  // by the file length first, so that the offset computations cannot overflow.
+  if ( hdr->length != length || hdr->pools != sizeof(FileHeader) ||
+       hdr->num_pools > length/sizeof(PoolRecord) ||
+       hdr->num_conditions > length/sizeof(ConditionRecord) ||
+       hdr->conditions != hdr->pools + hdr->num_pools*sizeof(PoolRecord) ||
+       hdr->strings != hdr->conditions + hdr->num_conditions*sizeof(ConditionRecord) ||
+       hdr->strings > hdr->data || hdr->data > length || hdr->data % DATA_ALIGNMENT != 0 )
+    except("ConditionsMappedSnapshot","+++ Corrupted conditions snapshot file %s.", file_name.c_str());
+  // Every record must reference terminated strings of the string table and payloads
+  // within the data section. Checked here, before any payload is bound or parsed.
+  const char*  strings     = (const char*)address + hdr->strings;
+  std::size_t  strings_len = std::size_t(hdr->data - hdr->strings);
+  auto valid_string = [strings, strings_len](std::uint64_t offset)  {
+    return offset < strings_len && ::memchr(strings+offset, 0, strings_len-offset) != 0;
+  };
+  const PoolRecord* pools = (const PoolRecord*)(snap->m_address + hdr->pools);
+  for( std::uint64_t i = 0; i < hdr->num_pools; ++i )   {
+    const PoolRecord& p = pools[i];
+    if ( p.first > hdr->num_conditions || p.count > hdr->num_conditions - p.first ||
+         !valid_string(p.identifier) || !valid_string(p.iov_name) )
+      except("ConditionsMappedSnapshot","+++ Corrupted pool record %ld of snapshot file %s.",
+             long(i), file_name.c_str());
+  }
+  const ConditionRecord* records = (const ConditionRecord*)(snap->m_address + hdr->conditions);
+  for( std::uint64_t i = 0; i < hdr->num_conditions; ++i )   {
+    const ConditionRecord& r = records[i];
+    if ( r.data < hdr->data || r.data > length || r.length > length - r.data ||
+         r.data % DATA_ALIGNMENT != 0 || !valid_string(r.name) || !valid_string(r.type) )
+      except("ConditionsMappedSnapshot","+++ Corrupted condition record %ld of snapshot file %s.",
+             long(i), file_name.c_str());
+  }
+  printout(DEBUG,"ConditionsMappedSnapshot","+++ Mapped %ld conditions of %ld pools from %s",
+           long(hdr->num_conditions), long(hdr->num_pools), file_name.c_str());
+  return snap;
+}
+
+/// Number of conditions in the mapped file
+std::size_t ConditionsMappedSnapshot::numConditions()  const   {
+  return m_address ? ((const FileHeader*)m_address)->num_conditions : 0;
+}
+
+/// Create and register the conditions of one mapped pool
+std::size_t ConditionsMappedSnapshot::_import(std::size_t pool_index,
+                                              const std::vector<Condition::key_type>* keys,
+                                              ConditionsManager mgr,
+                                              loaded_type* loaded)
+{
+  const FileHeader*      hdr     = (const FileHeader*)m_address;
+  const PoolRecord&      p       = ((const PoolRecord*)(m_address + hdr->pools))[pool_index];
+  const ConditionRecord* first   = (const ConditionRecord*)(m_address + hdr->conditions) + p.first;
+  const ConditionRecord* last    = first + p.count;
+  const char*            strings = (const char*)(m_address + hdr->strings);
+  auto iov_typ = mgr.registerIOVType(p.iov_type, strings + p.iov_name);
+  if ( !iov_typ.second )   {
+    except("ConditionsMappedSnapshot","+++ Failed to register IOV type %s [%u] of %s.",
+           strings + p.iov_name, p.iov_type, m_fileName.c_str());
+  }
+  ConditionsPool*        pool     = mgr.registerIOV(*iov_typ.second, IOV::Key(p.lower, p.upper));
+  ConditionsIOVPool*     iov_pool = mgr.iovPool(*iov_typ.second);
+  std::vector<Condition> conditions;
+  std::size_t            count = 0;
+
+  auto create = [this, strings, &conditions](const ConditionRecord& r)  {
+    Condition c(strings + r.name, strings + r.type);
+    Condition::Object*  o  = c.ptr();
+    const BasicGrammar& gr = BasicGrammar::get(r.grammar);
+    void*               payload = (void*)(m_address + r.data);
+    o->hash  = r.hash;
+    o->flags = r.flags;
+    if ( r.encoding == PLAIN_DATA && gr.sizeOf() == r.length )   {
+      o->data.bindExtern(payload, &gr);     // Zero-copy: the payload stays in the mapped file
+    }
+    else if ( (r.encoding == ARRAY_DATA || r.encoding == STRING_DATA) && gr.specialization.bind )   {
+      void* ptr = o->data.bind(&gr);
+      gr.specialization.bind(ptr);
+      if ( r.encoding == ARRAY_DATA )   {
+        const Codec* cd = codec(gr.type());
+        if ( !cd || cd->encoding != ARRAY_DATA )  {
+          except("ConditionsMappedSnapshot","+++ No array encoding for type %s.", gr.type_name().c_str());
+        }
+        cd->array_assign(ptr, payload, r.length);
+      }
+      else if ( !o->data.fromString(std::string((const char*)payload, r.length)) )   {
+        except("ConditionsMappedSnapshot","+++ Failed to convert payload of condition %016llX to type %s.",
+               (unsigned long long)r.hash, gr.type_name().c_str());
+      }
+    }
+    else   {
+      except("ConditionsMappedSnapshot","+++ Invalid payload of condition %016llX of type %s.",
+             (unsigned long long)r.hash, gr.type_name().c_str());
+    }
+    conditions.emplace_back(c);
+  };
+
+  auto register_one = [&](const ConditionRecord& r)  {
+    Condition c = pool->exists(r.hash);
+    if ( !c.isValid() )   {
+      create(r);
+      c = conditions.back();
+    }
+    if ( loaded ) loaded->emplace(r.hash, c);
+    ++count;
+  };
+  // Locate the records first: this does not touch the conditions store
+  std::vector<const ConditionRecord*> records;
+  if ( keys )   {
+    records.reserve(keys->size());
+    for( Condition::key_type k : *keys )   {
+      if ( loaded && loaded->find(k) != loaded->end() ) continue;
+      const ConditionRecord* r = std::lower_bound(first, last, k,
+                                                  [](const ConditionRecord& rec, Condition::key_type h)
+                                                  { return rec.hash < h; });
+      if ( r != last && r->hash == k ) records.emplace_back(r);
+    }
+  }
+  else   {
+    records.reserve(p.count);
+    for( const ConditionRecord* r = first; r != last; ++r )
+      records.emplace_back(r);
+  }
+  // No other import may register the same conditions between the check and the registration
+  std::lock_guard<std::mutex> register_guard(s_registerLock);
+  {  // The lookups in the pool need the shared lock. blockRegister takes the exclusive lock
+    std::shared_lock<std::shared_timed_mutex> guard(iov_pool->lock);
+    for( const ConditionRecord* r : records )
+      register_one(*r);
+  }
+  if ( !conditions.empty() )   {
+    mgr.blockRegister(*pool, conditions);
+  }
+  return count;
+}
+
+/// Import all conditions of the mapped pools with matching identifier and IOV type
+std::size_t ConditionsMappedSnapshot::import(const std::string& id,
+                                             const std::string& iov_type,
+                                             ConditionsManager  mgr)
+{
+  DurationStamp stamp(this);
+  if ( !m_address )   {
+    except("ConditionsMappedSnapshot","+++ No snapshot file is mapped.");
+  }
+  const FileHeader* hdr     = (const FileHeader*)m_address;
+  const PoolRecord* prec    = (const PoolRecord*)(m_address + hdr->pools);
+  const char*       strings = (const char*)(m_address + hdr->strings);
+  std::size_t       count   = 0;
+  for( std::size_t i = 0; i < hdr->num_pools; ++i )   {
+    if ( !(id.empty() || id == "*" || id == strings + prec[i].identifier) )
+      continue;
+    if ( !(iov_type.empty() || iov_type == "*" || iov_type == strings + prec[i].iov_name) )
+      continue;
+    count += _import(i, nullptr, mgr, nullptr);
+  }
+  return count;
+}
+
+/// Import the requested conditions from the mapped pools valid for the required IOV
+std::size_t ConditionsMappedSnapshot::import(const IOV& required,
+                                             const std::vector<Condition::key_type>& keys,
+                                             ConditionsManager mgr,
+                                             loaded_type& loaded,
+                                             IOV& validity)
+{
+  DurationStamp stamp(this);
+  if ( !m_address )   {
+    except("ConditionsMappedSnapshot","+++ No snapshot file is mapped.");
+  }
+  const FileHeader* hdr  = (const FileHeader*)m_address;
+  const PoolRecord* prec = (const PoolRecord*)(m_address + hdr->pools);
+  std::size_t       len  = loaded.size();
+  for( std::size_t i = 0; i < hdr->num_pools && loaded.size()-len < keys.size(); ++i )   {
+    IOV::Key key(prec[i].lower, prec[i].upper);
+    if ( prec[i].iov_type != required.type || !IOV::key_is_contained(required.keyData, key) )
+      continue;
+    if ( _import(i, &keys, mgr, &loaded) > 0 )   {
+      validity.iov_intersection(key);
+    }
+  }
+  return loaded.size() - len;
+}
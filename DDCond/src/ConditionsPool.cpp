@@ -27,7 +27,7 @@ DD4HEP_INSTANTIATE_HANDLE_NAMED(ConditionsPool);
 
 /// Default constructor
 ConditionsPool::ConditionsPool(ConditionsManager mgr, IOV* i)
-  : NamedObject(), m_manager(mgr), iov(i), age_value(AGE_NONE)
+  : NamedObject(), m_manager(mgr), iov(i), age_value(AGE_NONE), age_epoch(-1)
 {
   InstanceCount::increment(this);
 }
@@ -41,13 +41,13 @@ ConditionsPool::~ConditionsPool()   {
 /// Print pool basics
 void ConditionsPool::print()   const  {
   printout(INFO,"ConditionsPool","+++ Conditions for pool with IOV: %-32s age:%3d [%4d entries]",
-           GetName(), age_value, size());
+           GetName(), age_value.load(), size());
 }
 
 /// Print pool basics
 void ConditionsPool::print(const std::string& opt)   const  {
   printout(INFO,"ConditionsPool","+++ %s Conditions for pool with IOV: %-32s age:%3d [%4d entries]",
-           opt.c_str(), GetName(), age_value, size());
+           opt.c_str(), GetName(), age_value.load(), size());
   if ( opt == "*" || opt == "ALL" )   {
     ConditionsPrinter printer(0);
     RangeConditions   range;
@@ -0,0 +1,150 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+//==========================================================================
+
+// Framework include files
+#include <DDCond/ConditionsPrefetcher.h>
+#include <DD4hep/InstanceCount.h>
+#include <DD4hep/Printout.h>
+
+using namespace dd4hep::cond;
+
+namespace {
+  /// Check if a prepared slice is valid for the requested IOV
+  bool slice_covers(const ConditionsPrefetcher::Slice& slice, const dd4hep::IOV& iov)  {
+    return slice && slice->pool.get() && slice->iov().contains(iov);
+  }
+}
+
+/// Initializing constructor
+ConditionsPrefetcher::ConditionsPrefetcher(ConditionsManager mgr, const Content& content, unsigned long slice_flags)
+  : m_manager(mgr), m_content(content), m_sliceFlags(slice_flags)
+{
+  InstanceCount::increment(this);
+}
+
+/// Default destructor. Waits for a pending background preparation
+ConditionsPrefetcher::~ConditionsPrefetcher()   {
+  clear();
+  InstanceCount::decrement(this);
+}
+
+/// Create a new empty slice
+ConditionsPrefetcher::Slice ConditionsPrefetcher::_newSlice()  const   {
+  Slice slice = std::make_shared<ConditionsSlice>(m_manager, m_content);
+  slice->flags = m_sliceFlags;
+  return slice;
+}
+
+/// Wait for the background preparation and take the result. Requires the lock.
+ConditionsPrefetcher::Slice ConditionsPrefetcher::_wait(ConditionsManager::Result& result)   {
+  Slice slice;
+  slice.swap(m_next);
+  if ( m_pending.valid() )   {
+    try  {
+      result = m_pending.get();
+    }
+    catch(const std::exception& e)   {
+      printout(ERROR,"ConditionsPrefetcher","+++ Prefetch for IOV %s failed: %s",
+               m_nextIOV.str().c_str(), e.what());
+      slice.reset();
+    }
+    catch(...)   {
+      printout(ERROR,"ConditionsPrefetcher","+++ Prefetch for IOV %s failed: [Unknown exception]",
+               m_nextIOV.str().c_str());
+      slice.reset();
+    }
+  }
+  return slice;
+}
+
+/// Check if the background preparation finished. Requires the lock.
+bool ConditionsPrefetcher::_ready()  const   {
+  return !m_pending.valid() ||
+    m_pending.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+/// Start the asynchronous preparation of a slice for the expected IOV
+bool ConditionsPrefetcher::prefetch(const IOV& iov, ConditionUpdateUserContext* ctxt)   {
+  std::lock_guard<std::mutex> guard(m_lock);
+  if ( slice_covers(m_current, iov) )
+    return false;
+  else if ( m_next && m_nextIOV.contains(iov) )
+    return false;
+  else if ( m_next )   {
+    ConditionsManager::Result res;
+    Slice previous = _wait(res);
+    if ( slice_covers(previous, iov) )   {
+      m_next = previous;
+      return false;
+    }
+    printout(DEBUG,"ConditionsPrefetcher","+++ Discard prefetched slice for IOV %s",
+             m_nextIOV.str().c_str());
+  }
+  Slice slice = _newSlice();
+  ConditionsManager mgr = m_manager;
+  m_next    = slice;
+  m_nextIOV = iov;
+  m_pending = std::async(std::launch::async, [mgr, slice, iov, ctxt]()  {
+      return mgr.prepare(iov, *slice, ctxt);
+    });
+  printout(DEBUG,"ConditionsPrefetcher","+++ Started prefetch for IOV %s", iov.str().c_str());
+  return true;
+}
+
+/// Check if a prefetched slice (ready or not) is available for the IOV
+bool ConditionsPrefetcher::isPrefetched(const IOV& iov)  const   {
+  std::lock_guard<std::mutex> guard(m_lock);
+  if ( !m_next )
+    return false;
+  else if ( m_nextIOV.contains(iov) )
+    return true;
+  return _ready() && slice_covers(m_next, iov);
+}
+
+/// Access a slice valid for the required IOV. Swaps in the prefetched slice if possible.
+ConditionsPrefetcher::Slice ConditionsPrefetcher::get(const IOV& iov, ConditionUpdateUserContext* ctxt)   {
+  std::unique_lock<std::mutex> guard(m_lock);
+  if ( slice_covers(m_current, iov) )
+    return m_current;
+  else if ( m_next && (m_nextIOV.contains(iov) || (_ready() && slice_covers(m_next, iov))) )   {
+    ConditionsManager::Result res;
+    Slice slice = _wait(res);
+    if ( slice_covers(slice, iov) )   {
+      printout(DEBUG,"ConditionsPrefetcher","+++ Swap in prefetched slice for IOV %s "
+               "(S:%ld,L:%ld,C:%ld,M:%ld)", iov.str().c_str(),
+               res.selected, res.loaded, res.computed, res.missing);
+      m_current = slice;
+      return m_current;
+    }
+  }
+  // A pending prefetch for another IOV is kept: it may still be needed later.
+  // The slice is prepared without the lock: other callers are not blocked meanwhile.
+  Slice slice = _newSlice();
+  guard.unlock();
+  m_manager.prepare(iov, *slice, ctxt);
+  guard.lock();
+  m_current = slice;
+  return slice;
+}
+
+/// Access the current slice (may be empty)
+ConditionsPrefetcher::Slice ConditionsPrefetcher::current()  const   {
+  std::lock_guard<std::mutex> guard(m_lock);
+  return m_current;
+}
+
+/// Wait for and drop any pending prefetch. Releases the current slice.
+void ConditionsPrefetcher::clear()   {
+  std::lock_guard<std::mutex> guard(m_lock);
+  ConditionsManager::Result res;
+  _wait(res);
+  m_current.reset();
+}
@@ -238,6 +238,8 @@ size_t ConditionsRootPersistency::_import(ImportStrategy     strategy,
     iovTyp = mgr.registerIOVType(key.second.first.second,key.second.first.first);
     if ( iovTyp.second )   {
       ConditionsPool* pool = mgr.registerIOV(*iovTyp.second, key.second.second);
+      // Other threads may select from the IOV pool concurrently
+      std::lock_guard<std::shared_timed_mutex> guard(mgr.iovPool(*iovTyp.second)->lock);
       for (Condition c : iovp.second)   {
         Condition::Object* o = c.ptr();
         o->iov = pool->iov;
@@ -37,6 +37,7 @@ ConditionsSlice::ConditionsSlice(ConditionsManager mgr,
 ConditionsSlice::ConditionsSlice(const ConditionsSlice& copy)
   : manager(copy.manager), content(copy.content)
 {
+  if ( copy.arena ) useArena(copy.arena->chunkSize());
   InstanceCount::increment(this);  
 }
 
@@ -52,6 +53,11 @@ void ConditionsSlice::derefPools()     {
   this->flags &= ~REF_POOLS;
 }
 
+/// Allocate the derived conditions and their payloads from an arena owned by the slice
+void ConditionsSlice::useArena(std::size_t chunk_size)   {
+  arena = std::make_shared<detail::ConditionsArena>(chunk_size);
+}
+
 /// Access the combined IOV of the slice from the pool
 const dd4hep::IOV& ConditionsSlice::iov()  const    {
   if ( pool.get() ) return pool->validity();
@@ -64,6 +70,7 @@ const dd4hep::IOV& ConditionsSlice::iov()  const    {
 void ConditionsSlice::reset()   {
   derefPools();
   if ( pool.get() ) pool->clear();
+  if ( arena ) arena->reset();
 }
 
 /// Local optimization: Insert a set of conditions to the slice AND register them to the conditions manager.
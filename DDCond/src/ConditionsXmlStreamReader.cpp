@@ -0,0 +1,683 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+//==========================================================================
+
+// Framework include files
+#include <DDCond/ConditionsXmlStreamReader.h>
+#include <DD4hep/Printout.h>
+#include <DD4hep/DetectorTools.h>
+#include <DD4hep/AlignmentData.h>
+#include <DD4hep/OpaqueDataBinder.h>
+#include <DD4hep/detail/ConditionsInterna.h>
+
+#include <TTimeStamp.h>
+
+// C/C++ include files
+#include <cctype>
+#include <cerrno>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace dd4hep;
+using namespace dd4hep::cond;
+
+namespace {
+
+  /// Minimal streaming XML tokenizer (pull parser)
+  /**
+   *  The input is read in blocks. Processing instructions, comments and the
+   *  document type declaration are skipped, CDATA sections are returned as
+   *  text. The predefined and numeric character references are resolved.
+   *  Empty element tags result in a start and an end event.
+   */
+  class PullReader  {
+  public:
+    enum Event { START_ELEMENT, END_ELEMENT, TEXT, END_DOCUMENT };
+    typedef std::pair<std::string,std::string> Attribute;
+
+  private:
+    std::FILE*             m_file = 0;
+    std::string            m_fileName;
+    std::vector<char>      m_buffer;
+    std::size_t            m_pos   = 0;
+    std::size_t            m_len   = 0;
+    std::size_t            m_line  = 1;
+    bool                   m_close = false;   // Pending end of an empty element tag
+    bool                   m_open  = false;   // '<' of the next tag already consumed
+    std::string            m_name;
+    std::string            m_text;
+    std::vector<Attribute> m_attrs;           // Reused to avoid re-allocations
+    std::size_t            m_numAttrs = 0;
+
+    int _fill()   {
+      m_pos = 0;
+      m_len = std::fread(m_buffer.data(), 1, m_buffer.size(), m_file);
+      return m_len > 0 ? (unsigned char)m_buffer[0] : EOF;
+    }
+    int _peek()   {
+      return m_pos < m_len ? (unsigned char)m_buffer[m_pos] : _fill();
+    }
+    int _get()   {
+      int c = _peek();
+      if ( c != EOF )  {
+        ++m_pos;
+        if ( c == '\n' ) ++m_line;
+      }
+      return c;
+    }
+    static bool _isName(int c)   {
+      return std::isalnum(c) || c == '_' || c == ':' || c == '-' || c == '.';
+    }
+    static bool _blank(const std::string& s)   {
+      for( char c : s ) if ( !std::isspace((unsigned char)c) ) return false;
+      return true;
+    }
+    void _error(const char* msg)  const   {
+      except("ConditionsXmlStreamReader","+++ %s:%ld: %s", m_fileName.c_str(), long(m_line), msg);
+    }
+    void _expect(int c)   {
+      if ( _get() != c ) _error("Malformed XML: unexpected character");
+    }
+    void _skipSpace()   {
+      while( std::isspace(_peek()) ) _get();
+    }
+    void _nameRest(std::string& name)   {
+      while( _isName(_peek()) ) name.push_back(char(_get()));
+    }
+    /// Skip everything up to and including the terminator
+    void _skip(const char* terminator)   {
+      std::size_t n = std::strlen(terminator);
+      char window[4] = {0,0,0,0};
+      for( std::size_t count = 0;; ++count )   {
+        int c = _get();
+        if ( c == EOF ) _error("Unexpected end of file");
+        std::memmove(window, window+1, 2);
+        window[2] = char(c);
+        if ( count+1 >= n && std::strncmp(window+3-n, terminator, n) == 0 ) return;
+      }
+    }
+    /// Skip a declaration like <!DOCTYPE ...> including an internal subset
+    void _skipDeclaration()   {
+      int depth = 0;
+      for( int c = _get(); ; c = _get() )   {
+        if ( c == EOF ) _error("Unexpected end of file");
+        else if ( c == '[' ) ++depth;
+        else if ( c == ']' ) --depth;
+        else if ( c == '>' && depth <= 0 ) return;
+      }
+    }
+    /// Read CDATA section content up to "]]>"
+    void _cdata(std::string& text)   {
+      for( int c = _get(); ; c = _get() )   {
+        if ( c == EOF ) _error("Unexpected end of file in CDATA section");
+        text.push_back(char(c));
+        std::size_t len = text.length();
+        if ( c == '>' && len >= 3 && text[len-2] == ']' && text[len-3] == ']' )  {
+          text.resize(len-3);
+          return;
+        }
+      }
+    }
+    /// Resolve character reference after '&'
+    void _entity(std::string& out)   {
+      char ent[16];
+      std::size_t len = 0;
+      for( int c = _get(); c != ';'; c = _get() )   {
+        if ( c == EOF || len+1 >= sizeof(ent) ) _error("Malformed character reference");
+        ent[len++] = char(c);
+      }
+      ent[len] = 0;
+      if      ( 0 == ::strcmp(ent,"lt")   ) out.push_back('<');
+      else if ( 0 == ::strcmp(ent,"gt")   ) out.push_back('>');
+      else if ( 0 == ::strcmp(ent,"amp")  ) out.push_back('&');
+      else if ( 0 == ::strcmp(ent,"quot") ) out.push_back('"');
+      else if ( 0 == ::strcmp(ent,"apos") ) out.push_back('\'');
+      else if ( ent[0] == '#' )   {
+        unsigned long code = (ent[1] == 'x' || ent[1] == 'X')
+          ? std::strtoul(ent+2, 0, 16) : std::strtoul(ent+1, 0, 10);
+        if ( code < 0x80 )   {
+          out.push_back(char(code));
+        }
+        else if ( code < 0x800 )   {
+          out.push_back(char(0xC0 | (code >> 6)));
+          out.push_back(char(0x80 | (code & 0x3F)));
+        }
+        else if ( code < 0x10000 )   {
+          out.push_back(char(0xE0 | (code >> 12)));
+          out.push_back(char(0x80 | ((code >> 6) & 0x3F)));
+          out.push_back(char(0x80 | (code & 0x3F)));
+        }
+        else   {
+          out.push_back(char(0xF0 | (code >> 18)));
+          out.push_back(char(0x80 | ((code >> 12) & 0x3F)));
+          out.push_back(char(0x80 | ((code >> 6) & 0x3F)));
+          out.push_back(char(0x80 | (code & 0x3F)));
+        }
+      }
+      else   {   // Unknown entity: keep it verbatim
+        out.push_back('&');
+        out.append(ent);
+        out.push_back(';');
+      }
+    }
+    /// Read attributes and the end of a start tag
+    Event _startTag()   {
+      m_numAttrs = 0;
+      for(;;)   {
+        _skipSpace();
+        int c = _get();
+        if ( c == '>' )
+          return START_ELEMENT;
+        else if ( c == '/' )  {
+          _expect('>');
+          m_close = true;
+          return START_ELEMENT;
+        }
+        else if ( !_isName(c) )
+          _error("Malformed start tag");
+        if ( m_numAttrs == m_attrs.size() ) m_attrs.emplace_back();
+        Attribute& a = m_attrs[m_numAttrs++];
+        a.first.assign(1, char(c));
+        a.second.clear();
+        _nameRest(a.first);
+        _skipSpace();
+        _expect('=');
+        _skipSpace();
+        int quote = _get();
+        if ( quote != '"' && quote != '\'' ) _error("Malformed attribute value");
+        for( c = _get(); c != quote; c = _get() )   {
+          if ( c == EOF ) _error("Unexpected end of file in attribute value");
+          else if ( c == '&' ) _entity(a.second);
+          else a.second.push_back(char(c));
+        }
+      }
+    }
+
+  public:
+    /// Initializing constructor
+    PullReader(const std::string& file_name) : m_fileName(file_name), m_buffer(1<<16)  {
+      m_file = std::fopen(file_name.c_str(), "rb");
+      if ( !m_file )   {
+        except("ConditionsXmlStreamReader","+++ FAILED to open XML file %s [%s]",
+               file_name.c_str(), ::strerror(errno));
+      }
+    }
+    /// Default destructor
+    ~PullReader()   {
+      if ( m_file ) std::fclose(m_file);
+    }
+    /// Tag name of the current element event
+    const std::string& name()  const    {  return m_name;  }
+    /// Text of the current text event
+    const std::string& text()  const    {  return m_text;  }
+    /// Access attribute of the current start element event. Returns 0 if not present.
+    const std::string* attr(const char* name)  const   {
+      for( std::size_t i=0; i<m_numAttrs; ++i )
+        if ( m_attrs[i].first == name ) return &m_attrs[i].second;
+      return 0;
+    }
+    /// Current line number
+    std::size_t line()  const           {  return m_line;  }
+
+    /// Advance to the next event
+    Event next()   {
+      if ( m_close )   {
+        m_close = false;
+        return END_ELEMENT;
+      }
+      m_text.clear();
+      for(;;)   {
+        if ( !m_open )   {
+          int c = _get();
+          if ( c == EOF )
+            return _blank(m_text) ? END_DOCUMENT : TEXT;
+          else if ( c == '&' )
+            _entity(m_text);
+          else if ( c != '<' )
+            m_text.push_back(char(c));
+          else if ( !_blank(m_text) )   {
+            m_open = true;
+            return TEXT;
+          }
+          else
+            m_open = true;
+          if ( !m_open ) continue;
+        }
+        m_open = false;
+        int c = _get();
+        if ( c == '?' )   {
+          _skip("?>");
+        }
+        else if ( c == '!' )   {
+          c = _get();
+          if ( c == '-' )   {
+            _expect('-');
+            _skip("-->");
+          }
+          else if ( c == '[' )   {
+            for( const char* p = "CDATA["; *p; ++p ) _expect(*p);
+            _cdata(m_text);
+          }
+          else   {
+            _skipDeclaration();
+          }
+        }
+        else if ( c == '/' )   {
+          m_name.clear();
+          _nameRest(m_name);
+          _skipSpace();
+          _expect('>');
+          return END_ELEMENT;
+        }
+        else if ( _isName(c) )   {
+          m_name.assign(1, char(c));
+          _nameRest(m_name);
+          return _startTag();
+        }
+        else   {
+          _error("Malformed tag");
+        }
+      }
+    }
+  };
+
+  /// Element types handled by the reader
+  enum ElementType  {
+    OTHER, IOV_SECTION, DETELEMENT, MANAGER, VALUE, SEQUENCE, MAPPING, ITEM, DELTA, POSITION, ROTATION, PIVOT
+  };
+
+  /// Element classification by tag name
+  ElementType element_type(const std::string& tag)   {
+    static const std::map<std::string,ElementType> types = {
+      { "iov",             IOV_SECTION },
+      { "detelement",      DETELEMENT  },
+      { "manager",         MANAGER     },
+      { "value",           VALUE       },
+      { "pressure",        VALUE       },
+      { "temperature",     VALUE       },
+      { "sequence",        SEQUENCE    },
+      { "mapping",         MAPPING     },
+      { "item",            ITEM        },
+      { "alignment_delta", DELTA       },
+      { "position",        POSITION    },
+      { "rotation",        ROTATION    },
+      { "pivot",           PIVOT       }
+    };
+    auto i = types.find(tag);
+    return i == types.end() ? OTHER : i->second;
+  }
+
+  /// Resolve a file reference relative to the referencing file
+  std::string resolve_reference(const std::string& parent, std::string ref)   {
+    if ( ref.compare(0, 5, "file:") == 0 ) ref = ref.substr(5);
+    if ( ref.empty() || ref[0] == '/' ) return ref;
+    std::size_t idx = parent.rfind('/');
+    return idx == std::string::npos ? ref : parent.substr(0, idx+1) + ref;
+  }
+}
+
+/// Conversion state. Local to every parse() call
+class ConditionsXmlStreamReader::State  {
+public:
+  /// Open element
+  struct Frame  {
+    ElementType     type;
+    std::string     tag;           // Tag name to match the end tag
+    DetElement      detector;      // Detector element at element entry
+    ConditionsPool* pool;          // Conditions pool at element entry
+  };
+  /// Condition being converted
+  struct Current  {
+    ElementType              type = OTHER;
+    std::string              tag, name, ctype, value, unit, comment, key_type, value_type;
+    bool                     haveValue = false, selected = true;
+    std::string              text;
+    std::size_t              level = 0;     // Element stack depth of the condition
+    Delta                    delta;
+    bool                     haveRotation = false, havePosition = false, havePivot = false;
+    std::vector<std::pair<std::string,std::string> > items;
+    std::vector<bool>        itemHasKey;
+    std::string              itemKey, itemValue, itemText;
+    bool                     itemAttrs = false;
+  };
+  std::vector<Frame>       stack;
+  DetElement               detector;
+  ConditionsPool*          pool = 0;
+  std::vector<Condition>   block;
+  Current                  current;
+  bool                     inCondition = false;
+  std::size_t              count = 0;
+
+  /// Register all pending conditions to the current pool
+  void flush(ConditionsManager& mgr)   {
+    if ( !block.empty() )   {
+      mgr.blockRegister(*pool, block);
+      count += block.size();
+      block.clear();
+    }
+  }
+};
+
+/// Initializing constructor
+ConditionsXmlStreamReader::ConditionsXmlStreamReader(Detector& description, ConditionsManager mgr)
+  : m_detector(description), m_manager(mgr)
+{
+}
+
+/// Only create conditions with the given keys. An empty selection accepts all.
+void ConditionsXmlStreamReader::select(const std::vector<Condition::key_type>& keys)   {
+  m_keys.clear();
+  m_keys.insert(keys.begin(), keys.end());
+}
+
+/// Evaluate unit, cache the result
+double ConditionsXmlStreamReader::_unit(const std::string& unit)   {
+  auto i = m_units.find(unit);
+  if ( i == m_units.end() )
+    i = m_units.emplace(unit, _toDouble(unit)).first;
+  return i->second;
+}
+
+/// Fast conversion of numeric attribute values
+double ConditionsXmlStreamReader::_number(const std::string& value)   {
+  const char* ptr = value.c_str();
+  char*       end = 0;
+  double      val = std::strtod(ptr, &end);
+  if ( end != ptr )   {
+    while( std::isspace((unsigned char)*end) ) ++end;
+    if ( *end == 0 ) return val;
+  }
+  return _toDouble(value);   // Expression: use the evaluator
+}
+
+/// Read conditions file. Returns the number of conditions registered
+std::size_t ConditionsXmlStreamReader::parse(const std::string& file_name)   {
+  TTimeStamp start;
+  State state;
+  state.detector = m_detector.world();
+  numFiles = 0;
+  _parse(resolve_reference(std::string(), file_name), state);
+  state.flush(m_manager);
+  numConditions = state.count;
+  TTimeStamp stop;
+  printout(INFO,"ConditionsXmlStreamReader","+++ Read %ld conditions from %ld files [%8.3f seconds]",
+           long(numConditions), long(numFiles), stop.AsDouble()-start.AsDouble());
+  return numConditions;
+}
+
+/// Process one file
+void ConditionsXmlStreamReader::_parse(const std::string& file_name, State& state)   {
+  typedef State::Current Current;
+  PullReader reader(file_name);
+  std::size_t depth = state.stack.size();
+  Current&    cur   = state.current;
+
+  auto coordinate = [this, &reader, &file_name](const char* name)  {
+    const std::string* val = reader.attr(name);
+    if ( !val )  {
+      except("ConditionsXmlStreamReader","+++ %s:%ld: <%s> without attribute '%s'",
+             file_name.c_str(), long(reader.line()), reader.name().c_str(), name);
+    }
+    return _number(*val);
+  };
+  auto attr_value = [&reader](const char* name, std::string& value)  {
+    const std::string* val = reader.attr(name);
+    if ( val ) value = *val; else value.clear();
+    return val != 0;
+  };
+
+  ++numFiles;
+  for( PullReader::Event ev = reader.next(); ev != PullReader::END_DOCUMENT; ev = reader.next() )  {
+    if ( ev == PullReader::TEXT )   {
+      if ( state.inCondition )
+        (cur.type == MAPPING ? cur.itemText : cur.text) += reader.text();
+      continue;
+    }
+    else if ( ev == PullReader::START_ELEMENT )   {
+      ElementType typ = element_type(reader.name());
+      State::Frame frame { typ, reader.name(), state.detector, state.pool };
+      state.stack.emplace_back(frame);
+      if ( state.inCondition )   {
+        // Children of conditions
+        if ( cur.type == DELTA && typ == POSITION )   {
+          cur.delta.translation.SetXYZ(coordinate("x"), coordinate("y"), coordinate("z"));
+          cur.havePosition = true;
+        }
+        else if ( cur.type == DELTA && typ == ROTATION )   {
+          cur.delta.rotation.SetComponents(coordinate("z"), coordinate("y"), coordinate("x"));
+          cur.haveRotation = true;
+        }
+        else if ( cur.type == DELTA && typ == PIVOT )   {
+          cur.delta.pivot.SetXYZ(coordinate("x"), coordinate("y"), coordinate("z"));
+          cur.havePivot = true;
+        }
+        else if ( cur.type == MAPPING && typ == ITEM )   {
+          const std::string* k = reader.attr("key");
+          const std::string* v = reader.attr("value");
+          cur.itemAttrs = k && v;
+          if ( cur.itemAttrs )  {
+            cur.itemKey   = *k;
+            cur.itemValue = *v;
+          }
+          cur.itemText.clear();
+        }
+        continue;
+      }
+      switch( typ )   {
+      case IOV_SECTION:   {
+        std::string validity, ref;
+        if ( !attr_value("validity", validity) )   {
+          except("ConditionsXmlStreamReader","+++ %s:%ld: <iov> without validity.",
+                 file_name.c_str(), long(reader.line()));
+        }
+        state.flush(m_manager);
+        state.pool = m_manager.registerIOV(validity);
+        if ( attr_value("ref", ref) )
+          _parse(resolve_reference(file_name, ref), state);
+        break;
+      }
+      case DETELEMENT:   {
+        std::string path, ref;
+        if ( attr_value("path", path) && !path.empty() )
+          state.detector = detail::tools::findDaughterElement(frame.detector, path);
+        if ( attr_value("ref", ref) )
+          _parse(resolve_reference(file_name, ref), state);
+        break;
+      }
+      case MANAGER:   {
+        std::string ref;
+        if ( attr_value("ref", ref) )
+          _parse(resolve_reference(file_name, ref), state);
+        break;
+      }
+      case VALUE:
+      case SEQUENCE:
+      case MAPPING:
+      case DELTA:   {
+        const std::string* nam = reader.attr("name");
+        cur.type         = typ;
+        cur.tag          = reader.name();
+        cur.name         = nam ? *nam : cur.tag;
+        cur.haveValue    = attr_value("value", cur.value);
+        attr_value("unit", cur.unit);
+        attr_value("comment", cur.comment);
+        if ( !attr_value("type", cur.ctype) )   {
+          // Like the DOM parser: generic values and sequences require an explicit type
+          if ( cur.tag == "value" || typ == SEQUENCE )   {
+            except("ConditionsXmlStreamReader","+++ %s:%ld: <%s> %s without type attribute.",
+                   file_name.c_str(), long(reader.line()), cur.tag.c_str(), cur.name.c_str());
+          }
+          cur.ctype = cur.tag;
+        }
+        if ( typ == MAPPING )   {
+          if ( !attr_value("key", cur.key_type) || !cur.haveValue )  {
+            except("ConditionsXmlStreamReader","+++ %s:%ld: <mapping> without key or value type.",
+                   file_name.c_str(), long(reader.line()));
+          }
+          cur.value_type = cur.value;
+        }
+        cur.text.clear();
+        cur.items.clear();
+        cur.itemHasKey.clear();
+        cur.delta        = Delta();
+        cur.haveRotation = cur.havePosition = cur.havePivot = false;
+        cur.selected     = m_keys.empty() ||
+          m_keys.find(ConditionKey::hashCode(state.detector, cur.name)) != m_keys.end();
+        cur.level         = state.stack.size();
+        state.inCondition = true;
+        break;
+      }
+      default:
+        if ( reader.name() == "iov_type" )   {
+          std::string nam, id;
+          attr_value("name", nam);
+          std::size_t typ_id = attr_value("id", id) && _toInt(id) >= 0 ? std::size_t(_toInt(id)) : INT_MAX;
+          if ( !m_manager.registerIOVType(typ_id, nam).second )   {
+            except("ConditionsXmlStreamReader","+++ Failed to register iov type: [%d]: %s",
+                   int(typ_id), nam.c_str());
+          }
+        }
+        else if ( reader.name() == "property" && state.stack.size() > 1 &&
+                  state.stack[state.stack.size()-2].type == MANAGER )   {
+          std::string nam, val;
+          attr_value("name",  nam);
+          attr_value("value", val);
+          try  {
+            m_manager[nam].str(val);
+          }
+          catch(const std::exception& e)  {
+            printout(ERROR,"ConditionsXmlStreamReader","++ FAILED: conditions Manager[%s] = %s [%s]",
+                     nam.c_str(), val.c_str(), e.what());
+          }
+        }
+        break;
+      }
+      continue;
+    }
+    // End element
+    if ( state.stack.size() <= depth )   {
+      except("ConditionsXmlStreamReader","+++ %s:%ld: Unbalanced end tag </%s>",
+             file_name.c_str(), long(reader.line()), reader.name().c_str());
+    }
+    State::Frame frame = std::move(state.stack.back());
+    state.stack.pop_back();
+    if ( frame.tag != reader.name() )   {
+      except("ConditionsXmlStreamReader","+++ %s:%ld: Mismatched end tag </%s>. Expected </%s>",
+             file_name.c_str(), long(reader.line()), reader.name().c_str(), frame.tag.c_str());
+    }
+    if ( state.inCondition )   {
+      if ( frame.type == ITEM && cur.type == MAPPING )   {
+        if ( cur.itemAttrs )
+          cur.items.emplace_back(cur.itemKey, cur.itemValue);
+        else
+          cur.items.emplace_back(std::string(), cur.itemText);
+        cur.itemHasKey.push_back(cur.itemAttrs);
+        cur.itemText.clear();
+        continue;
+      }
+      if ( state.stack.size()+1 != cur.level )
+        continue;
+      state.inCondition = false;
+      if ( !cur.selected )
+        continue;
+      else if ( !state.pool )   {
+        except("ConditionsXmlStreamReader","+++ %s:%ld: Condition %s outside of an <iov> section.",
+               file_name.c_str(), long(reader.line()), cur.name.c_str());
+      }
+      Condition con(state.detector.path()+"#"+cur.name, cur.ctype);
+      con->hash = ConditionKey::hashCode(state.detector, cur.name);
+#if !defined(DD4HEP_MINIMAL_CONDITIONS)
+      con->address  = file_name;
+      con->value    = "";
+      con->validity = "";
+      con->comment  = cur.comment;
+#endif
+      if ( cur.type == VALUE )   {
+        std::string typ = cur.tag == "value" ? cur.ctype : std::string("double");
+        std::string val = cur.haveValue ? cur.value : cur.text;
+        const char* ptr   = val.c_str();
+        char*       end   = 0;
+        double      num   = typ == "double" ? std::strtod(ptr, &end) : 0e0;
+        bool        plain = end && end != ptr;
+        while( plain && std::isspace((unsigned char)*end) ) ++end;
+        plain = plain && *end == 0;
+        if ( !cur.unit.empty() ) val += "*"+cur.unit;
+        if ( plain )   // Plain number: no expression evaluation required
+          con->data.bind<double>() = cur.unit.empty() ? num : num * _unit(cur.unit);
+        else
+          detail::OpaqueDataBinder::bind(detail::ValueBinder(), con, typ, val);
+#if !defined(DD4HEP_MINIMAL_CONDITIONS)
+        con->value = val;
+#endif
+        if ( cur.tag == "pressure" )    con->setFlag(Condition::PRESSURE);
+        if ( cur.tag == "temperature" ) con->setFlag(Condition::TEMPERATURE);
+      }
+      else if ( cur.type == SEQUENCE )   {
+        const std::string& val = cur.haveValue ? cur.value : cur.text;
+        if ( !detail::OpaqueDataBinder::bind_sequence(con->data, cur.ctype, val) )  {
+          except("ConditionsXmlStreamReader",
+                 "++ Failed to convert unknown sequence conditions type: %s",cur.ctype.c_str());
+        }
+      }
+      else if ( cur.type == MAPPING )   {
+        detail::MapBinder binder;
+        detail::OpaqueDataBinder::bind_map(binder, con->data, cur.key_type, cur.value_type);
+        for( std::size_t i=0; i<cur.items.size(); ++i )   {
+          const auto& item = cur.items[i];
+          if ( cur.itemHasKey[i] )
+            detail::OpaqueDataBinder::insert_map(binder, con->data, cur.key_type, item.first,
+                                                 cur.value_type, item.second);
+          else
+            detail::OpaqueDataBinder::insert_map(binder, con->data, cur.key_type,
+                                                 cur.value_type, item.second);
+        }
+      }
+      else if ( cur.type == DELTA )   {
+        Delta& delta = con.bind<Delta>();
+        delta = cur.delta;
+        if ( !cur.haveRotation ) delta.pivot = Translation3D();
+        if ( cur.haveRotation && cur.havePosition && cur.havePivot )
+          delta.flags |= Delta::HAVE_ROTATION|Delta::HAVE_PIVOT|Delta::HAVE_TRANSLATION;
+        else if ( cur.haveRotation && cur.havePosition )
+          delta.flags |= Delta::HAVE_ROTATION|Delta::HAVE_TRANSLATION;
+        else if ( cur.haveRotation && cur.havePivot )
+          delta.flags |= Delta::HAVE_ROTATION|Delta::HAVE_PIVOT;
+        else if ( cur.haveRotation )
+          delta.flags |= Delta::HAVE_ROTATION;
+        else if ( cur.havePosition )
+          delta.flags |= Delta::HAVE_TRANSLATION;
+        con->setFlag(Condition::ALIGNMENT_DELTA);
+      }
+      state.block.emplace_back(con);
+      continue;
+    }
+    switch( frame.type )   {
+    case IOV_SECTION:
+      state.flush(m_manager);
+      state.pool = frame.pool;
+      break;
+    case DETELEMENT:
+      state.detector = frame.detector;
+      break;
+    case MANAGER:
+      m_manager.initialize();
+      printout(DEBUG,"ConditionsXmlStreamReader","++ Conditions Manager successfully initialized.");
+      break;
+    default:
+      break;
+    }
+  }
+  if ( state.stack.size() != depth )   {
+    except("ConditionsXmlStreamReader","+++ %s: Unexpected end of file: %ld unclosed elements.",
+           file_name.c_str(), long(state.stack.size()-depth));
+  }
+}
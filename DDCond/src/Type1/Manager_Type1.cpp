@@ -34,6 +34,10 @@
 #include <DDCond/ConditionsIOVPool.h>
 #include <DDCond/ConditionsDataLoader.h>
 
+// C/C++ include files
+#include <mutex>
+#include <shared_mutex>
+
 using namespace dd4hep::cond;
 
 typedef UpdatePool::UpdateEntries Updates;
@@ -143,6 +147,7 @@ Manager_Type1::Manager_Type1(Detector& description_instance)
   declareProperty("UpdatePoolType",      m_updateType = "DD4hep_ConditionsLinearUpdatePool");
   declareProperty("UserPoolType",        m_userType   = "DD4hep_ConditionsMapUserPool");
   declareProperty("LoaderType",          m_loaderType = "DD4hep_Conditions_multi_Loader");
+  declareProperty("SharedArena",         m_sharedArena);
   m_iovTypes.resize(m_maxIOVTypes,IOVType());
   m_rawPool.resize(m_maxIOVTypes,0);
 }
@@ -159,6 +164,16 @@ void Manager_Type1::initialize()  {
     const void* argv_loader[] = {"ConditionsDataLoader", this, 0};
     const void* argv_pool[] = {this, 0, 0};
     m_loader.reset(createPlugin<ConditionsDataLoader>(typ,m_detDesc,2,argv_loader));
+    if ( !m_sharedArena.empty() )  {
+      // Immutable conditions published by another process: first source to be inspected.
+      // Only the multi-loader dispatches sources with a loader prefix.
+      if ( typ != "DD4hep_Conditions_multi_Loader" )  {
+        except("ConditionsMgr","+++ The shared conditions arena %s requires the loader "
+               "DD4hep_Conditions_multi_Loader. The loader %s cannot read it.",
+               m_sharedArena.c_str(), typ.c_str());
+      }
+      m_loader->addSource("mmap_snapshot:shm:"+m_sharedArena);
+    }
     m_updatePool.reset(createPlugin<UpdatePool>(m_updateType,m_detDesc,2,argv_pool));
     if ( !m_updatePool.get() )  {
       except("ConditionsMgr","+++ The update pool of type %s cannot be created. [%s]",
@@ -215,11 +230,22 @@ const dd4hep::IOVType* Manager_Type1::iovType (const std::string& iov_name) cons
 /// Register IOV with type and key
 ConditionsPool* Manager_Type1::registerIOV(const IOVType& typ, IOV::Key key)   {
   // IOV read and checked. Now register it, but always locked!
-  ConditionsIOVPool* pool = m_rawPool[typ.type];
-  dd4hep_lock_t      lock(m_poolLock);
-  if ( !pool )  {
-    m_rawPool[typ.type] = pool = new ConditionsIOVPool(&typ);
+  ConditionsIOVPool* pool = 0;  {
+    dd4hep_lock_t lock(m_poolLock);
+    pool = m_rawPool[typ.type];
+    if ( !pool )  {
+      m_rawPool[typ.type] = pool = new ConditionsIOVPool(&typ);
+    }
+  }
+  {  // Most of the time the IOV is already registered: a shared lock is sufficient
+    std::shared_lock<std::shared_timed_mutex> read_lock(pool->lock);
+    ConditionsIOVPool::Elements::const_iterator i = pool->elements.find(key);
+    if ( i != pool->elements.end() )   {
+      return (*i).second.get();
+    }
   }
+  std::lock_guard<std::shared_timed_mutex> write_lock(pool->lock);
+  // Check again: another thread may have registered the IOV in the meantime
   ConditionsIOVPool::Elements::const_iterator i = pool->elements.find(key);
   if ( i != pool->elements.end() )   {
     return (*i).second.get();
@@ -229,7 +255,7 @@ ConditionsPool* Manager_Type1::registerIOV(const IOVType& typ, IOV::Key key)   {
   iov->keyData   = key;
   const void* argv_pool[] = {this, iov, 0};
   std::shared_ptr<ConditionsPool> cond_pool(createPlugin<ConditionsPool>(m_poolType,m_detDesc,2,argv_pool));
-  pool->elements.emplace(key,cond_pool);
+  pool->insert(key,cond_pool);
   printout(INFO,"ConditionsMgr","Created IOV Pool for:%s",iov->str().c_str());
   return cond_pool.get();
 }
@@ -240,11 +266,16 @@ ConditionsIOVPool* Manager_Type1::iovPool(const IOVType& iov_type)  const    {
 }
 
 /// Register new condition with the conditions store. Unlocked version, not multi-threaded
+/** The insertion into the pool holds the exclusive lock of the IOV type's pool,
+ *  since other threads may select from the pool concurrently.
+ */
 bool Manager_Type1::registerUnlocked(ConditionsPool& pool, Condition cond)   {
   if ( cond.isValid() )  {
     cond->iov  = pool.iov;
-    cond->setFlag(Condition::ACTIVE);
-    pool.insert(cond);
+    cond->setFlag(Condition::ACTIVE);  {
+      std::lock_guard<std::shared_timed_mutex> guard(m_rawPool[pool.iov->iovType->type]->lock);
+      pool.insert(cond);
+    }
 #if !defined(DD4HEP_MINIMAL_CONDITIONS) && defined(DD4HEP_CONDITIONS_HAVE_NAME)
     printout(DEBUG,"ConditionsMgr","Register condition %016lX %s [%s] IOV:%s",
              cond.key(), cond.name(), cond->address.c_str(), pool.iov->str().c_str());
@@ -267,22 +298,29 @@ bool Manager_Type1::registerUnlocked(ConditionsPool& pool, Condition cond)   {
 }
 
 /// Register a whole block of conditions with identical IOV.
+/** The insertion into the pool holds the exclusive lock of the IOV type's pool,
+ *  since other threads may select from the pool concurrently.
+ */
 std::size_t Manager_Type1::blockRegister(ConditionsPool& pool, const std::vector<Condition>& cond) const {
   std::size_t result = 0;
   for(auto c : cond)   {
-    if ( c.isValid() )    {
+    if ( !c.isValid() )    {
+      except("ConditionsMgr",
+             "+++ Invalid condition objects may not be registered. [%s]",
+             Errors::invalidArg().c_str());    
+    }
+  }  {
+    std::lock_guard<std::shared_timed_mutex> guard(m_rawPool[pool.iov->iovType->type]->lock);
+    for(auto c : cond)   {
       c->iov = pool.iov;
       c->setFlag(Condition::ACTIVE);
       pool.insert(c);
-      if ( !m_onRegister.empty() )   {
-        __callListeners(m_onRegister, &ConditionsListener::onRegisterCondition, c);
-      }
       ++result;
-      continue;
     }
-    except("ConditionsMgr",
-           "+++ Invalid condition objects may not be registered. [%s]",
-           Errors::invalidArg().c_str());    
+  }
+  if ( !m_onRegister.empty() )   {
+    for(auto c : cond)
+      __callListeners(m_onRegister, &ConditionsListener::onRegisterCondition, c);
   }
   return result;
 }
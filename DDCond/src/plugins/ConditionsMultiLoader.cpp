@@ -30,17 +30,35 @@ namespace dd4hep {
 
     /// Implementation of a stack of conditions assembled before application
     /** 
+     *  Each data source is read by its own loader instance, which is created
+     *  on first use from the source prefix: "<type>:<source>" is read by the
+     *  plugin DD4hep_Conditions_<type>_Loader.
+     *
+     *  If the property "NumThreads" is larger than 1 (negative: hardware
+     *  concurrency), the sources matching the requested IOV are read
+     *  concurrently by at most this number of threads. The results are
+     *  merged in the order of the source declarations: if a condition is
+     *  present in several sources, the first declared source wins.
+     *  Loaders registering the conditions to the manager while loading
+     *  (e.g. mmap_snapshot) serialize the registration among themselves.
+     *
+     *  Only loaders, which load the required items on demand (load_many),
+     *  may be used. Sources of type xml and root_snapshot are rejected.
+     *
      *  \author   M.Frank
      *  \version  1.0
      *  \ingroup  DD4HEP_CONDITIONS
      */
     class ConditionsMultiLoader : public ConditionsDataLoader   {
-      typedef std::map<std::string, ConditionsDataLoader*> Loaders;
       typedef std::map<std::string, ConditionsDataLoader*> OpenSources;
 
-      Loaders m_loaders;
+      /// Loader instances by source name
       OpenSources m_openSources;
-      ConditionsDataLoader* load_source(const std::string& nam,const IOV& req_validity);
+      /// Property: maximal number of sources read concurrently
+      int         m_numThreads = 1;
+
+      /// Access the loader of a source. Created on first use.
+      ConditionsDataLoader* load_source(const std::string& nam, const IOV& source_validity);
 
     public:
       /// Default constructor
@@ -58,14 +76,10 @@ namespace dd4hep {
                                  RangeConditions& conditions);
 #endif
       /// Optimized update using conditions slice data
-      virtual size_t load_many(  const IOV& /* req_validity */,
-                                 RequiredItems&  /* work         */,
-                                 LoadedItems&    /* loaded       */,
-                                 IOV&       /* conditions_validity */)
-      {
-        except("ConditionsLoader","+++ update: Invalid call!");
-        return 0;
-      }
+      virtual size_t load_many(  const IOV&      req_validity,
+                                 RequiredItems&  work,
+                                 LoadedItems&    loaded,
+                                 IOV&            conditions_validity)  override;
     };
   }     /* End namespace detail                     */
 }       /* End namespace dd4hep                       */
@@ -92,10 +106,29 @@ namespace dd4hep {
 #include <DD4hep/PluginCreators.h>
 #include <DDCond/ConditionsManager.h>
 
+// C/C++ include files
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+
 // Forward declartions
 using namespace dd4hep::cond;
 
 namespace {
+  /// Check if a data source may contain conditions for the requested IOV
+  bool source_matches(const dd4hep::IOV& source, const dd4hep::IOV& req)   {
+    if ( !source.iovType ) return true;      // Sources without validity: always inspect
+    return dd4hep::IOV::same_type(source, req) &&
+      source.keyData.first <= req.keyData.second && req.keyData.first <= source.keyData.second;
+  }
+
+  /// Check if the loader of a source type implements load_many
+  bool loads_on_demand(const std::string& ident)   {
+    return ident != "xml" && ident != "root_snapshot";
+  }
+
   void* create_loader(dd4hep::Detector& description, int argc, char** argv)   {
     const char* name = argc>0 ? argv[0] : "MULTILoader";
     ConditionsManager::Object* mgr = (ConditionsManager::Object*)(argc>0 ? argv[1] : 0);
@@ -108,15 +141,20 @@ DECLARE_DD4HEP_CONSTRUCTOR(DD4hep_Conditions_multi_Loader,create_loader)
 ConditionsMultiLoader::ConditionsMultiLoader(Detector& description, ConditionsManager mgr, const std::string& nam) 
 : ConditionsDataLoader(description, mgr, nam)
 {
+  declareProperty("NumThreads", m_numThreads);
 }
 
 /// Default Destructor
 ConditionsMultiLoader::~ConditionsMultiLoader() {
+  for( auto& src : m_openSources )
+    dd4hep::detail::deletePtr(src.second);
+  m_openSources.clear();
 } 
 
+/// Access the loader of a source. Created on first use.
 ConditionsDataLoader* 
 ConditionsMultiLoader::load_source(const std::string& nam,
-                                   const IOV& req_validity)
+                                   const IOV& source_validity)
 {
   OpenSources::iterator iop = m_openSources.find(nam);
   if ( iop == m_openSources.end() )  {
@@ -125,23 +163,20 @@ ConditionsMultiLoader::load_source(const std::string& nam,
       except("ConditionsMultiLoader","Invalid data source specification: "+nam);
     }
     std::string ident = nam.substr(0,idx);
-    Loaders::iterator ild = m_loaders.find(ident);
-    ConditionsDataLoader* loader = 0;
-    if ( ild == m_loaders.end() )  {
-      std::string typ = "DD4hep_Conditions_"+ident+"_Loader";
-      std::string fac = ident+"_ConditionsDataLoader";
-      const void* argv[] = {fac.c_str(), m_mgr.ptr(), 0};
-      loader = createPlugin<ConditionsDataLoader>(typ,m_detector,2,argv);
-      if ( !loader )  {
-        except("ConditionsMultiLoader",
-               "Failed to create conditions loader of type: "+typ+" to read:"+nam);
-      }
+    if ( !loads_on_demand(ident) )   {
+      except("ConditionsMultiLoader",
+             "The %s loader cannot load conditions on demand. Invalid data source: %s",
+             ident.c_str(), nam.c_str());
     }
-    else  {
-      loader = (*ild).second;
+    std::string typ = "DD4hep_Conditions_"+ident+"_Loader";
+    std::string fac = ident+"_ConditionsDataLoader";
+    const void* argv[] = {fac.c_str(), m_mgr.ptr(), 0};
+    ConditionsDataLoader* loader = createPlugin<ConditionsDataLoader>(typ,m_detector,2,argv);
+    if ( !loader )  {
+      except("ConditionsMultiLoader",
+             "Failed to create conditions loader of type: "+typ+" to read:"+nam);
     }
-    loader->addSource(nam.substr(idx+1),req_validity);
-    m_loaders[ident] = loader;
+    loader->addSource(nam.substr(idx+1),source_validity);
     m_openSources[nam] = loader;
     return loader;
   }
@@ -188,3 +223,70 @@ size_t ConditionsMultiLoader::load_single(key_type key,
   return conditions.size() - len;
 }
 #endif
+
+/// Optimized update using conditions slice data
+size_t ConditionsMultiLoader::load_many(const IOV&      req_validity,
+                                        RequiredItems&  work,
+                                        LoadedItems&    loaded,
+                                        IOV&            conditions_validity)
+{
+  /// Per-source work item
+  struct Job  {
+    ConditionsDataLoader* loader;
+    LoadedItems           loaded;
+    IOV                   validity;
+    Job(ConditionsDataLoader* l, const IOV& iov) : loader(l), validity(iov) {}
+  };
+  size_t len = loaded.size();
+  std::vector<Job> jobs;
+  for( const auto& src : m_sources )  {
+    if ( source_matches(src.second, req_validity) )
+      jobs.emplace_back(load_source(src.first, src.second), conditions_validity);
+  }
+  size_t num_threads = m_numThreads < 0 ? std::thread::hardware_concurrency() : size_t(m_numThreads);
+  num_threads = std::min(num_threads, jobs.size());
+  if ( num_threads < 2 )   {
+    // Sequential loading: stop as soon as all required items are present
+    for( auto& j : jobs )  {
+      if ( loaded.size()-len >= work.size() ) break;
+      j.loader->load_many(req_validity, work, loaded, conditions_validity);
+    }
+    return loaded.size()-len;
+  }
+
+  std::atomic<size_t> next(0);
+  std::exception_ptr  error;
+  std::mutex          lock;
+  auto load = [&]()  {
+    try  {
+      // Every source gets its own copy of the work items: loaders may modify them
+      for( size_t i = next++; i < jobs.size(); i = next++ )  {
+        RequiredItems items(work);
+        jobs[i].loader->load_many(req_validity, items, jobs[i].loaded, jobs[i].validity);
+      }
+    }
+    catch(...)  {
+      std::lock_guard<std::mutex> guard(lock);
+      if ( !error ) error = std::current_exception();
+      next = jobs.size();
+    }
+  };
+  std::vector<std::thread> threads;
+  for( size_t i=1; i < num_threads; ++i )
+    threads.emplace_back(load);
+  load();
+  for( auto& t : threads ) t.join();
+  if ( error )  {
+    std::rethrow_exception(error);
+  }
+  // Sequential merge in the order of the source declarations
+  for( const auto& j : jobs )  {
+    if ( !j.loaded.empty() )  {
+      loaded.insert(j.loaded.begin(), j.loaded.end());
+      conditions_validity.iov_intersection(j.validity);
+    }
+  }
+  printout(DEBUG,"ConditionsMultiLoader","+++ Loaded %ld conditions from %ld sources using %ld threads.",
+           long(loaded.size()-len), long(jobs.size()), long(num_threads));
+  return loaded.size()-len;
+}
@@ -26,6 +26,7 @@
 
 #include <DDCond/ConditionsTags.h>
 #include <DDCond/ConditionsManager.h>
+#include <DDCond/ConditionsXmlStreamReader.h>
 
 // C/C++ include files
 #include <stdexcept>
@@ -460,3 +461,21 @@ static long setup_repository_Conditions(dd4hep::Detector& description, int argc,
   return 0;
 }
 DECLARE_APPLY(DD4hep_ConditionsXMLRepositoryParser,setup_repository_Conditions)
+
+/// Entry point to read conditions files with the streaming reader (no DOM tree)
+/**
+ *  Same file format and arguments as DD4hep_ConditionsXMLRepositoryParser.
+ *
+ *  \version 1.0
+ */
+static long setup_repository_stream_Conditions(dd4hep::Detector& description, int argc, char** argv)  {
+  if ( argc == 1 )  {
+    dd4hep::detail::DD4hepUI ui(description);
+    dd4hep::cond::ConditionsXmlStreamReader reader(description, ui.conditionsMgr());
+    reader.parse(argv[0]);
+    return 1;
+  }
+  dd4hep::except("XML_DOC_READER","Invalid number of arguments to interprete conditions: %d != %d.",argc,1);
+  return 0;
+}
+DECLARE_APPLY(DD4hep_ConditionsXMLRepositoryStreamParser,setup_repository_stream_Conditions)
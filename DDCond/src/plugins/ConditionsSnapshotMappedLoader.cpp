@@ -0,0 +1,120 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+//==========================================================================
+#ifndef DD4HEP_CONDITIONS_CONDITIONSSNAPSHOTMAPPEDLOADER_H
+#define DD4HEP_CONDITIONS_CONDITIONSSNAPSHOTMAPPEDLOADER_H
+
+// Framework include files
+#include <DDCond/ConditionsDataLoader.h>
+#include <DDCond/ConditionsMappedSnapshot.h>
+#include <DD4hep/Printout.h>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for implementation details of the AIDA detector description toolkit
+  namespace cond  {
+
+    /// Conditions loader reading memory mapped conditions snapshots
+    /**
+     *  Data sources are snapshot files written by ConditionsMappedSnapshot.
+     *  The files are mapped on first use and only the requested conditions
+     *  valid for the required IOV are created. Plain data payloads are not
+     *  copied, but reference the mapped file, which hence stays mapped as
+     *  long as the loader lives.
+     *
+     *  Use with the multi-loader: <source>mmap_snapshot:Conditions.snapshot</source>
+     *  Sources of the form "shm:<arena>" attach read-only to the shared memory
+     *  arena published by ConditionsMappedSnapshot::publish.
+     *
+     *  \version  1.0
+     *  \ingroup  DD4HEP_CONDITIONS
+     */
+    class ConditionsSnapshotMappedLoader : public ConditionsDataLoader   {
+      std::vector<std::unique_ptr<ConditionsMappedSnapshot> > snapshots;
+      void load_sources();
+    public:
+      /// Default constructor
+      ConditionsSnapshotMappedLoader(Detector& description, ConditionsManager mgr, const std::string& nam);
+      /// Default destructor
+      virtual ~ConditionsSnapshotMappedLoader();
+      /// Optimized update using conditions slice data
+      virtual size_t load_many(  const IOV&       req_validity,
+                                 RequiredItems&   work,
+                                 LoadedItems&     loaded,
+                                 IOV&             conditions_validity)  override;
+    };
+  }    /* End namespace cond                             */
+}      /* End namespace dd4hep                            */
+#endif /* DD4HEP_CONDITIONS_CONDITIONSSNAPSHOTMAPPEDLOADER_H  */
+
+//#include <ConditionsSnapshotMappedLoader.h>
+#include <DD4hep/Printout.h>
+#include <DD4hep/Factories.h>
+#include <DD4hep/PluginCreators.h>
+
+// C/C++ include files
+#include <string>
+
+// Forward declartions
+using namespace dd4hep::cond;
+
+namespace {
+  void* create_loader(dd4hep::Detector& description, int argc, char** argv)   {
+    const char* name = argc>0 ? argv[0] : "MappedSnapshotLoader";
+    ConditionsManagerObject* mgr = (ConditionsManagerObject*)(argc>0 ? argv[1] : 0);
+    return new ConditionsSnapshotMappedLoader(description,ConditionsManager(mgr),name);
+  }
+}
+DECLARE_DD4HEP_CONSTRUCTOR(DD4hep_Conditions_mmap_snapshot_Loader,create_loader)
+
+/// Standard constructor, initializes variables
+ConditionsSnapshotMappedLoader::ConditionsSnapshotMappedLoader(Detector& description, ConditionsManager mgr, const std::string& nam)
+: ConditionsDataLoader(description, mgr, nam)
+{
+}
+
+/// Default Destructor
+ConditionsSnapshotMappedLoader::~ConditionsSnapshotMappedLoader() {
+  snapshots.clear();
+}
+
+void ConditionsSnapshotMappedLoader::load_sources()  {
+  for(const auto& src : m_sources )  {
+    if ( src.first.compare(0, 4, "shm:") == 0 )
+      snapshots.emplace_back(ConditionsMappedSnapshot::attach(src.first.substr(4)));
+    else
+      snapshots.emplace_back(ConditionsMappedSnapshot::open(src.first));
+    printout(INFO,"MappedSnapshotLoader","+++ Mapped %ld conditions from %s",
+             long(snapshots.back()->numConditions()), src.first.c_str());
+  }
+  m_sources.clear();
+}
+
+/// Optimized update using conditions slice data
+size_t ConditionsSnapshotMappedLoader::load_many(const IOV&      req_validity,
+                                                 RequiredItems&  work,
+                                                 LoadedItems&    loaded,
+                                                 IOV&            conditions_validity)
+{
+  size_t len = loaded.size();
+  std::vector<Condition::key_type> keys;
+  load_sources();
+  keys.reserve(work.size());
+  for(const auto& w : work )
+    keys.emplace_back(w.first);
+  for(const auto& snap : snapshots )  {
+    snap->import(req_validity, keys, m_mgr, loaded, conditions_validity);
+    if ( loaded.size()-len == keys.size() ) break;
+  }
+  printout(DEBUG,"MappedSnapshotLoader","+++ Loaded %ld out of %ld conditions for IOV %s",
+           long(loaded.size()-len), long(keys.size()), req_validity.str().c_str());
+  return loaded.size()-len;
+}
@@ -514,35 +514,46 @@ ConditionsMappedUserPool<MAPPING>::prepare(const IOV&                  required,
   bool   do_output_miss  = m_manager->doOutputUnloaded();
   IOV    pool_iov(required.iovType);
   ConditionsManager::Result result;
-
-  // This is a critical operation, because we have to ensure the
-  // IOV pools are ONLY manipulated by the current thread.
-  // Otherwise the selection and the population are unsafe!
-  static std::mutex lock;
-  std::lock_guard<std::mutex> guard(lock);
-
-  m_conditions.clear();
-  slice_miss_cond.clear();
-  slice_miss_calc.clear();
-  pool_iov.reset().invert();
-  m_iovPool->select(required, Operators::mapConditionsSelect(m_conditions), pool_iov);
-  m_iov = pool_iov;
-  CondMissing cond_missing(slice_cond.size()+m_conditions.size());
-  CalcMissing calc_missing(slice_calc.size()+m_conditions.size());
-
-  CondMissing::iterator last_cond = set_difference(begin(slice_cond),   end(slice_cond),
-                                                   begin(m_conditions), end(m_conditions),
-                                                   begin(cond_missing), COMP());
-  long num_cond_miss = last_cond-begin(cond_missing);
-  cond_missing.resize(num_cond_miss);
+  CondMissing cond_missing;
+  CalcMissing calc_missing;
+  CondMissing::iterator last_cond;
+  CalcMissing::iterator last_calc;
+  long num_cond_miss = 0, num_calc_miss = 0;
+
+  // The selection from the IOV pools only requires a shared lock and may run concurrently.
+  // Only if conditions must be loaded or computed, the shared IOV pools get populated:
+  // this is serialized and the selection is repeated, since another thread may have
+  // populated the IOV pools in the meantime.
+  std::unique_lock<std::mutex> populate_guard(m_iovPool->populateLock, std::defer_lock);
+  for(;;)   {
+    m_conditions.clear();
+    slice_miss_cond.clear();
+    slice_miss_calc.clear();
+    pool_iov.reset().invert();
+    m_iovPool->select(required, Operators::mapConditionsSelect(m_conditions), pool_iov);
+    m_iov = pool_iov;
+    cond_missing.resize(slice_cond.size()+m_conditions.size());
+    calc_missing.resize(slice_calc.size()+m_conditions.size());
+
+    last_cond = set_difference(begin(slice_cond),   end(slice_cond),
+                               begin(m_conditions), end(m_conditions),
+                               begin(cond_missing), COMP());
+    num_cond_miss = last_cond-begin(cond_missing);
+    cond_missing.resize(num_cond_miss);
+    last_cond = end(cond_missing);
+    last_calc = set_difference(begin(slice_calc),   end(slice_calc),
+                               begin(m_conditions), end(m_conditions),
+                               begin(calc_missing), COMP());
+    num_calc_miss = last_calc-begin(calc_missing);
+    calc_missing.resize(num_calc_miss);
+    last_calc = end(calc_missing);
+    if ( !do_load || (num_cond_miss == 0 && num_calc_miss == 0) || populate_guard.owns_lock() )
+      break;
+    populate_guard.lock();
+  }
   printout((flags&PRINT_LOAD) ? INFO : DEBUG,"UserPool",
            "%ld conditions out of %ld conditions are MISSING.",
            num_cond_miss, slice_cond.size());
-  CalcMissing::iterator last_calc = set_difference(begin(slice_calc),   end(slice_calc),
-                                                   begin(m_conditions), end(m_conditions),
-                                                   begin(calc_missing), COMP());
-  long num_calc_miss = last_calc-begin(calc_missing);
-  calc_missing.resize(num_calc_miss);
   printout((flags&PRINT_COMPUTE) ? INFO : DEBUG,"UserPool",
            "%ld derived conditions out of %ld conditions are MISSING.",
            num_calc_miss, slice_calc.size());
@@ -598,6 +609,7 @@ ConditionsMappedUserPool<MAPPING>::prepare(const IOV&                  required,
   if ( num_calc_miss > 0 )  {
     if ( do_load )  {
       std::map<Condition::key_type,const ConditionDependency*> deps(calc_missing.begin(),last_calc);
+      detail::ConditionsArena::Scope arena(slice.arena.get());
       ConditionsDependencyHandler handler(m_manager, *this, deps, user_param);
       /// 1rst pass: Compute/create the missing condiions
       handler.compute();
@@ -639,24 +651,29 @@ ConditionsMappedUserPool<MAPPING>::load(const IOV&                  required,
   bool   do_output_miss  = m_manager->doOutputUnloaded();
   IOV    pool_iov(required.iovType);
   ConditionsManager::Result result;
-
-  // This is a critical operation, because we have to ensure the
-  // IOV pools are ONLY manipulated by the current thread.
-  // Otherwise the selection and the population are unsafe!
-  static std::mutex lock;
-  std::lock_guard<std::mutex> guard(lock);
-
-  m_conditions.clear();
-  slice_miss_cond.clear();
-  pool_iov.reset().invert();
-  m_iovPool->select(required, Operators::mapConditionsSelect(m_conditions), pool_iov);
-  m_iov = pool_iov;
-  CondMissing cond_missing(slice_cond.size()+m_conditions.size());
-  CondMissing::iterator last_cond = set_difference(begin(slice_cond),   end(slice_cond),
-                                                   begin(m_conditions), end(m_conditions),
-                                                   begin(cond_missing), COMP());
-  long num_cond_miss = last_cond-begin(cond_missing);
-  cond_missing.resize(num_cond_miss);
+  CondMissing cond_missing;
+  CondMissing::iterator last_cond;
+  long num_cond_miss = 0;
+
+  // Concurrent selection. Loading is serialized, see the comment in prepare()
+  std::unique_lock<std::mutex> populate_guard(m_iovPool->populateLock, std::defer_lock);
+  for(;;)   {
+    m_conditions.clear();
+    slice_miss_cond.clear();
+    pool_iov.reset().invert();
+    m_iovPool->select(required, Operators::mapConditionsSelect(m_conditions), pool_iov);
+    m_iov = pool_iov;
+    cond_missing.resize(slice_cond.size()+m_conditions.size());
+    last_cond = set_difference(begin(slice_cond),   end(slice_cond),
+                               begin(m_conditions), end(m_conditions),
+                               begin(cond_missing), COMP());
+    num_cond_miss = last_cond-begin(cond_missing);
+    cond_missing.resize(num_cond_miss);
+    last_cond = end(cond_missing);
+    if ( !do_load || num_cond_miss == 0 || populate_guard.owns_lock() )
+      break;
+    populate_guard.lock();
+  }
   printout((flags&PRINT_LOAD) ? INFO : DEBUG,"UserPool",
            "Found %ld missing conditions out of %ld conditions.",
            num_cond_miss, slice_cond.size());
@@ -711,22 +728,29 @@ ConditionsMappedUserPool<MAPPING>::compute(const IOV&                  required,
   auto&  slice_miss_calc = slice.missingDerivations();
   bool   do_load         = m_manager->doLoadConditions();
   bool   do_output       = m_manager->doOutputUnloaded();
-  IOV    pool_iov(required.iovType);
   ConditionsManager::Result result;
-
-  // This is a critical operation, because we have to ensure the
-  // IOV pools are ONLY manipulated by the current thread.
-  // Otherwise the selection and the population are unsafe!
-  static std::mutex lock;
-  std::lock_guard<std::mutex> guard(lock);
-
-  slice_miss_calc.clear();
-  CalcMissing calc_missing(slice_calc.size()+m_conditions.size());
-  CalcMissing::iterator last_calc = set_difference(begin(slice_calc),   end(slice_calc),
-                                                   begin(m_conditions), end(m_conditions),
-                                                   begin(calc_missing), COMP());
-  long num_calc_miss = last_calc-begin(calc_missing);
-  calc_missing.resize(num_calc_miss);
+  CalcMissing calc_missing;
+  CalcMissing::iterator last_calc;
+  long num_calc_miss = 0;
+
+  // Computing derived conditions populates the shared IOV pool and is serialized.
+  // Once locked, the derived conditions registered meanwhile by other threads are added.
+  // The lock is taken whenever derived conditions are missing and held until they are computed.
+  std::unique_lock<std::mutex> populate_guard(m_iovPool->populateLock, std::defer_lock);
+  for(;;)   {
+    slice_miss_calc.clear();
+    calc_missing.resize(slice_calc.size()+m_conditions.size());
+    last_calc = set_difference(begin(slice_calc),   end(slice_calc),
+                               begin(m_conditions), end(m_conditions),
+                               begin(calc_missing), COMP());
+    num_calc_miss = last_calc-begin(calc_missing);
+    calc_missing.resize(num_calc_miss);
+    last_calc = end(calc_missing);
+    if ( num_calc_miss == 0 || populate_guard.owns_lock() )
+      break;
+    populate_guard.lock();
+    m_iovPool->select(required, Operators::mapConditionsSelect(m_conditions), m_iov);
+  }
   printout((flags&PRINT_COMPUTE) ? INFO : DEBUG,"UserPool",
            "Found %ld missing derived conditions out of %ld conditions.",
            num_calc_miss, m_conditions.size());
@@ -741,6 +765,7 @@ ConditionsMappedUserPool<MAPPING>::compute(const IOV&                  required,
   if ( num_calc_miss > 0 )  {
     if ( do_load )  {
       std::map<Condition::key_type,const ConditionDependency*> deps(calc_missing.begin(),last_calc);
+      detail::ConditionsArena::Scope arena(slice.arena.get());
       ConditionsDependencyHandler handler(m_manager, *this, deps, user_param);
 
       /// 1rst pass: Compute/create the missing condiions
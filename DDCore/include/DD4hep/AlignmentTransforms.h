@@ -0,0 +1,154 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+//==========================================================================
+#ifndef DD4HEP_ALIGNMENTTRANSFORMS_H
+#define DD4HEP_ALIGNMENTTRANSFORMS_H
+
+// Framework include files
+#include "DD4hep/DetElement.h"
+#include "DD4hep/Objects.h"
+
+// ROOT include files
+#include "TGeoMatrix.h"
+
+// C/C++ include files
+#include <map>
+#include <vector>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the alignment part of the AIDA detector description toolkit
+  namespace align {
+
+    /// Compact storage of the aligned transformations of many detector elements
+    /**
+     *  Every transformation is stored as a 3x4 matrix (rotation and translation)
+     *  in structure-of-arrays layout: each of the 12 matrix elements has its own
+     *  contiguous array indexed by the slot of the detector element.
+     *  Compared to the AlignmentData objects this avoids the TObject, name and
+     *  scale overhead of the TGeoHMatrix instances and allows to chain the
+     *  transformations of many detector elements in tight, vectorizable loops.
+     *
+     *  TGeoHMatrix and Transform3D objects are only created on demand.
+     *  Points are transformed directly using the compact representation.
+     *
+     *  The container is filled by the AlignmentsCalculator and is usually
+     *  owned by the conditions slice as a derived condition
+     *  (see AlignmentsCalculator::transforms).
+     *
+     *  \version 1.0
+     *  \ingroup DD4HEP_ALIGN
+     */
+    class AlignmentTransforms  {
+    public:
+      /// Component wise storage of 3x4 transformation matrices
+      /**
+       *  Matrix elements 0...8 are the rotation matrix (row major),
+       *  elements 9...11 the translation.
+       *
+       *  \version 1.0
+       *  \ingroup DD4HEP_ALIGN
+       */
+      class Matrices  {
+      public:
+        /// Matrix element arrays
+        std::vector<double> m[12];
+      public:
+        /// Number of stored matrices
+        std::size_t size()  const                  {  return m[0].size();              }
+        /// Reserve space for n matrices
+        void reserve(std::size_t n)                {  for(auto& c : m) c.reserve(n);   }
+        /// Resize the arrays to hold n matrices
+        void resize(std::size_t n)                 {  for(auto& c : m) c.resize(n);    }
+        /// Remove all matrices
+        void clear()                               {  for(auto& c : m) c.clear();      }
+        /// Store matrix at position i
+        void set(std::size_t i, const TGeoMatrix& matrix);
+        /// Store matrix at position i from matrix at position j of another container
+        void set(std::size_t i, const Matrices& source, std::size_t j);
+        /// Fill the matrix at position i into a TGeoHMatrix
+        void get(std::size_t i, TGeoHMatrix& matrix)  const;
+        /// Transform a point with the matrix at position i
+        Position apply(std::size_t i, const Position& point)  const;
+        /// Transform a point with the inverse of the matrix at position i (rotation must be orthogonal)
+        Position applyInverse(std::size_t i, const Position& point)  const;
+      };
+
+      /// Invalid slot identifier
+      static constexpr std::size_t npos = ~std::size_t(0);
+
+    protected:
+      /// Slot index by detector element key
+      std::map<unsigned int,std::size_t> m_slots;
+      /// Detector element of each slot
+      std::vector<DetElement>            m_detectors;
+      /// Transformations to the parent detector element
+      Matrices                           m_detectorTrafo;
+      /// Transformations to the world
+      Matrices                           m_worldTrafo;
+
+      /// Access the slot of a detector element. Throws exception if not present.
+      std::size_t _slot(DetElement detector)  const;
+
+    public:
+      /// Default constructor
+      AlignmentTransforms() = default;
+      /// Copy constructor
+      AlignmentTransforms(const AlignmentTransforms& copy) = default;
+      /// Default destructor
+      ~AlignmentTransforms() = default;
+      /// Assignment operator
+      AlignmentTransforms& operator=(const AlignmentTransforms& copy) = default;
+
+      /// Number of detector elements stored
+      std::size_t size()  const                    {  return m_detectors.size();       }
+      /// Remove all transformations
+      void clear();
+      /// Reserve space for n detector elements
+      void reserve(std::size_t n);
+      /// Add a detector element and return its slot. Existing entries are not duplicated.
+      std::size_t add(DetElement detector);
+      /// Access the slot of a detector element. Returns npos if not present.
+      std::size_t slot(DetElement detector)  const;
+      /// Access the detector element of a given slot
+      DetElement detector(std::size_t slot)  const {  return m_detectors.at(slot);     }
+      /// Access to the matrices to the parent detector element
+      Matrices& detectorMatrices()                 {  return m_detectorTrafo;          }
+      /// Access to the matrices to the parent detector element
+      const Matrices& detectorMatrices()  const    {  return m_detectorTrafo;          }
+      /// Access to the matrices to the world
+      Matrices& worldMatrices()                    {  return m_worldTrafo;             }
+      /// Access to the matrices to the world
+      const Matrices& worldMatrices()  const       {  return m_worldTrafo;             }
+
+      /// Chain transformations: world[i] = world[i] * detector[i] for all slots in [begin,end)
+      /** On entry the world matrices of the slots must hold the world transformation
+       *  of the parent detector elements. Slots within the range must not depend
+       *  on each other, which is e.g. guaranteed if they are on the same hierarchy level.
+       */
+      void chain(std::size_t begin, std::size_t end);
+
+      /// Create the transformation to the world of a detector element
+      TGeoHMatrix worldTransformation(DetElement detector)  const;
+      /// Create the transformation to the parent detector element
+      TGeoHMatrix detectorTransformation(DetElement detector)  const;
+      /// Create the transformation from the local coordinates to the world system
+      Transform3D localToWorld(DetElement detector)  const;
+      /// Transformation from local coordinates of the detector element to the world system
+      Position localToWorld(DetElement detector, const Position& local)  const;
+      /// Transformation from world coordinates to the local coordinates of the detector element
+      Position worldToLocal(DetElement detector, const Position& global)  const;
+      /// Transformation from local coordinates of the detector element to the parent detector
+      Position localToDetector(DetElement detector, const Position& local)  const;
+    };
+  }       /* End namespace align                  */
+}         /* End namespace dd4hep                 */
+#endif // DD4HEP_ALIGNMENTTRANSFORMS_H
@@ -54,6 +54,10 @@ namespace dd4hep {
       static const std::string                         alignmentName;
       /// Key value of an alignment condition object "alignment".
       static const Condition::itemkey_type alignmentKey;
+      /// Key name  of the compact alignment transformations "alignment_transforms".
+      static const std::string                         transformsName;
+      /// Key value of the compact alignment transformations "alignment_transforms".
+      static const Condition::itemkey_type transformsKey;
     };
   }
 
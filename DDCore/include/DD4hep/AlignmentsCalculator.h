@@ -17,6 +17,7 @@
 #include "DD4hep/Alignments.h"
 #include "DD4hep/AlignmentData.h"
 #include "DD4hep/ConditionsMap.h"
+#include "DD4hep/AlignmentTransforms.h"
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
@@ -29,6 +30,13 @@ namespace dd4hep {
 
     /// Alignment calculator instance to handle alignment dependencies
     /**
+     *  If the calculator is constructed with more than one thread, the
+     *  independent sub-trees of the detector hierarchy are computed
+     *  concurrently by the threads of the shared detail::WorkerPool.
+     *  The conditions map is only accessed from the calling thread:
+     *  new alignment conditions are registered after all
+     *  transformations were computed.
+     *
      *  \author   M.Frank
      *  \version  1.0
      *  \ingroup  DD4HEP_ALIGN
@@ -47,6 +55,8 @@ namespace dd4hep {
         size_t computed = 0;
         size_t missing  = 0;
 	size_t multiply = 0;
+        /// Number of alignments taken unchanged from a previous incremental computation
+        size_t reused   = 0;
         Result() = default;
         /// Copy constructor
         Result(const Result& result) = default;
@@ -75,6 +85,48 @@ namespace dd4hep {
       typedef std::map<DetElement,const Delta*,PathOrdering> OrderedDeltas;
       typedef std::map<Condition::key_type,DetElement>       ExtractContext;
 
+      /// State of a previous computation to support incremental updates
+      /**
+       *  The context must be kept by the client between successive calls to
+       *  compute(). The new set of deltas is compared with the set used in the
+       *  previous call. Only detector elements, where the delta or the delta of
+       *  any parent element was added, removed or changed, are recomputed.
+       *
+       *  For all other detector elements the previous result is reused:
+       *  If the conditions map still contains the alignment condition
+       *  computed previously, the object is left untouched. Otherwise
+       *  the cached transformations are copied to the alignment condition
+       *  of the new map without any matrix multiplication.
+       *
+       *  \version 1.0
+       *  \ingroup DD4HEP_CONDITIONS
+       */
+      class IncrementalContext  {
+      public:
+        /// Cached result of one detector element
+        class Entry  {
+        public:
+          /// The delta used for the computation
+          Delta        delta;
+          /// Transformation to the parent detector element
+          TGeoHMatrix  detectorTrafo;
+          /// Transformation to the world
+          TGeoHMatrix  worldTrafo;
+          /// Transformation from volume to the world
+          Transform3D  trToWorld;
+          /// Alignment condition filled by the last computation (only used for identification)
+          const void*  condition = 0;
+          /// Flag if the detector element had a delta
+          bool         haveDelta = false;
+        };
+        typedef std::map<unsigned int,Entry> Entries;
+        /// Cached results by detector element key
+        Entries entries;
+      public:
+        /// Forget all previous results. The next computation is a full computation.
+        void clear()  {  entries.clear();  }
+      };
+
       /// Scanner to find all alignment deltas in the detector hierarchy
       /**
        *  The deltas are collected in the appropriate container suited for the
@@ -125,14 +177,23 @@ namespace dd4hep {
         int operator()(DetElement de, int)  const;
       };
 
-    public:
+    protected:
+      /// Number of threads to compute independent sub-trees (<= 1: sequential, < 0: all cores)
+      int m_numThreads = 0;
 
+    public:
       /// Default constructor
       AlignmentsCalculator() = default;
+      /// Initializing constructor for concurrent computations
+      explicit AlignmentsCalculator(int num_threads) : m_numThreads(num_threads) {}
       /// Copy constructor
       AlignmentsCalculator(const AlignmentsCalculator& copy) = delete;
       /// Assignment operator
       AlignmentsCalculator& operator=(const AlignmentsCalculator& mgr) = delete;
+      /// Number of threads used to compute independent sub-trees
+      int numThreads()  const                 {  return m_numThreads;  }
+      /// Set the number of threads used to compute independent sub-trees
+      void setNumThreads(int num_threads)     {  m_numThreads = num_threads;  }
       /// Compute all alignment conditions of the internal dependency list
       Result compute(const std::map<DetElement, Delta>& deltas,
                      ConditionsMap& alignments)  const;
@@ -141,6 +202,27 @@ namespace dd4hep {
                      ConditionsMap& alignments)  const;
       /// Optimized call using already properly ordered Deltas
       Result compute(const OrderedDeltas& deltas, ConditionsMap& alignments)  const;
+      /// Incremental computation: only sub-trees with changed deltas are recomputed
+      Result compute(const std::map<DetElement, Delta>& deltas,
+                     ConditionsMap& alignments,
+                     IncrementalContext& context)  const;
+      /// Incremental computation: only sub-trees with changed deltas are recomputed
+      Result compute(const OrderedDeltas& deltas,
+                     ConditionsMap& alignments,
+                     IncrementalContext& context)  const;
+
+      /// Compute the aligned transformations into the compact structure-of-arrays storage
+      /** No AlignmentCondition objects are created. The content of the
+       *  transformation container is replaced. Detector elements are
+       *  processed level by level: all elements of one hierarchy level
+       *  are chained with their parents in a single loop.
+       */
+      Result compute(const OrderedDeltas& deltas, AlignmentTransforms& transforms)  const;
+      /// Access the compact transformation container of a conditions map (e.g. a slice)
+      /** If not present, the container is created as a derived condition attached
+       *  to the detector element 'top' and owned by the conditions map.
+       */
+      static AlignmentTransforms& transforms(ConditionsMap& alignments, DetElement top);
 
       /// Helper: Extract all Delta-conditions from the conditions map
       size_t extract_deltas(cond::ConditionUpdateContext& context,
@@ -180,6 +262,7 @@ namespace dd4hep {
       multiply += result.multiply;
       computed += result.computed;
       missing  += result.missing;
+      reused   += result.reused;
       return *this;
     }
     /// Subtract results
@@ -188,6 +271,7 @@ namespace dd4hep {
       multiply -= result.multiply;
       computed -= result.computed;
       missing  -= result.missing;
+      reused   -= result.reused;
       return *this;
     }
 
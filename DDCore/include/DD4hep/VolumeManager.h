@@ -122,6 +122,14 @@ namespace dd4hep {
    *  subdetectors must have the same length to ensure the uniqueness of the
    *  placement keys.
    *
+   *  Once populated, the lookup containers may be 'frozen' (see freeze()):
+   *  the placements of each section are compiled into a sorted contiguous
+   *  array and the subdetector sections are dispatched through a jump table
+   *  indexed by the value of the system field. Lookups then cost a binary
+   *  search on a flat array instead of walking several red-black trees.
+   *  A frozen manager is read-only: adding placements or subdetectors
+   *  afterwards raises an exception.
+   *
    *  By default the volume manager in TREE mode (-> 1)) is attached to the
    *  Detector instance and also managed by this instance.
    *  If you wish to create instances yourself, you must ensure that the
@@ -140,6 +148,7 @@ namespace dd4hep {
       TREE = 1 << 1,   // Build 1 level DetElement hierarchy while populating
       ONE  = 1 << 2,   // Populate all daughter volumes into one big lookup-container
       // This flag may be in parallel with 'TREE'
+      FROZEN = 1 << 3, // Compile the lookup containers into flat tables after populating
       LAST
     };
 
@@ -197,6 +206,11 @@ namespace dd4hep {
     /// Register physical volume with the manager and pre-computed volume id
     bool adoptPlacement(VolumeID volume_id, VolumeManagerContext* context);
 
+    /// Compile the lookup containers into flat tables for fast read-only access. The manager becomes read-only
+    void freeze();
+    /// Check if the lookup containers were compiled into flat tables
+    bool isFrozen()  const;
+
     /** This set of functions is required when reading/analyzing
      *  already created hits which have a VolumeID attached.
      */
@@ -0,0 +1,149 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+//==========================================================================
+#ifndef DD4HEP_DETAIL_CONDITIONSARENA_H
+#define DD4HEP_DETAIL_CONDITIONSARENA_H
+
+// C/C++ include files
+#include <cstddef>
+#include <vector>
+#include <mutex>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// DD4hep internal namespace declaration for utilities and implementation details
+  namespace detail {
+
+    /// Chunked memory arena for condition objects and their payloads
+    /**
+     *  Condition objects (and the payloads bound to their opaque data blocks,
+     *  which do not fit into the internal buffer) are allocated with
+     *  ConditionsArena::allocate(). While an arena is installed for the
+     *  current thread with a ConditionsArena::Scope, the memory is cut from
+     *  large chunks owned by the arena. Otherwise it is taken from the heap.
+     *  Every allocation, also from the heap, is preceded by a header of
+     *  alignof(std::max_align_t) bytes (typically 16) identifying its chunk,
+     *  so that deallocate() can release either kind.
+     *
+     *  Every scope takes a chunk from the arena for the exclusive use of its
+     *  thread and returns it to the arena at destruction, so that the next
+     *  scope continues to fill it. Allocations only lock the arena when
+     *  the chunk of the scope is exhausted.
+     *
+     *  Releasing an object only decrements the reference count of its chunk.
+     *  A chunk is returned to the heap as a whole, once all objects allocated
+     *  from it are gone and the arena moved to another chunk (see reset()).
+     *  Hence objects may safely outlive the arena.
+     *  Note: a single long-lived object keeps its entire chunk alive. Derived
+     *  conditions registered to the IOV pools release their chunk only when
+     *  the pools are purged by the conditions cleanup. If few conditions
+     *  survive many IOVs, a smaller chunk size limits the memory pinned.
+     *
+     *  Allocation and deallocation are thread safe.
+     *
+     *  \version 1.0
+     *  \ingroup DD4HEP_CONDITIONS
+     */
+    class ConditionsArena  {
+    public:
+      /// Default chunk size
+      enum { DEFAULT_CHUNK_SIZE = 256*1024 };
+      /// Memory chunk. Opaque to clients
+      class Chunk;
+
+      /// Install an arena for allocations of the current thread
+      /**
+       *  The previously installed arena is restored at destruction.
+       *  A null arena selects heap allocation.
+       *  The scope owns a chunk of the arena: it may only be used by the
+       *  thread, which created it.
+       *
+       *  \version 1.0
+       *  \ingroup DD4HEP_CONDITIONS
+       */
+      class Scope  {
+        friend class ConditionsArena;
+        /// Previously installed scope
+        Scope*           m_previous;
+        /// Arena of this scope
+        ConditionsArena* m_arena;
+        /// Chunk taken from the arena for the allocations of this scope
+        Chunk*           m_chunk = 0;
+        /// Statistics: number of allocations served by this scope
+        std::size_t      m_numAllocations = 0;
+        /// Statistics: number of bytes served by this scope
+        std::size_t      m_numBytes = 0;
+        /// Allocate memory from the chunk of the scope. Locks the arena only to take a new chunk
+        void* _allocate(std::size_t len);
+      public:
+        /// Initializing constructor
+        Scope(ConditionsArena* arena);
+        /// Inhibit copy constructor
+        Scope(const Scope& copy) = delete;
+        /// Default destructor. Returns the chunk to the arena
+        ~Scope();
+        /// Inhibit assignment
+        Scope& operator=(const Scope& copy) = delete;
+      };
+
+    protected:
+      /// Protection of the chunk list
+      std::mutex  m_lock;
+      /// Chunks with free space, which are currently not used by any scope
+      std::vector<Chunk*> m_chunks;
+      /// Incremented by reset(): chunks taken before are not returned to the arena
+      std::size_t m_generation = 0;
+      /// Size of newly created chunks
+      std::size_t m_chunkSize;
+      /// Statistics: number of chunks created
+      std::size_t m_numChunks = 0;
+      /// Statistics: number of allocations served from chunks
+      std::size_t m_numAllocations = 0;
+      /// Statistics: number of bytes served from chunks
+      std::size_t m_numBytes = 0;
+
+      /// Take a chunk with at least len free bytes. The exhausted chunk of the scope is dropped.
+      Chunk* _take(Chunk* exhausted, std::size_t len);
+      /// Return the chunk of a scope to the arena and account its statistics
+      void _return(Scope& scope);
+
+    public:
+      /// Initializing constructor
+      ConditionsArena(std::size_t chunk_size = DEFAULT_CHUNK_SIZE);
+      /// Inhibit copy constructor
+      ConditionsArena(const ConditionsArena& copy) = delete;
+      /// Default destructor. Chunks still in use are released by their last object
+      ~ConditionsArena();
+      /// Inhibit assignment
+      ConditionsArena& operator=(const ConditionsArena& copy) = delete;
+
+      /// Drop all chunks: later allocations will not pin the memory of earlier ones
+      /** Chunks currently used by a scope are dropped when the scope ends. */
+      void reset();
+      /// Size of newly created chunks
+      std::size_t chunkSize()  const         {  return m_chunkSize;      }
+      /// Statistics: number of chunks created
+      std::size_t numChunks()  const         {  return m_numChunks;      }
+      /// Statistics: number of allocations served from chunks
+      std::size_t numAllocations()  const    {  return m_numAllocations; }
+      /// Statistics: number of bytes served from chunks
+      std::size_t numBytes()  const          {  return m_numBytes;       }
+
+      /// Arena installed for the current thread (null if none)
+      static ConditionsArena* current();
+      /// Allocate memory from the arena of the current thread or from the heap
+      static void* allocate(std::size_t len);
+      /// Release memory obtained by allocate()
+      static void deallocate(void* ptr);
+    };
+  }        /* End namespace detail                   */
+}          /* End namespace dd4hep                   */
+#endif // DD4HEP_DETAIL_CONDITIONSARENA_H
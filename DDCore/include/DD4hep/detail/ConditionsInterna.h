@@ -26,6 +26,7 @@
 #include "DD4hep/Conditions.h"
 #include "DD4hep/Grammar.h"
 #include "DD4hep/NamedObject.h"
+#include "DD4hep/detail/ConditionsArena.h"
 
 // C/C++ include files
 #include <map>
@@ -101,6 +102,14 @@ namespace dd4hep {
       ConditionObject& operator=(const ConditionObject&) = delete;
       /// No move assignment operator
       ConditionObject& operator=(ConditionObject&&) = delete;
+      /// Allocation from the conditions arena of the current thread (if any)
+      static void* operator new(std::size_t len)          {  return ConditionsArena::allocate(len); }
+      /// Placement new
+      static void* operator new(std::size_t, void* ptr)   {  return ptr;                            }
+      /// Deallocation matching operator new
+      static void operator delete(void* ptr)              {  ConditionsArena::deallocate(ptr);      }
+      /// Placement delete
+      static void operator delete(void*, void*)           {                                         }
       /// Increase reference counter (Used by persistency mechanism)
       ConditionObject* addRef()  {  ++refCount; return this;         }
       /// Release object (Used by persistency mechanism)
@@ -30,6 +30,9 @@
 // ROOT include files
 #include "TGeoMatrix.h"
 
+// C/C++ include files
+#include <vector>
+
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
 
@@ -84,6 +87,19 @@ namespace dd4hep {
       VolumeID               detMask = ~0x0ULL;
       /// Population flags
       int                    flags   = VolumeManager::NONE;
+
+      /// Flat lookup table: sorted placement identifiers (valid only if frozen)
+      std::vector<VolumeID>               frozenIDs;       //! Not ROOT persistent
+      /// Flat lookup table: contexts matching the entries in frozenIDs
+      std::vector<VolumeManagerContext*>  frozenContexts;  //! Not ROOT persistent
+      /// Jump table to the subdetector sections indexed by the value of the system field
+      std::vector<VolumeManagerObject*>   sysTable;        //! Not ROOT persistent
+      /// Mask of the system field used to index the jump table
+      VolumeID               sysTableMask   = 0;   //! Not ROOT persistent
+      /// Bit offset of the system field used to index the jump table
+      unsigned int           sysTableOffset = 0;   //! Not ROOT persistent
+      /// Flag indicating that the flat lookup table is valid
+      bool                   frozen  = false;       //! Not ROOT persistent
     public:
       /// Default constructor
       VolumeManagerObject() = default;
@@ -99,6 +115,10 @@ namespace dd4hep {
       VolumeManagerObject& operator=(const VolumeManagerObject& copy) = delete;
       /// Search the locally cached volumes for a matching ID
       VolumeManagerContext* search(const VolumeID& id) const;
+      /// Compile the placement map (and the one of all subdetectors) into flat lookup tables
+      void freeze();
+      /// Invalidate the flat lookup tables. Lookups fall back to the placement map
+      void thaw();
       /// Update callback when alignment has changed (called only for subdetectors....)
       void update(unsigned long tags, DetElement& det, void* param);
     };
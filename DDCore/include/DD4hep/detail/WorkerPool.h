@@ -0,0 +1,94 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+//==========================================================================
+#ifndef DD4HEP_DETAIL_WORKERPOOL_H
+#define DD4HEP_DETAIL_WORKERPOOL_H
+
+// C/C++ include files
+#include <condition_variable>
+#include <functional>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <deque>
+#include <mutex>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// DD4hep internal namespace declaration for utilities and implementation details
+  namespace detail {
+
+    /// Process wide pool of worker threads for the concurrent computation of conditions
+    /**
+     *  The threads are created on first demand and are kept alive until the
+     *  end of the process. They are shared by all clients, e.g. the derived
+     *  conditions handler and the alignments calculator.
+     *
+     *  run() executes the same work function on the calling thread and on up
+     *  to (num_threads-1) worker threads. The work function must distribute
+     *  the work itself (e.g. using a shared counter or queue) and must be able
+     *  to complete all work alone: helper invocations, which did not start by
+     *  the time the calling thread returned from its own invocation, are
+     *  dropped. Hence run() may safely be nested and called from any thread,
+     *  including the pool threads, without deadlocking.
+     *
+     *  \version 1.0
+     *  \ingroup DD4HEP_CONDITIONS
+     */
+    class WorkerPool  {
+    public:
+      /// Definition of the work function
+      typedef std::function<void()> work_t;
+      /// Invocation of one work function. Opaque to clients
+      class Job;
+
+    protected:
+      /// Protection of the job queue
+      std::mutex                         m_lock;
+      /// Signal new jobs to the worker threads
+      std::condition_variable            m_signal;
+      /// Signal the end of helper invocations to the calling threads
+      std::condition_variable            m_done;
+      /// Jobs waiting for helper threads
+      std::deque<std::shared_ptr<Job> >  m_jobs;
+      /// Worker threads
+      std::vector<std::thread>           m_threads;
+      /// Flag to stop the worker threads
+      bool                               m_stop = false;
+
+      /// Worker thread: execute helper invocations of the queued jobs
+      void worker();
+
+    public:
+      /// Default constructor
+      WorkerPool() = default;
+      /// Inhibit copy constructor
+      WorkerPool(const WorkerPool& copy) = delete;
+      /// Default destructor. Stops and joins the worker threads
+      ~WorkerPool();
+      /// Inhibit assignment
+      WorkerPool& operator=(const WorkerPool& copy) = delete;
+
+      /// Number of worker threads created so far
+      std::size_t size();
+      /// Execute the work function using up to num_threads threads. The calling thread participates.
+      /** Exceptions thrown by any invocation are rethrown to the caller
+       *  once all started invocations are finished.
+       */
+      void run(std::size_t num_threads, const work_t& work);
+
+      /// Access to the process wide instance
+      static WorkerPool& instance();
+    };
+  }        /* End namespace detail                   */
+}          /* End namespace dd4hep                   */
+#endif // DD4HEP_DETAIL_WORKERPOOL_H
@@ -90,6 +90,45 @@ namespace dd4hep {
     };
 
 
+    /// Helper class for bulk decoding and encoding of one BitFieldElement in tight loops.
+    /** The shifts, the mask and the value range are computed once from the field,
+     *  extraction and insertion are then branch-free and do not check the value range.
+     *  Use inRange() to validate the values to be inserted.
+     */
+    class BitFieldAccessor   {
+    public :
+      /// Initializing constructor
+      BitFieldAccessor( const BitFieldElement& field ) ;
+
+      /// Value of the field in the given 64 bit bitmap (sign extended for signed fields)
+      FieldID get( CellID bitfield ) const {
+        CellID top = bitfield << _left ;
+        FieldID s = FieldID( top ) >> _right ;   // arithmetic shift: sign extension
+        FieldID u = FieldID( top >> _right ) ;   // logical shift
+        return _isSigned ? s : u ;
+      }
+
+      /// Return the bitmap with the field set to the given value. No range check!
+      CellID set( CellID bitfield, FieldID value ) const {
+        return ( bitfield & ~_mask ) | ( ( CellID( value ) << _offset ) & _mask ) ;
+      }
+
+      /// Check if the value fits into the field
+      bool inRange( FieldID value ) const {
+        return ( value >= _minVal ) & ( value <= _maxVal ) ;
+      }
+
+    protected:
+      CellID   _mask     {};
+      FieldID  _minVal   {};
+      FieldID  _maxVal   {};
+      unsigned _offset   {};
+      unsigned _left     {};
+      unsigned _right    {};
+      bool     _isSigned {};
+    };
+
+
   
     /// Helper class for decoding and encoding a bit field of 64bits for convenient declaration
     /** and manipulation of sub fields of various widths.<br>
@@ -39,6 +39,11 @@ namespace dd4hep {
       virtual Vector3D position(const CellID& cellID) const;
       /// determine the cell ID based on the position
       virtual CellID cellID(const Vector3D& localPosition, const Vector3D& globalPosition, const VolumeID& volumeID) const;
+      /// determine the local positions of many cells at once
+      virtual void positions(const CellID* cellIDs, Vector3D* localPositions, std::size_t count) const;
+      /// determine the cell IDs of many positions at once
+      virtual void cellIDs(const Vector3D* localPositions, const Vector3D* globalPositions,
+                           const VolumeID* volumeIDs, CellID* cellIDs, std::size_t count) const;
       /// access the grid size in R
       double gridSizeR() const {
         return _gridSizeR;
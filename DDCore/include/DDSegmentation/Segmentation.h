@@ -84,6 +84,27 @@ namespace dd4hep {
       /// Determine the cell ID based on the position
       virtual CellID cellID(const Vector3D& localPosition, const Vector3D& globalPosition,
                             const VolumeID& volumeID) const = 0;
+      /** \brief Determine the local positions of many cells at once
+
+          The default implementation calls position() for every cell. Segmentations
+          overriding position() with a different algorithm must override this as well.
+          \param cellIDs         array of count cell IDs
+          \param localPositions  output array of count local positions
+          \param count           number of cells
+      */
+      virtual void positions(const CellID* cellIDs, Vector3D* localPositions, std::size_t count) const;
+      /** \brief Determine the cell IDs of many positions at once
+
+          The default implementation calls cellID() for every position. Segmentations
+          overriding cellID() with a different algorithm must override this as well.
+          \param localPositions  array of count local positions
+          \param globalPositions array of count global positions
+          \param volumeIDs       array of count volume IDs
+          \param cellIDs         output array of count cell IDs
+          \param count           number of positions
+      */
+      virtual void cellIDs(const Vector3D* localPositions, const Vector3D* globalPositions,
+                           const VolumeID* volumeIDs, CellID* cellIDs, std::size_t count) const;
       /// Determine the volume ID from the full cell ID by removing all local fields
       virtual VolumeID volumeID(const CellID& cellID) const;
       /// Calculates the neighbours of the given cell ID and adds them to the list of neighbours
@@ -0,0 +1,149 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+//==========================================================================
+
+#ifndef DDSEGMENTATION_STATICBITFIELDCODER_H
+#define DDSEGMENTATION_STATICBITFIELDCODER_H 1
+
+#include "DDSegmentation/BitFieldCoder.h"
+
+#include <limits>
+#include <string>
+#include <utility>
+#include <stdexcept>
+
+namespace dd4hep {
+
+  namespace DDSegmentation {
+
+    /// Compile-time specialised counterpart of BitFieldElement.
+    /** Offset, width and sign of the field are template arguments, hence all shifts
+     *  and masks are constants and decoding/encoding inlines to a few instructions.
+     *  The signed width follows the BitFieldCoder convention: negative for signed fields.
+     *
+     *  Unlike BitFieldElement::set() the range check of set() is exact, i.e. the value
+     *  1<<width is rejected for unsigned fields.
+     */
+    template <unsigned OFFSET, int SIGNED_WIDTH> class StaticBitFieldElement   {
+      static_assert( SIGNED_WIDTH != 0 && SIGNED_WIDTH >= -64 && SIGNED_WIDTH <= 64,
+                     "StaticBitFieldElement: invalid field width" ) ;
+      static_assert( OFFSET + unsigned( SIGNED_WIDTH < 0 ? -SIGNED_WIDTH : SIGNED_WIDTH ) <= 64,
+                     "StaticBitFieldElement: field exceeds 64 bits" ) ;
+    public :
+      /// The field's offset
+      static constexpr unsigned offset()   { return OFFSET ; }
+      /// The field's width
+      static constexpr unsigned width()    { return unsigned( SIGNED_WIDTH < 0 ? -SIGNED_WIDTH : SIGNED_WIDTH ) ; }
+      /// True if field is interpreted as signed
+      static constexpr bool     isSigned() { return SIGNED_WIDTH < 0 ; }
+      /// The field's mask
+      static constexpr CellID   mask()     {
+        return ( width() == 64 ? ~CellID(0) : ( CellID(1) << width() ) - 1 ) << OFFSET ;
+      }
+      /// Minimal value
+      static constexpr FieldID  minValue() {
+        return !isSigned() ? 0
+          : width() == 64 ? std::numeric_limits<FieldID>::min() : -( FieldID(1) << ( width() - 1 ) ) ;
+      }
+      /// Maximal value
+      static constexpr FieldID  maxValue() {
+        return width() >= 63 ? std::numeric_limits<FieldID>::max()
+          : isSigned() ? ( FieldID(1) << ( width() - 1 ) ) - 1 : ( FieldID(1) << width() ) - 1 ;
+      }
+
+      /// Field value given an external 64 bit bitmap
+      static constexpr FieldID value( CellID bitfield ) {
+        return isSigned()
+          ? FieldID( bitfield << ( 64 - OFFSET - width() ) ) >> ( 64 - width() )
+          : FieldID( ( bitfield & mask() ) >> OFFSET ) ;
+      }
+
+      /// Check if the value fits into the field
+      static constexpr bool inRange( FieldID val ) {
+        return val >= minValue() && val <= maxValue() ;
+      }
+
+      /// Return the bitmap with the field set to the given value. No range check!
+      static constexpr CellID encode( CellID bitfield, FieldID val ) {
+        return ( bitfield & ~mask() ) | ( ( CellID( val ) << OFFSET ) & mask() ) ;
+      }
+
+      /// Assign the given value to the bit field. Throws std::runtime_error if out of range
+      static void set( CellID& bitfield, FieldID val ) {
+        if( !inRange( val ) ) {
+          throw std::runtime_error( " StaticBitFieldElement: out of range : " + std::to_string( val )
+                                    + " for width " + std::to_string( width() ) ) ;
+        }
+        bitfield = encode( bitfield, val ) ;
+      }
+
+      /// Check if the runtime field has the same layout
+      static bool matches( const BitFieldElement& field ) {
+        return field.offset() == OFFSET && field.width() == width() && field.isSigned() == isSigned() ;
+      }
+    };
+
+
+    /// Compile-time specialised counterpart of BitFieldCoder for a fixed cell ID layout.
+    /** The fields are StaticBitFieldElement types, typically given names by deriving from them.
+     *  Such layouts are best generated from the <id> string of a readout with the plugin
+     *  DD4hep_BitFieldCoderGenerator, e.g. for "system:8,layer:-6":
+     *
+     *    namespace MyReadout {
+     *      struct system : StaticBitFieldElement<0,8>  {} ;
+     *      struct layer  : StaticBitFieldElement<8,-6> {} ;
+     *      struct Coder  : StaticBitFieldCoder<system,layer> {} ;
+     *    }
+     *    FieldID l = MyReadout::Coder::get<MyReadout::layer>( cellID ) ;
+     *
+     *  Use matches() once at initialization to verify that the compiled layout
+     *  agrees with the runtime description of the readout.
+     */
+    template <typename... FIELDS> class StaticBitFieldCoder   {
+    public :
+      /// Number of fields
+      static constexpr std::size_t size() { return sizeof...(FIELDS) ; }
+
+      /// The mask of all the bits used in the description
+      static constexpr CellID mask() {
+        const CellID masks[] = { CellID(0), FIELDS::mask()... } ;
+        CellID joined = 0 ;
+        for( CellID m : masks ) joined |= m ;
+        return joined ;
+      }
+
+      /// Value of the given field
+      template <typename FIELD> static constexpr FieldID get( CellID bitfield ) {
+        return FIELD::value( bitfield ) ;
+      }
+
+      /// Set the value of the given field. Throws std::runtime_error if out of range
+      template <typename FIELD> static void set( CellID& bitfield, FieldID val ) {
+        FIELD::set( bitfield, val ) ;
+      }
+
+      /// Check if the runtime coder has exactly the same fields in the same order
+      static bool matches( const BitFieldCoder& coder ) {
+        return coder.size() == size() && matches( coder, std::index_sequence_for<FIELDS...>() ) ;
+      }
+
+    protected:
+      /// Compare the fields one by one
+      template <std::size_t... IDX>
+      static bool matches( const BitFieldCoder& coder, std::index_sequence<IDX...> ) {
+        const bool result[] = { true, FIELDS::matches( coder[ unsigned(IDX) ] )... } ;
+        for( bool r : result ) if( !r ) return false ;
+        return true ;
+      }
+    };
+
+  } // end namespace
+} // end namespace
+#endif
@@ -0,0 +1,169 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+//==========================================================================
+
+// Framework include files
+#include <DD4hep/AlignmentTransforms.h>
+#include <DD4hep/MatrixHelpers.h>
+#include <DD4hep/Printout.h>
+
+using namespace dd4hep;
+using namespace dd4hep::align;
+
+constexpr std::size_t AlignmentTransforms::npos;
+
+/// Store matrix at position i
+void AlignmentTransforms::Matrices::set(std::size_t i, const TGeoMatrix& matrix)   {
+  const Double_t* r = matrix.GetRotationMatrix();
+  const Double_t* t = matrix.GetTranslation();
+  for(std::size_t k=0; k<9; ++k) m[k][i]   = r[k];
+  for(std::size_t k=0; k<3; ++k) m[9+k][i] = t[k];
+}
+
+/// Store matrix at position i from matrix at position j of another container
+void AlignmentTransforms::Matrices::set(std::size_t i, const Matrices& source, std::size_t j)   {
+  for(std::size_t k=0; k<12; ++k) m[k][i] = source.m[k][j];
+}
+
+/// Fill the matrix at position i into a TGeoHMatrix
+void AlignmentTransforms::Matrices::get(std::size_t i, TGeoHMatrix& matrix)  const   {
+  Double_t r[9], t[3];
+  for(std::size_t k=0; k<9; ++k) r[k] = m[k][i];
+  for(std::size_t k=0; k<3; ++k) t[k] = m[9+k][i];
+  matrix.SetRotation(r);
+  matrix.SetTranslation(t);
+}
+
+/// Transform a point with the matrix at position i
+Position AlignmentTransforms::Matrices::apply(std::size_t i, const Position& p)  const   {
+  return Position(m[0][i]*p.X() + m[1][i]*p.Y() + m[2][i]*p.Z() + m[9][i],
+                  m[3][i]*p.X() + m[4][i]*p.Y() + m[5][i]*p.Z() + m[10][i],
+                  m[6][i]*p.X() + m[7][i]*p.Y() + m[8][i]*p.Z() + m[11][i]);
+}
+
+/// Transform a point with the inverse of the matrix at position i (rotation must be orthogonal)
+Position AlignmentTransforms::Matrices::applyInverse(std::size_t i, const Position& p)  const   {
+  double x = p.X()-m[9][i], y = p.Y()-m[10][i], z = p.Z()-m[11][i];
+  return Position(m[0][i]*x + m[3][i]*y + m[6][i]*z,
+                  m[1][i]*x + m[4][i]*y + m[7][i]*z,
+                  m[2][i]*x + m[5][i]*y + m[8][i]*z);
+}
+
+/// Remove all transformations
+void AlignmentTransforms::clear()   {
+  m_slots.clear();
+  m_detectors.clear();
+  m_detectorTrafo.clear();
+  m_worldTrafo.clear();
+}
+
+/// Reserve space for n detector elements
+void AlignmentTransforms::reserve(std::size_t n)   {
+  m_detectors.reserve(n);
+  m_detectorTrafo.reserve(n);
+  m_worldTrafo.reserve(n);
+}
+
+/// Add a detector element and return its slot. Existing entries are not duplicated.
+std::size_t AlignmentTransforms::add(DetElement detector)   {
+  if ( !detector.isValid() )  {
+    except("AlignmentTransforms","Failed to add entry: invalid detector handle!");
+  }
+  auto ret = m_slots.emplace(detector.key(), m_detectors.size());
+  if ( ret.second )   {
+    std::size_t n = m_detectors.size()+1;
+    m_detectors.emplace_back(detector);
+    m_detectorTrafo.resize(n);
+    m_worldTrafo.resize(n);
+  }
+  return ret.first->second;
+}
+
+/// Access the slot of a detector element. Returns npos if not present.
+std::size_t AlignmentTransforms::slot(DetElement detector)  const   {
+  auto i = m_slots.find(detector.key());
+  return i == m_slots.end() ? npos : i->second;
+}
+
+/// Access the slot of a detector element. Throws exception if not present.
+std::size_t AlignmentTransforms::_slot(DetElement detector)  const   {
+  auto i = m_slots.find(detector.key());
+  if ( i == m_slots.end() )  {
+    except("AlignmentTransforms","No transformation present for detector element %s",
+           detector.isValid() ? detector.path().c_str() : "[Invalid handle]");
+  }
+  return i->second;
+}
+
+/// Chain transformations: world[i] = world[i] * detector[i] for all slots in [begin,end)
+void AlignmentTransforms::chain(std::size_t begin, std::size_t end)   {
+  double*       w[12];
+  const double* d[12];
+  for(std::size_t k=0; k<12; ++k)  {
+    w[k] = m_worldTrafo.m[k].data();
+    d[k] = m_detectorTrafo.m[k].data();
+  }
+  for(std::size_t i=begin; i<end; ++i)   {
+    const double w0 = w[0][i], w1 = w[1][i], w2 = w[2][i];
+    const double w3 = w[3][i], w4 = w[4][i], w5 = w[5][i];
+    const double w6 = w[6][i], w7 = w[7][i], w8 = w[8][i];
+    w[9][i]  += w0*d[9][i] + w1*d[10][i] + w2*d[11][i];
+    w[10][i] += w3*d[9][i] + w4*d[10][i] + w5*d[11][i];
+    w[11][i] += w6*d[9][i] + w7*d[10][i] + w8*d[11][i];
+    w[0][i]   = w0*d[0][i] + w1*d[3][i] + w2*d[6][i];
+    w[1][i]   = w0*d[1][i] + w1*d[4][i] + w2*d[7][i];
+    w[2][i]   = w0*d[2][i] + w1*d[5][i] + w2*d[8][i];
+    w[3][i]   = w3*d[0][i] + w4*d[3][i] + w5*d[6][i];
+    w[4][i]   = w3*d[1][i] + w4*d[4][i] + w5*d[7][i];
+    w[5][i]   = w3*d[2][i] + w4*d[5][i] + w5*d[8][i];
+    w[6][i]   = w6*d[0][i] + w7*d[3][i] + w8*d[6][i];
+    w[7][i]   = w6*d[1][i] + w7*d[4][i] + w8*d[7][i];
+    w[8][i]   = w6*d[2][i] + w7*d[5][i] + w8*d[8][i];
+  }
+}
+
+/// Create the transformation to the world of a detector element
+TGeoHMatrix AlignmentTransforms::worldTransformation(DetElement detector)  const   {
+  TGeoHMatrix matrix;
+  m_worldTrafo.get(_slot(detector), matrix);
+  return matrix;
+}
+
+/// Create the transformation to the parent detector element
+TGeoHMatrix AlignmentTransforms::detectorTransformation(DetElement detector)  const   {
+  TGeoHMatrix matrix;
+  m_detectorTrafo.get(_slot(detector), matrix);
+  return matrix;
+}
+
+/// Create the transformation from the local coordinates to the world system
+Transform3D AlignmentTransforms::localToWorld(DetElement detector)  const   {
+  TGeoHMatrix matrix;
+  m_worldTrafo.get(_slot(detector), matrix);
+  return detail::matrix::_transform(&matrix);
+}
+
+/// Transformation from local coordinates of the detector element to the world system
+Position AlignmentTransforms::localToWorld(DetElement detector, const Position& local)  const   {
+  return m_worldTrafo.apply(_slot(detector), local);
+}
+
+/// Transformation from world coordinates to the local coordinates of the detector element
+Position AlignmentTransforms::worldToLocal(DetElement detector, const Position& global)  const   {
+  return m_worldTrafo.applyInverse(_slot(detector), global);
+}
+
+/// Transformation from local coordinates of the detector element to the parent detector
+Position AlignmentTransforms::localToDetector(DetElement detector, const Position& local)  const   {
+  return m_detectorTrafo.apply(_slot(detector), local);
+}
+
+#include <DD4hep/GrammarUnparsed.h>
+static auto s_registry = GrammarRegistry::pre_note<AlignmentTransforms>(1);
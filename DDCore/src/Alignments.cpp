@@ -29,6 +29,10 @@ const std::string dd4hep::align::Keys::alignmentName("alignment");
 const dd4hep::Condition::itemkey_type dd4hep::align::Keys::alignmentKey =
   dd4hep::ConditionKey::itemCode("alignment");
 
+const std::string dd4hep::align::Keys::transformsName("alignment_transforms");
+const dd4hep::Condition::itemkey_type dd4hep::align::Keys::transformsKey =
+  dd4hep::ConditionKey::itemCode("alignment_transforms");
+
 /// Default constructor
 Alignment::Processor::Processor() {
 }
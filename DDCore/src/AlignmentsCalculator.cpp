@@ -22,10 +22,21 @@
 #include <DD4hep/AlignmentsProcessor.h>
 #include <DD4hep/AlignmentsCalculator.h>
 #include <DD4hep/detail/AlignmentsInterna.h>
+#include <DD4hep/detail/WorkerPool.h>
+
+// C/C++ include files
+#include <set>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <algorithm>
+#include <exception>
+#include <cstring>
 
 using namespace dd4hep;
 using namespace dd4hep::align;
 using Result = AlignmentsCalculator::Result;
+using IncrementalContext = AlignmentsCalculator::IncrementalContext;
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
@@ -57,6 +68,10 @@ namespace dd4hep {
         ~Calculator() = default;
         /// Compute all alignment conditions of the lower levels
         Result compute(Context& context, Entry& entry) const;
+        /// Take the alignment condition from the result of a previous computation
+        Result reuse(Context& context, Entry& entry, const IncrementalContext::Entry& cached) const;
+        /// Compute all entries of the context computing independent sub-trees concurrently
+        Result compute(Context& context, std::size_t num_threads) const;
         /// Resolve child dependencies for a given context
         void resolve(Context& context, DetElement child) const;
       };
@@ -97,6 +112,19 @@ namespace dd4hep {
           except("AlignContext","Failed to add entry: invalid detector handle!");
         }
       };
+
+      /// Check if two deltas result in the same transformation
+      bool same_delta(const Delta& a, const Delta& b)   {
+        return a.flags == b.flags
+          && a.translation == b.translation
+          && a.pivot       == b.pivot
+          && a.rotation    == b.rotation;
+      }
+      /// Bitwise comparison of two transformation matrices
+      bool same_matrix(const TGeoHMatrix& a, const TGeoHMatrix& b)   {
+        return 0 == ::memcmp(a.GetRotationMatrix(), b.GetRotationMatrix(), 9*sizeof(Double_t))
+          &&   0 == ::memcmp(a.GetTranslation(),    b.GetTranslation(),    3*sizeof(Double_t));
+      }
     }
   }       /* End namespace align */
 }         /* End namespace dd4hep     */
@@ -189,6 +217,150 @@ Result Calculator::compute(Context& context, Entry& e)   const  {
   return result;
 }
 
+/// Compute all entries of the context computing independent sub-trees concurrently
+Result Calculator::compute(Context& context, std::size_t num_threads)   const  {
+  static constexpr std::size_t npos = ~std::size_t(0);
+  /// Independent sub-tree: entries are ordered parents first
+  struct Tree  {
+    std::vector<std::size_t> items;
+    TGeoHMatrix              parent_transform;
+  };
+  std::size_t                        num_entries = context.entries.size();
+  std::vector<std::size_t>           parent(num_entries, npos);
+  std::vector<const TGeoHMatrix*>    nominal(num_entries, nullptr);
+  std::map<DetElement::Object*,std::size_t> index, tree_of;
+  std::vector<Tree>                  trees;
+  Result                             result;
+
+  // Sequential preparation: everything touching the conditions map or
+  // lazily initialized detector element data is done here.
+  for( const auto& d : context.detectors )  {      // Path ordered: parents first
+    std::size_t idx = d.second;
+    Entry&      e   = context.entries[idx];
+    DetElement  det = e.det;
+    DetElement  par = det.parent();
+    auto        ip  = par.isValid() ? index.find(par.ptr()) : index.end();
+    index.emplace(e.det, idx);
+    nominal[idx] = &det.nominal().detectorTransformation();
+    if ( ip != index.end() )   {
+      parent[idx] = ip->second;
+      std::size_t t = tree_of[par.ptr()];
+      tree_of.emplace(e.det, t);
+      trees[t].items.emplace_back(idx);
+    }
+    else   {
+      Tree tree;
+      AlignmentCondition parent_cond = context.mapping.get(par, Keys::alignmentKey);
+      if ( parent_cond.isValid() )
+        tree.parent_transform = parent_cond.data().worldTrafo;
+      else if ( par.isValid() )
+        tree.parent_transform = par.nominal().worldTransformation();
+      tree.items.emplace_back(idx);
+      tree_of.emplace(e.det, trees.size());
+      trees.emplace_back(std::move(tree));
+    }
+    AlignmentCondition c = context.mapping.get(det, Keys::alignmentKey);
+    if ( !c.isValid() )  {
+      c = AlignmentCondition(det.path()+"#alignment");
+      c->flags |= Condition::ALIGNMENT_DERIVED;
+      c->hash = ConditionKey(e.det,Keys::alignmentKey).hash;
+      e.created = 1;
+    }
+    e.cond = c.ptr();
+  }
+  // Largest sub-trees first for better load balancing
+  std::vector<std::size_t> order(trees.size());
+  for( std::size_t i=0; i<order.size(); ++i ) order[i] = i;
+  std::sort(order.begin(), order.end(), [&trees](std::size_t a, std::size_t b)
+            { return trees[a].items.size() > trees[b].items.size(); });
+
+  std::atomic<std::size_t> next(0);
+  std::exception_ptr       error;
+  std::mutex               lock;
+  auto work = [&]()  {
+    Result res;
+    try  {
+      for( std::size_t t = next++; t < order.size(); t = next++ )  {
+        const Tree& tree = trees[order[t]];
+        for( std::size_t idx : tree.items )   {
+          Entry&         e     = context.entries[idx];
+          AlignmentData& align = AlignmentCondition(e.cond).data();
+          const Delta*   delta = e.delta ? e.delta : &identity_delta;
+          const TGeoHMatrix& parent_transform = parent[idx] == npos
+            ? tree.parent_transform
+            : AlignmentCondition(context.entries[parent[idx]].cond).data().worldTrafo;
+          TGeoHMatrix transform_for_delta;
+          align.delta = *delta;
+          delta->computeMatrix(transform_for_delta);
+          align.detectorTrafo = (*nominal[idx]) * transform_for_delta;
+          align.worldTrafo    = parent_transform * align.detectorTrafo;
+          align.trToWorld     = detail::matrix::_transform(&align.worldTrafo);
+          e.valid = 1;
+          ++res.computed;
+          res.multiply += 5;
+        }
+      }
+    }
+    catch(...)  {
+      std::lock_guard<std::mutex> guard(lock);
+      if ( !error ) error = std::current_exception();
+      next = order.size();
+    }
+    std::lock_guard<std::mutex> guard(lock);
+    result += res;
+  };
+  num_threads = std::min(num_threads, trees.size());
+  detail::WorkerPool::instance().run(num_threads, work);
+  if ( error )  {
+    // Drop the objects, which were not yet handed over to the conditions map
+    for( auto& e : context.entries )
+      if ( e.created ) e.cond->release();
+    std::rethrow_exception(error);
+  }
+  // Sequential merge of the new conditions into the conditions map
+  for( const auto& d : context.detectors )  {
+    Entry& e = context.entries[d.second];
+    if ( e.created )
+      context.mapping.insert(e.det, Keys::alignmentKey, AlignmentCondition(e.cond));
+  }
+  printout(DEBUG,"ComputeAlignment","Computed %ld alignments in %ld independent sub-trees using %ld threads.",
+           long(result.computed), long(trees.size()), long(std::max(num_threads,std::size_t(1))));
+  return result;
+}
+
+/// Take the alignment condition from the result of a previous computation
+Result Calculator::reuse(Context& context, Entry& e, const IncrementalContext::Entry& cached)   const  {
+  Result result;
+  DetElement det = e.det;
+
+  if ( e.valid == 1 )  {
+    return result;
+  }
+  AlignmentCondition c = context.mapping.get(det, Keys::alignmentKey);
+  e.valid = 1;
+  ++result.reused;
+  // The map still contains the unchanged condition of the previous computation
+  if ( c.isValid() && c.ptr() == cached.condition && same_matrix(c.data().worldTrafo, cached.worldTrafo) )  {
+    e.cond = c.ptr();
+    return result;
+  }
+  AlignmentCondition cond = c.isValid() ? c : AlignmentCondition(det.path()+"#alignment");
+  AlignmentData&     align = cond.data();
+  e.cond              = cond.ptr();
+  align.delta         = cached.delta;
+  align.detectorTrafo = cached.detectorTrafo;
+  align.worldTrafo    = cached.worldTrafo;
+  align.trToWorld     = cached.trToWorld;
+  if ( !c.isValid() )  {
+    e.created = 1;
+    cond->flags |= Condition::ALIGNMENT_DERIVED;
+    cond->hash = ConditionKey(e.det,Keys::alignmentKey).hash;
+    context.mapping.insert(e.det, Keys::alignmentKey, cond);
+  }
+  printout(DEBUG,"ComputeAlignment","================ REUSE %s (unchanged delta)",det.path().c_str());
+  return result;
+}
+
 /// Resolve child dependencies for a given context
 void Calculator::resolve(Context& context, DetElement detector) const   {
   auto children = detector.children();
@@ -209,6 +381,9 @@ Result AlignmentsCalculator::compute(const OrderedDeltas& deltas,
     context.insert(i.first, i.second);
   for( const auto& i : deltas )
     obj.resolve(context,i.first);
+  std::size_t num_threads = m_numThreads < 0 ? std::thread::hardware_concurrency() : m_numThreads;
+  if ( num_threads > 1 && context.entries.size() > 1 )
+    return obj.compute(context, num_threads);
   for( auto& i : context.entries )
     result += obj.compute(context, i);
   return result;
@@ -234,6 +409,145 @@ Result AlignmentsCalculator::compute(const std::map<DetElement, Delta>& deltas,
   return compute(ordered_deltas, alignments);
 }
 
+/// Incremental computation: only sub-trees with changed deltas are recomputed
+Result AlignmentsCalculator::compute(const OrderedDeltas& deltas,
+                                     ConditionsMap& alignments,
+                                     IncrementalContext& history)  const
+{
+  Result  result;
+  Calculator obj;
+  Calculator::Context context(alignments);
+  IncrementalContext::Entries previous;
+  std::set<unsigned int> changed, present;
+
+  previous.swap(history.entries);
+  for( const auto& i : deltas )   {
+    unsigned int key = i.first.key();
+    auto p = previous.find(key);
+    context.insert(i.first, i.second);
+    present.insert(key);
+    if ( p == previous.end() || !p->second.haveDelta || !same_delta(p->second.delta, *i.second) )
+      changed.insert(key);
+  }
+  // Deltas, which disappeared since the last call, invalidate the sub-tree as well
+  for( const auto& p : previous )   {
+    if ( p.second.haveDelta && present.find(p.first) == present.end() )
+      changed.insert(p.first);
+  }
+  for( const auto& i : deltas )
+    obj.resolve(context,i.first);
+
+  for( auto& e : context.entries )   {
+    DetElement det(e.det);
+    auto p = previous.find(det.key());
+    bool dirty = p == previous.end();
+    for( DetElement d = det; !dirty && d.isValid(); d = d.parent() )
+      dirty = changed.find(d.key()) != changed.end();
+    if ( dirty )   {
+      result += obj.compute(context, e);
+      if ( e.cond )   {
+        const AlignmentData& align = AlignmentCondition(e.cond).data();
+        IncrementalContext::Entry& cached = history.entries[det.key()];
+        cached.delta         = align.delta;
+        cached.detectorTrafo = align.detectorTrafo;
+        cached.worldTrafo    = align.worldTrafo;
+        cached.trToWorld     = align.trToWorld;
+        cached.condition     = e.cond;
+        cached.haveDelta     = e.delta != 0;
+      }
+      continue;
+    }
+    result += obj.reuse(context, e, p->second);
+    p->second.condition = e.cond;
+    history.entries.emplace(p->first, std::move(p->second));
+  }
+  printout(DEBUG,"AlignmentsCalculator","Incremental update: %ld deltas, %ld changed, %ld computed, %ld reused.",
+           long(deltas.size()), long(changed.size()), long(result.computed), long(result.reused));
+  return result;
+}
+
+/// Incremental computation: only sub-trees with changed deltas are recomputed
+Result AlignmentsCalculator::compute(const std::map<DetElement, Delta>& deltas,
+                                     ConditionsMap& alignments,
+                                     IncrementalContext& history)  const
+{
+  OrderedDeltas ordered_deltas;
+  for( const auto& i : deltas )
+    ordered_deltas.emplace(i.first, &i.second);
+  return compute(ordered_deltas, alignments, history);
+}
+
+/// Compute the aligned transformations into the compact structure-of-arrays storage
+Result AlignmentsCalculator::compute(const OrderedDeltas& deltas,
+                                     AlignmentTransforms& transforms)  const
+{
+  typedef std::pair<DetElement,const Delta*> item_t;
+  std::vector<std::vector<item_t> > levels;
+  OrderedDeltas all(deltas);
+  Result result;
+
+  // Add all children of the aligned elements with identity deltas
+  struct Children  {
+    OrderedDeltas& entries;
+    void operator()(DetElement de)  const  {
+      for( const auto& c : de.children() )  {
+        entries.emplace(c.second, nullptr);
+        (*this)(c.second);
+      }
+    }
+  } add_children { all };
+  for( const auto& i : deltas )
+    add_children(i.first);
+
+  // Group by hierarchy level: elements of the same level do not depend on each other
+  for( const auto& i : all )   {
+    std::size_t lvl = std::max(i.first.level(), 0);
+    if ( levels.size() <= lvl ) levels.resize(lvl+1);
+    levels[lvl].emplace_back(i);
+  }
+  transforms.clear();
+  transforms.reserve(all.size());
+
+  AlignmentTransforms::Matrices& world = transforms.worldMatrices();
+  AlignmentTransforms::Matrices& local = transforms.detectorMatrices();
+  for( const auto& level : levels )   {
+    std::size_t begin = transforms.size();
+    for( const auto& i : level )   {
+      DetElement  det    = i.first;
+      DetElement  parent = det.parent();
+      std::size_t slot   = transforms.add(det);
+      TGeoHMatrix transform_for_delta;
+      (i.second ? i.second : &identity_delta)->computeMatrix(transform_for_delta);
+      local.set(slot, det.nominal().detectorTransformation() * transform_for_delta);
+      std::size_t parent_slot = parent.isValid() ? transforms.slot(parent) : AlignmentTransforms::npos;
+      if ( parent_slot != AlignmentTransforms::npos )
+        world.set(slot, world, parent_slot);
+      else if ( parent.isValid() )
+        world.set(slot, parent.nominal().worldTransformation());
+      else  // The tranformation from the "world" to its parent is non-existing i.e. unity
+        world.set(slot, TGeoHMatrix());
+      result.multiply += 3;
+    }
+    // Now chain all transformations of this level in one go
+    transforms.chain(begin, transforms.size());
+    result.computed += transforms.size()-begin;
+  }
+  return result;
+}
+
+/// Access the compact transformation container of a conditions map (e.g. a slice)
+AlignmentTransforms& AlignmentsCalculator::transforms(ConditionsMap& alignments, DetElement top)   {
+  Condition c = alignments.get(top, Keys::transformsKey);
+  if ( !c.isValid() )   {
+    c = Condition(top.path()+"#"+Keys::transformsName, Keys::transformsName);
+    c.bind<AlignmentTransforms>();
+    c->flags |= Condition::DERIVED;
+    c->hash   = ConditionKey(top, Keys::transformsKey).hash;
+    alignments.insert(top, Keys::transformsKey, c);
+  }
+  return c.get<AlignmentTransforms>();
+}
+
 /// Compute all alignment conditions of the internal dependency list
 Result AlignmentsCalculator::compute(const std::map<DetElement, const Delta*>& deltas,
                                      ConditionsMap& alignments)  const
@@ -0,0 +1,160 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+//==========================================================================
+
+// Framework include files
+#include <DD4hep/detail/ConditionsArena.h>
+
+// C/C++ include files
+#include <atomic>
+#include <new>
+
+using namespace dd4hep::detail;
+
+/// Memory chunk: header followed by the allocation area
+class alignas(std::max_align_t) ConditionsArena::Chunk  {
+public:
+  /// References: one per living allocation plus one while owned by the arena or a scope
+  std::atomic<long> refCount {1};
+  /// Size of the allocation area
+  std::size_t       size = 0;
+  /// Used bytes of the allocation area. Only accessed by the owning scope or under the arena lock
+  std::size_t       used = 0;
+  /// Arena generation at creation
+  std::size_t       generation = 0;
+
+  /// Start of the allocation area
+  unsigned char* area()   {  return reinterpret_cast<unsigned char*>(this+1);  }
+  /// Drop one reference. The last one frees the chunk.
+  void release()   {
+    if ( --refCount == 0 )   {
+      this->~Chunk();
+      ::operator delete(this);
+    }
+  }
+};
+
+namespace {
+  /// Header preceding every allocation: the owning chunk or null for heap memory
+  struct alignas(std::max_align_t) Header  {
+    ConditionsArena::Chunk* chunk;
+  };
+  /// Round up to preserve the alignment of subsequent allocations
+  inline std::size_t aligned(std::size_t len)   {
+    const std::size_t a = alignof(std::max_align_t);
+    return (len + a - 1) & ~(a - 1);
+  }
+  /// Scope installed for the current thread
+  thread_local ConditionsArena::Scope* s_current = nullptr;
+}
+
+/// Initializing constructor
+ConditionsArena::Scope::Scope(ConditionsArena* arena) : m_previous(s_current), m_arena(arena)  {
+  s_current = this;
+}
+
+/// Default destructor. Returns the chunk to the arena
+ConditionsArena::Scope::~Scope()   {
+  if ( m_arena ) m_arena->_return(*this);
+  s_current = m_previous;
+}
+
+/// Allocate memory from the chunk of the scope. Locks the arena only to take a new chunk
+void* ConditionsArena::Scope::_allocate(std::size_t len)   {
+  std::size_t need = sizeof(Header) + aligned(len);
+  if ( !m_chunk || m_chunk->used + need > m_chunk->size )
+    m_chunk = m_arena->_take(m_chunk, need);
+  Header* hdr = reinterpret_cast<Header*>(m_chunk->area() + m_chunk->used);
+  hdr->chunk = m_chunk;
+  ++m_chunk->refCount;
+  m_chunk->used += need;
+  ++m_numAllocations;
+  m_numBytes += need;
+  return hdr+1;
+}
+
+/// Initializing constructor
+ConditionsArena::ConditionsArena(std::size_t chunk_size)
+  : m_chunkSize(aligned(chunk_size))
+{
+}
+
+/// Default destructor. Chunks still in use are released by their last object
+ConditionsArena::~ConditionsArena()   {
+  reset();
+}
+
+/// Drop all chunks: later allocations will not pin the memory of earlier ones
+void ConditionsArena::reset()   {
+  std::lock_guard<std::mutex> lock(m_lock);
+  for( Chunk* c : m_chunks ) c->release();
+  m_chunks.clear();
+  ++m_generation;
+}
+
+/// Take a chunk with at least len free bytes. The exhausted chunk of the scope is dropped.
+ConditionsArena::Chunk* ConditionsArena::_take(Chunk* exhausted, std::size_t len)   {
+  std::lock_guard<std::mutex> lock(m_lock);
+  if ( exhausted ) exhausted->release();
+  while( !m_chunks.empty() )   {
+    Chunk* c = m_chunks.back();
+    m_chunks.pop_back();
+    if ( c->used + len <= c->size ) return c;
+    c->release();
+  }
+  void*  mem   = ::operator new(sizeof(Chunk) + m_chunkSize);
+  Chunk* chunk = new(mem) Chunk();
+  chunk->size       = m_chunkSize;
+  chunk->generation = m_generation;
+  ++m_numChunks;
+  return chunk;
+}
+
+/// Return the chunk of a scope to the arena and account its statistics
+void ConditionsArena::_return(Scope& scope)   {
+  if ( scope.m_chunk || scope.m_numAllocations )   {
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_numAllocations += scope.m_numAllocations;
+    m_numBytes       += scope.m_numBytes;
+    if ( scope.m_chunk && scope.m_chunk->generation == m_generation )
+      m_chunks.emplace_back(scope.m_chunk);
+    else if ( scope.m_chunk )
+      scope.m_chunk->release();
+  }
+  scope.m_chunk = 0;
+  scope.m_numAllocations = scope.m_numBytes = 0;
+}
+
+/// Arena installed for the current thread (null if none)
+ConditionsArena* ConditionsArena::current()   {
+  return s_current ? s_current->m_arena : nullptr;
+}
+
+/// Allocate memory from the arena of the current thread or from the heap
+void* ConditionsArena::allocate(std::size_t len)   {
+  Scope* scope = s_current;
+  // Large objects would waste most of a chunk: take them from the heap
+  if ( scope && scope->m_arena && sizeof(Header) + aligned(len) <= scope->m_arena->m_chunkSize/4 )
+    return scope->_allocate(len);
+  Header* hdr = static_cast<Header*>(::operator new(sizeof(Header) + len));
+  hdr->chunk = 0;
+  return hdr+1;
+}
+
+/// Release memory obtained by allocate()
+void ConditionsArena::deallocate(void* ptr)   {
+  if ( ptr )   {
+    Header* hdr = static_cast<Header*>(ptr) - 1;
+    if ( hdr->chunk )
+      hdr->chunk->release();
+    else
+      ::operator delete(hdr);
+  }
+}
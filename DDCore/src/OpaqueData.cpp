@@ -16,6 +16,7 @@
 #include <DD4hep/Primitives.h>
 #include <DD4hep/OpaqueData.h>
 #include <DD4hep/InstanceCount.h>
+#include <DD4hep/detail/ConditionsArena.h>
 
 // C/C++ header files
 #include <cstring>
@@ -79,7 +80,7 @@ OpaqueDataBlock::OpaqueDataBlock(const OpaqueDataBlock& c)
 OpaqueDataBlock::~OpaqueDataBlock()   {
   if ( pointer && (type&EXTERN_DATA) != EXTERN_DATA )  {
     grammar->destruct(pointer);
-    if ( (type&ALLOC_DATA) == ALLOC_DATA ) ::operator delete(pointer);
+    if ( (type&ALLOC_DATA) == ALLOC_DATA ) detail::ConditionsArena::deallocate(pointer);
   }
   pointer = 0;
   grammar = 0;
@@ -92,7 +93,7 @@ OpaqueDataBlock& OpaqueDataBlock::operator=(const OpaqueDataBlock& c)   {
     if ( grammar == c.grammar )   {
       if ( pointer )  {
         if ( grammar ) grammar->destruct(pointer);
-        if ( (type&ALLOC_DATA) == ALLOC_DATA ) ::operator delete(pointer);
+        if ( (type&ALLOC_DATA) == ALLOC_DATA ) detail::ConditionsArena::deallocate(pointer);
       }
       pointer = 0;
       grammar = 0;
@@ -129,7 +130,7 @@ void* OpaqueDataBlock::bind(const BasicGrammar* g)   {
     size_t len = g->sizeOf();
     grammar  = g;
     (len > sizeof(data))
-      ? (pointer=::operator new(len),type=ALLOC_DATA)
+      ? (pointer=detail::ConditionsArena::allocate(len),type=ALLOC_DATA)
       : (pointer=data,type=PLAIN_DATA);
     return pointer;
   }
@@ -167,7 +168,7 @@ void* OpaqueDataBlock::bind(void* ptr, size_t size, const BasicGrammar* g)   {
     else if ( len <= sizeof(data) )
       pointer=data, type=PLAIN_DATA;
     else 
-      pointer=::operator new(len),type=ALLOC_DATA;
+      pointer=detail::ConditionsArena::allocate(len),type=ALLOC_DATA;
     return pointer;
   }
   else if ( grammar == g )  {
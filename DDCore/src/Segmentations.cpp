@@ -70,6 +70,14 @@ Position Segmentation::position(const CellID& cell) const {
   return Position(access()->segmentation->position(cell));
 }
 
+/// determine the local positions of many cells at once
+void Segmentation::positions(const CellID* cells, Position* localPositions, std::size_t count) const {
+  std::vector<DDSegmentation::Vector3D> pos(count);
+  access()->segmentation->positions(cells, pos.data(), count);
+  for(std::size_t i = 0; i < count; ++i)
+    localPositions[i] = Position(pos[i].X, pos[i].Y, pos[i].Z);
+}
+
 /// determine the cell ID based on the local position
 CellID Segmentation::cellID(const Position& localPosition, const Position& globalPosition, const CellID & volID) const {
   return access()->segmentation->cellID(localPosition, globalPosition, volID);
@@ -23,6 +23,7 @@
 // C/C++ includes
 #include <set>
 #include <cmath>
+#include <algorithm>
 #include <sstream>
 #include <iomanip>
 
@@ -405,6 +406,9 @@ VolumeManager::VolumeManager(const Detector& description, const std::string& nam
     obj_ptr->flags = flags;
     p.populate(elt);
     node_count = p.numNodes();
+    if ( (flags & FROZEN) == FROZEN )  {
+      obj_ptr->freeze();
+    }
   }
   printout(INFO, "VolumeManager", " - populating volume ids - done. %ld nodes.",node_count);
 }
@@ -451,6 +455,10 @@ VolumeManager VolumeManager::addSubdetector(DetElement det, Readout ro) {
                                  "valid placement VolIDs are allowed. [Invalid DetElement:" + det_name + "]");
       }
 
+      if ( o.frozen )  {
+        except("VolumeManager","addSubdetector: Cannot add subdetector %s to a frozen manager.",
+               det_name.c_str());
+      }
       i = o.subdetectors.emplace(det, VolumeManager(det,ro)).first;
       const auto& id = (*vit);
       VolumeManager mgr = (*i).second;
@@ -525,6 +533,10 @@ bool VolumeManager::adoptPlacement(VolumeID sys_id, VolumeManagerContext* contex
   }
 
   if ( i == o.volumes.end()) {
+    if ( o.frozen )  {
+      except("VolumeManager","adoptPlacement: Cannot register volume %016llX with the frozen manager of %s.",
+             (unsigned long long)vid, o.detector.name());
+    }
     o.volumes[vid] = context;
     o.detMask |= mask;
     err << "Inserted new volume:" << std::setw(6) << std::left << o.volumes.size()
@@ -618,6 +630,12 @@ VolumeManagerContext* VolumeManager::lookupContext(VolumeID volume_id) const {
       return c;
     /// Second: look in the subdetector volume cache if the entry is found.
     if (!one_tree) {
+      /// If frozen, dispatch directly to the subdetector section using the system field
+      if ( !o.sysTable.empty() )  {
+        const Object* mo = o.sysTable[(id&o.sysTableMask) >> o.sysTableOffset];
+        if ( mo && (c = mo->search(id)) != 0 )
+          return c;
+      }
       for (const auto& j : o.subdetectors )  {
         if ((c = j.second._data().search(id)) != 0)
           return c;
@@ -629,6 +647,28 @@ VolumeManagerContext* VolumeManager::lookupContext(VolumeID volume_id) const {
   return 0;
 }
 
+/// Compile the lookup containers into flat tables for fast read-only access
+void VolumeManager::freeze()   {
+  if ( isValid() )  {
+    Object& o = _data();
+    VolumeManager top(o.top);
+    if ( top.isValid() && top.ptr() != ptr() )  {
+      top.freeze();
+      return;
+    }
+    o.freeze();
+    printout(INFO, "VolumeManager", "+++ Froze volume lookup tables of %s [%ld subsections, jump table: %s]",
+             o.detector.name(), o.subdetectors.size(), yes_no(!o.sysTable.empty()));
+    return;
+  }
+  except("VolumeManager","freeze: Failed to compile lookup tables [Invalid Manager Handle]");
+}
+
+/// Check if the lookup containers were compiled into flat tables
+bool VolumeManager::isFrozen()  const   {
+  return isValid() && _data().frozen;
+}
+
 /// Lookup a physical (placed) volume identified by its 64 bit hit ID
 PlacedVolume VolumeManager::lookupDetElementPlacement(VolumeID volume_id) const {
   VolumeManagerContext* c = lookupContext(volume_id); // Throws exception if not found!
@@ -736,7 +776,70 @@ void VolumeManagerObject::update(unsigned long tags, DetElement& det, void* para
 
 /// Search the locally cached volumes for a matching ID
 VolumeManagerContext* VolumeManagerObject::search(const VolumeID& vol_id) const {
-  auto i = volumes.find(vol_id&detMask);
+  VolumeID key = vol_id&detMask;
+  if ( frozen )  {
+    auto i = std::lower_bound(frozenIDs.begin(), frozenIDs.end(), key);
+    return (i == frozenIDs.end() || *i != key) ? 0 : frozenContexts[i-frozenIDs.begin()];
+  }
+  auto i = volumes.find(key);
   return (i == volumes.end()) ? 0 : (*i).second;
 }
 
+/// Compile the placement map (and the one of all subdetectors) into flat lookup tables
+void VolumeManagerObject::freeze()   {
+  /// Maximal width of the system field to build a subdetector jump table
+  constexpr unsigned int max_table_bits = 16;
+  const BitFieldElement* sys_field = nullptr;
+  bool uniform = !subdetectors.empty();
+
+  thaw();
+  /// The map is ordered: the flat arrays are sorted by construction
+  frozenIDs.reserve(volumes.size());
+  frozenContexts.reserve(volumes.size());
+  for( const auto& v : volumes )  {
+    frozenIDs.emplace_back(v.first);
+    frozenContexts.emplace_back(v.second);
+  }
+  for( const auto& j : subdetectors )  {
+    Object* mo = j.second.ptr();
+    if ( mo != this )  {
+      mo->freeze();
+    }
+    if ( !mo->system )
+      uniform = false;
+    else if ( !sys_field )
+      sys_field = mo->system;
+    else if ( sys_field->offset() != mo->system->offset() || sys_field->width() != mo->system->width() )
+      uniform = false;
+  }
+  /// The jump table requires all subdetectors to share the same system field layout
+  if ( uniform && sys_field && sys_field->width() <= max_table_bits )  {
+    sysTableMask   = sys_field->mask();
+    sysTableOffset = sys_field->offset();
+    sysTable.assign(std::size_t(1) << sys_field->width(), nullptr);
+    for( const auto& j : subdetectors )  {
+      Object*  mo  = j.second.ptr();
+      VolumeID idx = ((mo->sysID << sysTableOffset) & sysTableMask) >> sysTableOffset;
+      if ( sysTable[idx] )  {
+        printout(WARNING, "VolumeManager", "+++ Duplicate system identifier %ld for %s and %s. "
+                 "No subdetector jump table is built.", long(mo->sysID),
+                 sysTable[idx]->detector.name(), mo->detector.name());
+        sysTable.clear();
+        break;
+      }
+      sysTable[idx] = mo;
+    }
+  }
+  frozen = true;
+}
+
+/// Invalidate the flat lookup tables. Lookups fall back to the placement map
+void VolumeManagerObject::thaw()   {
+  frozen = false;
+  frozenIDs.clear();
+  frozenContexts.clear();
+  sysTable.clear();
+  sysTableMask   = 0;
+  sysTableOffset = 0;
+}
+
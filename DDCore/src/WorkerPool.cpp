@@ -0,0 +1,110 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+//==========================================================================
+
+// Framework include files
+#include <DD4hep/detail/WorkerPool.h>
+
+// C/C++ include files
+#include <algorithm>
+#include <exception>
+
+using namespace dd4hep::detail;
+
+/// Invocation of one work function
+class WorkerPool::Job  {
+public:
+  /// Work function of the caller
+  const work_t*      work    = nullptr;
+  /// Helper invocations not yet started
+  std::size_t        pending = 0;
+  /// Helper invocations currently executing
+  std::size_t        active  = 0;
+  /// First exception thrown by a helper invocation
+  std::exception_ptr error;
+};
+
+/// Default destructor. Stops and joins the worker threads
+WorkerPool::~WorkerPool()   {
+  {
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_stop = true;
+  }
+  m_signal.notify_all();
+  for( auto& t : m_threads ) t.join();
+}
+
+/// Access to the process wide instance
+WorkerPool& WorkerPool::instance()   {
+  static WorkerPool s_pool;
+  return s_pool;
+}
+
+/// Number of worker threads created so far
+std::size_t WorkerPool::size()   {
+  std::lock_guard<std::mutex> guard(m_lock);
+  return m_threads.size();
+}
+
+/// Worker thread: execute helper invocations of the queued jobs
+void WorkerPool::worker()   {
+  std::unique_lock<std::mutex> guard(m_lock);
+  for(;;)   {
+    m_signal.wait(guard, [this] { return m_stop || !m_jobs.empty(); });
+    if ( m_stop ) break;
+    std::shared_ptr<Job> job = m_jobs.front();
+    if ( 0 == --job->pending ) m_jobs.pop_front();
+    ++job->active;
+    guard.unlock();
+    std::exception_ptr error;
+    try  {
+      (*job->work)();
+    }
+    catch(...)  {
+      error = std::current_exception();
+    }
+    guard.lock();
+    if ( error && !job->error ) job->error = error;
+    if ( 0 == --job->active ) m_done.notify_all();
+  }
+}
+
+/// Execute the work function using up to num_threads threads. The calling thread participates.
+void WorkerPool::run(std::size_t num_threads, const work_t& work)   {
+  std::shared_ptr<Job> job;
+  if ( num_threads > 1 )   {
+    job = std::make_shared<Job>();
+    job->work    = &work;
+    job->pending = num_threads-1;
+    std::lock_guard<std::mutex> guard(m_lock);
+    while ( m_threads.size() < num_threads-1 )
+      m_threads.emplace_back(&WorkerPool::worker, this);
+    m_jobs.emplace_back(job);
+  }
+  if ( job ) m_signal.notify_all();
+  std::exception_ptr error;
+  try  {
+    work();
+  }
+  catch(...)  {
+    error = std::current_exception();
+  }
+  if ( job )   {
+    std::unique_lock<std::mutex> guard(m_lock);
+    // Helper invocations, which did not start yet, are not needed anymore
+    if ( job->pending > 0 )   {
+      job->pending = 0;
+      m_jobs.erase(std::remove(m_jobs.begin(), m_jobs.end(), job), m_jobs.end());
+    }
+    m_done.wait(guard, [&job] { return 0 == job->active; });
+    if ( !error ) error = job->error;
+  }
+  if ( error ) std::rethrow_exception(error);
+}
@@ -0,0 +1,173 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+//==========================================================================
+
+// Framework include files
+#include <DD4hep/Detector.h>
+#include <DD4hep/Factories.h>
+#include <DD4hep/Printout.h>
+#include <DD4hep/Readout.h>
+#include <DDSegmentation/BitFieldCoder.h>
+
+// C/C++ include files
+#include <cerrno>
+#include <cstring>
+#include <cctype>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <set>
+
+using namespace dd4hep;
+
+namespace {
+
+  /// Turn an arbitrary field or readout name into a valid C++ identifier
+  std::string identifier(const std::string& name)   {
+    static const std::set<std::string> reserved = {
+      "and", "auto", "bool", "break", "case", "char", "class", "const", "default", "delete",
+      "do", "double", "else", "enum", "float", "for", "if", "int", "long", "namespace", "new",
+      "not", "or", "private", "protected", "public", "register", "return", "short", "signed",
+      "sizeof", "static", "struct", "switch", "template", "this", "union", "unsigned", "using",
+      "void", "while", "xor", "Coder"
+    };
+    std::string id = name;
+    for( auto& c : id )  {
+      if ( !::isalnum((unsigned char)c) ) c = '_';
+    }
+    if ( id.empty() || ::isdigit((unsigned char)id[0]) ) id = "_" + id;
+    if ( reserved.count(id) ) id += "_";
+    return id;
+  }
+
+  /// Turn a field name into a unique C++ identifier within the coder's namespace
+  /** Field types may neither be named like the static members of StaticBitFieldElement
+   *  nor like the generated name() accessor, nor clash with another field.
+   */
+  std::string field_identifier(const std::string& name, std::set<std::string>& used)   {
+    static const std::set<std::string> accessors = {
+      "name", "offset", "width", "isSigned", "mask", "minValue", "maxValue",
+      "value", "inRange", "encode", "set", "matches"
+    };
+    std::string id = identifier(name);
+    if ( accessors.count(id) ) id += "_";
+    while ( used.count(id) ) id += "_";
+    if ( id != identifier(name) )   {
+      printout(WARNING,"BitFieldCoderGenerator","++ Field %s is generated as %s to avoid a name clash.",
+               name.c_str(), id.c_str());
+    }
+    used.insert(id);
+    return id;
+  }
+
+  /// Emit the static coder of one cell ID description
+  void generate(std::ostream& os, const std::string& name, const DDSegmentation::BitFieldCoder& coder)   {
+    std::string ns = identifier(name), fields;
+    std::set<std::string> used = { "Coder" };
+    os << "  /// Static coder for " << name << ": \"" << coder.fieldDescription() << "\"" << std::endl
+       << "  namespace " << ns << " {" << std::endl;
+    for( const auto& f : coder.fields() )   {
+      std::string id = field_identifier(f.name(), used);
+      os << "    struct " << id << " : dd4hep::DDSegmentation::StaticBitFieldElement<"
+         << f.offset() << "," << (f.isSigned() ? "-" : "") << f.width() << "> {" << std::endl
+         << "      static constexpr const char* name() { return \"" << f.name() << "\"; }" << std::endl
+         << "    };" << std::endl;
+      fields += (fields.empty() ? "" : ",") + id;
+    }
+    os << "    struct Coder : dd4hep::DDSegmentation::StaticBitFieldCoder<" << fields << "> {" << std::endl
+       << "      static constexpr const char* fieldDescription() { return \""
+       << coder.fieldDescription() << "\"; }" << std::endl
+       << "    };" << std::endl
+       << "  }" << std::endl << std::endl;
+  }
+}
+
+/// Plugin generating compile-time specialised cell ID coders
+/**
+ *  Emits a header with a StaticBitFieldCoder for every requested readout
+ *  (all readouts of the detector description by default) or for an explicit
+ *  <id> string of the compact description.
+ *
+ *  Options:
+ *  -readout   <name>    Generate the coder for this readout. May be repeated.
+ *  -id        <string>  Generate the coder for this ID description, e.g. "system:8,layer:-6".
+ *  -name      <string>  Name of the coder generated with -id. Default: CellID
+ *  -namespace <string>  Enclosing namespace of the generated code. Default: DD4hepCellIDs
+ *  -output    <file>    Output file. Default: stdout
+ */
+static long generate_bitfieldcoders(Detector& description, int argc, char** argv) {
+  std::vector<std::string> readouts;
+  std::string id_desc, id_name = "CellID", ns = "DD4hepCellIDs", output;
+
+  for( int i = 0; i < argc && argv[i]; ++i )  {
+    if ( 0 == ::strncmp("-readout",argv[i],4) && i+1<argc )
+      readouts.emplace_back(argv[++i]);
+    else if ( 0 == ::strncmp("-id",argv[i],3) && i+1<argc )
+      id_desc = argv[++i];
+    else if ( 0 == ::strcmp("-name",argv[i]) && i+1<argc )
+      id_name = argv[++i];
+    else if ( 0 == ::strncmp("-namespace",argv[i],4) && i+1<argc )
+      ns = argv[++i];
+    else if ( 0 == ::strncmp("-output",argv[i],4) && i+1<argc )
+      output = argv[++i];
+    else   {
+      std::cout <<
+        "Usage: -plugin DD4hep_BitFieldCoderGenerator -arg [-arg]                          \n"
+        "     -readout   <name>    Generate the coder for this readout. May be repeated.   \n"
+        "     -id        <string>  Generate the coder for this ID description.            \n"
+        "     -name      <string>  Name of the coder generated with -id. Default: CellID   \n"
+        "     -namespace <string>  Enclosing namespace. Default: DD4hepCellIDs            \n"
+        "     -output    <file>    Output file. Default: stdout                           \n"
+        "\tArguments given: " << arguments(argc,argv) << std::endl << std::flush;
+      ::exit(EINVAL);
+    }
+  }
+  if ( id_desc.empty() && readouts.empty() )   {
+    for( const auto& r : description.readouts() )
+      readouts.emplace_back(r.first);
+  }
+
+  std::unique_ptr<std::ofstream> out;
+  std::ostream* os = &std::cout;
+  if ( !output.empty() )   {
+    out.reset(new std::ofstream(output.c_str()));
+    if ( !out->good() )   {
+      except("BitFieldCoderGenerator","++ Failed to open output file: %s [%s]",
+             output.c_str(), ::strerror(errno));
+    }
+    os = out.get();
+  }
+  std::string guard = identifier(ns) + "_H";
+  for( auto& c : guard ) c = ::toupper((unsigned char)c);
+
+  *os << "// Generated by the DD4hep_BitFieldCoderGenerator plugin. Do not edit." << std::endl
+      << "#ifndef " << guard << std::endl
+      << "#define " << guard << std::endl << std::endl
+      << "#include \"DDSegmentation/StaticBitFieldCoder.h\"" << std::endl << std::endl
+      << "namespace " << identifier(ns) << " {" << std::endl << std::endl;
+  if ( !id_desc.empty() )   {
+    generate(*os, id_name, DDSegmentation::BitFieldCoder(id_desc));
+  }
+  for( const auto& name : readouts )   {
+    Readout ro = description.readout(name);
+    if ( !ro.isValid() || !ro.idSpec().isValid() )   {
+      except("BitFieldCoderGenerator","++ Readout %s has no ID specification.", name.c_str());
+    }
+    generate(*os, name, *ro.idSpec().decoder());
+  }
+  *os << "}" << std::endl
+      << "#endif // " << guard << std::endl;
+  printout(INFO,"BitFieldCoderGenerator","++ Generated %ld static cell ID coder(s)%s%s",
+           long(readouts.size() + (id_desc.empty() ? 0 : 1)),
+           output.empty() ? "" : " to ", output.c_str());
+  return 1;
+}
+DECLARE_APPLY(DD4hep_BitFieldCoderGenerator,generate_bitfieldcoders)
@@ -798,16 +798,27 @@ DECLARE_APPLY(DD4hep_XMLProcessor,process_xml_doc)
 /**
  *  Factory: DD4hep_VolumeManager
  *
+ *  Options:
+ *  -freeze   Compile the lookup containers into flat tables after populating
+ *
  *  \author  M.Frank
  *  \version 1.0
  *  \date    01/04/2014
  */
-static long load_volmgr(Detector& description, int, char**) {
+static long load_volmgr(Detector& description, int argc, char** argv) {
+  bool freeze = false;
+  for( int i = 0; i < argc && argv[i]; ++i )  {
+    if ( 0 == ::strncmp("-freeze",argv[i],4) )
+      freeze = true;
+  }
   printout(INFO,"DD4hepVolumeManager","**** running plugin DD4hepVolumeManager ! " );
   try {
     DetectorImp* imp = dynamic_cast<DetectorImp*>(&description);
     if ( imp )  {
       imp->imp_loadVolumeManager();
+      if ( freeze )  {
+        description.volumeManager().freeze();
+      }
       printout(INFO,"VolumeManager","+++ Volume manager populated and loaded.");
       return 1;
     }
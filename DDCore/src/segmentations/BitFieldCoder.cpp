@@ -1,6 +1,7 @@
 #include "DDSegmentation/BitFieldCoder.h"
 
 #include <cmath>
+#include <limits>
 #include <algorithm>
 #include <stdexcept>
 
@@ -71,6 +72,28 @@ namespace dd4hep{
 
 
 
+    BitFieldAccessor::BitFieldAccessor( const BitFieldElement& field ) :
+      _mask( field.mask() ),
+      _offset( field.offset() ),
+      _left( 64 - field.offset() - field.width() ),
+      _right( 64 - field.width() ),
+      _isSigned( field.isSigned() ) {
+
+      unsigned w = field.width() ;
+      if( w >= 63 ) {
+        _minVal = _isSigned ? std::numeric_limits<FieldID>::min() : 0 ;
+        _maxVal = std::numeric_limits<FieldID>::max() ;
+      } else if( _isSigned ) {
+        _minVal = -( FieldID(1) << ( w - 1 ) ) ;
+        _maxVal =  ( FieldID(1) << ( w - 1 ) ) - 1 ;
+      } else {
+        _minVal = 0 ;
+        _maxVal = ( FieldID(1) << w ) - 1 ;
+      }
+    }
+
+
+
     size_t BitFieldCoder::index( const std::string& name) const {
     
       IndexMap::const_iterator it = _map.find( name ) ;
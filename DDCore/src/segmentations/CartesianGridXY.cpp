@@ -7,6 +7,9 @@
 
 #include "DDSegmentation/CartesianGridXY.h"
 
+#include <cmath>
+#include <stdexcept>
+
 namespace dd4hep {
 namespace DDSegmentation {
 
@@ -66,6 +69,37 @@ CellID CartesianGridXY::cellID(const Vector3D& localPosition,
 	return cID;
 }
 
+/// determine the local positions of many cells at once
+void CartesianGridXY::positions(const CellID* cIDs, Vector3D* localPositions, std::size_t count) const {
+	const BitFieldAccessor fx((*_decoder)[_xId]), fy((*_decoder)[_yId]);
+	for (std::size_t i = 0; i < count; ++i) {
+		CellID cID = cIDs[i];
+		localPositions[i].X = fx.get(cID) * _gridSizeX + _offsetX;
+		localPositions[i].Y = fy.get(cID) * _gridSizeY + _offsetY;
+		localPositions[i].Z = 0.;
+	}
+}
+
+/// determine the cell IDs of many positions at once
+void CartesianGridXY::cellIDs(const Vector3D* localPositions, const Vector3D* globalPositions,
+                              const VolumeID* volumeIDs, CellID* cIDs, std::size_t count) const {
+	if (_gridSizeX <= 1e-10 || _gridSizeY <= 1e-10) {
+		throw std::runtime_error("Invalid cell size: 0.0");
+	}
+	const BitFieldAccessor fx((*_decoder)[_xId]), fy((*_decoder)[_yId]);
+	bool inRange = true;
+	for (std::size_t i = 0; i < count; ++i) {
+		int bx = int(std::floor((localPositions[i].X + 0.5 * _gridSizeX - _offsetX) / _gridSizeX));
+		int by = int(std::floor((localPositions[i].Y + 0.5 * _gridSizeY - _offsetY) / _gridSizeY));
+		inRange &= fx.inRange(bx) & fy.inRange(by);
+		cIDs[i] = fy.set(fx.set(volumeIDs[i], bx), by);
+	}
+	// let the single cell method raise the appropriate exception
+	if (!inRange) {
+		Segmentation::cellIDs(localPositions, globalPositions, volumeIDs, cIDs, count);
+	}
+}
+
   std::vector<double> CartesianGridXY::cellDimensions(const CellID& /* cellID */) const {
 #if __cplusplus >= 201103L
   return {_gridSizeX, _gridSizeY};
@@ -7,6 +7,9 @@
 
 #include "DDSegmentation/CartesianGridXZ.h"
 
+#include <cmath>
+#include <stdexcept>
+
 namespace dd4hep {
 namespace DDSegmentation {
 
@@ -67,6 +70,37 @@ Vector3D CartesianGridXZ::position(const CellID& cID) const {
 	return cID ;
 }
 
+/// determine the local positions of many cells at once
+void CartesianGridXZ::positions(const CellID* cIDs, Vector3D* localPositions, std::size_t count) const {
+	const BitFieldAccessor fx((*_decoder)[_xId]), fz((*_decoder)[_zId]);
+	for (std::size_t i = 0; i < count; ++i) {
+		CellID cID = cIDs[i];
+		localPositions[i].X = fx.get(cID) * _gridSizeX + _offsetX;
+		localPositions[i].Z = fz.get(cID) * _gridSizeZ + _offsetZ;
+		localPositions[i].Y = 0.;
+	}
+}
+
+/// determine the cell IDs of many positions at once
+void CartesianGridXZ::cellIDs(const Vector3D* localPositions, const Vector3D* globalPositions,
+                              const VolumeID* volumeIDs, CellID* cIDs, std::size_t count) const {
+	if (_gridSizeX <= 1e-10 || _gridSizeZ <= 1e-10) {
+		throw std::runtime_error("Invalid cell size: 0.0");
+	}
+	const BitFieldAccessor fx((*_decoder)[_xId]), fz((*_decoder)[_zId]);
+	bool inRange = true;
+	for (std::size_t i = 0; i < count; ++i) {
+		int bx = int(std::floor((localPositions[i].X + 0.5 * _gridSizeX - _offsetX) / _gridSizeX));
+		int bz = int(std::floor((localPositions[i].Z + 0.5 * _gridSizeZ - _offsetZ) / _gridSizeZ));
+		inRange &= fx.inRange(bx) & fz.inRange(bz);
+		cIDs[i] = fz.set(fx.set(volumeIDs[i], bx), bz);
+	}
+	// let the single cell method raise the appropriate exception
+	if (!inRange) {
+		Segmentation::cellIDs(localPositions, globalPositions, volumeIDs, cIDs, count);
+	}
+}
+
 std::vector<double> CartesianGridXZ::cellDimensions(const CellID&) const {
 #if __cplusplus >= 201103L
   return {_gridSizeX, _gridSizeZ};
@@ -7,6 +7,9 @@
 
 #include "DDSegmentation/PolarGridRPhi.h"
 
+#include <cmath>
+#include <stdexcept>
+
 namespace dd4hep {
 namespace DDSegmentation {
 
@@ -69,6 +72,41 @@ Vector3D PolarGridRPhi::position(const CellID& cID) const {
 	return cID;
 }
 
+/// determine the local positions of many cells at once
+void PolarGridRPhi::positions(const CellID* cIDs, Vector3D* localPositions, std::size_t count) const {
+	const BitFieldAccessor fr((*_decoder)[_rId]), fphi((*_decoder)[_phiId]);
+	for (std::size_t i = 0; i < count; ++i) {
+		double R   = fr.get(cIDs[i])   * _gridSizeR   + _offsetR;
+		double phi = fphi.get(cIDs[i]) * _gridSizePhi + _offsetPhi;
+		localPositions[i].X = R * cos(phi);
+		localPositions[i].Y = R * sin(phi);
+		localPositions[i].Z = 0.;
+	}
+}
+
+/// determine the cell IDs of many positions at once
+void PolarGridRPhi::cellIDs(const Vector3D* localPositions, const Vector3D* globalPositions,
+                            const VolumeID* volumeIDs, CellID* cIDs, std::size_t count) const {
+	if (_gridSizeR <= 1e-10 || _gridSizePhi <= 1e-10) {
+		throw std::runtime_error("Invalid cell size: 0.0");
+	}
+	const BitFieldAccessor fr((*_decoder)[_rId]), fphi((*_decoder)[_phiId]);
+	bool inRange = true;
+	for (std::size_t i = 0; i < count; ++i) {
+		const Vector3D& lp = localPositions[i];
+		double phi  = atan2(lp.Y, lp.X);
+		double R    = sqrt(lp.X * lp.X + lp.Y * lp.Y);
+		int    br   = int(floor((R   + 0.5 * _gridSizeR   - _offsetR)   / _gridSizeR));
+		int    bphi = int(floor((phi + 0.5 * _gridSizePhi - _offsetPhi) / _gridSizePhi));
+		inRange &= fr.inRange(br) & fphi.inRange(bphi);
+		cIDs[i] = fphi.set(fr.set(volumeIDs[i], br), bphi);
+	}
+	// let the single cell method raise the appropriate exception
+	if (!inRange) {
+		Segmentation::cellIDs(localPositions, globalPositions, volumeIDs, cIDs, count);
+	}
+}
+
 std::vector<double> PolarGridRPhi::cellDimensions(const CellID& cID) const {
   const double rPhiSize = binToPosition(_decoder->get(cID,_rId), _gridSizeR, _offsetR)*_gridSizePhi;
 #if __cplusplus >= 201103L
@@ -10,6 +10,7 @@
 
 #define _USE_MATH_DEFINES
 #include <cmath>
+#include <stdexcept>
 
 namespace dd4hep {
 namespace DDSegmentation {
@@ -69,6 +70,43 @@ CellID ProjectiveCylinder::cellID(const Vector3D& /* localPosition */, const Vec
 	return cID;
 }
 
+/// determine the local positions of many cells at once
+void ProjectiveCylinder::positions(const CellID* cIDs, Vector3D* localPositions, std::size_t count) const {
+	const BitFieldAccessor ftheta((*_decoder)[_thetaID]), fphi((*_decoder)[_phiID]);
+	for (std::size_t i = 0; i < count; ++i) {
+		// same conversions as in theta() and phi()
+		CellID thetaIndex = ftheta.get(cIDs[i]);
+		CellID phiIndex   = fphi.get(cIDs[i]);
+		double lTheta = M_PI * ((double) thetaIndex + 0.5) / (double) _thetaBins;
+		double lPhi   = 2. * M_PI * ((double) phiIndex + 0.5) / (double) _phiBins;
+		localPositions[i] = Util::positionFromRThetaPhi(1.0, lTheta, lPhi);
+	}
+}
+
+/// determine the cell IDs of many positions at once
+void ProjectiveCylinder::cellIDs(const Vector3D* localPositions, const Vector3D* globalPositions,
+                                 const VolumeID* volumeIDs, CellID* cIDs, std::size_t count) const {
+	const double thetaSize = M_PI / (double) _thetaBins;
+	const double phiSize   = 2 * M_PI / (double) _phiBins;
+	if (thetaSize <= 1e-10 || phiSize <= 1e-10) {
+		throw std::runtime_error("Invalid cell size: 0.0");
+	}
+	const BitFieldAccessor ftheta((*_decoder)[_thetaID]), fphi((*_decoder)[_phiID]);
+	bool inRange = true;
+	for (std::size_t i = 0; i < count; ++i) {
+		double lTheta = thetaFromXYZ(globalPositions[i]);
+		double lPhi   = phiFromXYZ(globalPositions[i]);
+		int    btheta = int(std::floor((lTheta + 0.5 * thetaSize - _offsetTheta) / thetaSize));
+		int    bphi   = int(std::floor((lPhi   + 0.5 * phiSize   - _offsetPhi)   / phiSize));
+		inRange &= ftheta.inRange(btheta) & fphi.inRange(bphi);
+		cIDs[i] = fphi.set(ftheta.set(volumeIDs[i], btheta), bphi);
+	}
+	// let the single cell method raise the appropriate exception
+	if (!inRange) {
+		Segmentation::cellIDs(localPositions, globalPositions, volumeIDs, cIDs, count);
+	}
+}
+
 /// determine the polar angle theta based on the cell ID
 double ProjectiveCylinder::theta(const CellID& cID) const {
         CellID thetaIndex = _decoder->get(cID,_thetaID);
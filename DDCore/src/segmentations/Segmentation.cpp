@@ -52,6 +52,21 @@ namespace dd4hep {
       throw std::runtime_error("This segmentation type:"+_type+" does not support sub-segmentations.");
     }
 
+    /// Determine the local positions of many cells at once
+    void Segmentation::positions(const CellID* cIDs, Vector3D* localPositions, std::size_t count) const {
+      for (std::size_t i = 0; i < count; ++i) {
+        localPositions[i] = position(cIDs[i]);
+      }
+    }
+
+    /// Determine the cell IDs of many positions at once
+    void Segmentation::cellIDs(const Vector3D* localPositions, const Vector3D* globalPositions,
+                               const VolumeID* volumeIDs, CellID* cIDs, std::size_t count) const {
+      for (std::size_t i = 0; i < count; ++i) {
+        cIDs[i] = cellID(localPositions[i], globalPositions[i], volumeIDs[i]);
+      }
+    }
+
     /// Determine the volume ID from the full cell ID by removing all local fields
     VolumeID Segmentation::volumeID(const CellID& cID) const {
       map<std::string, StringParameter>::const_iterator it;
@@ -46,11 +46,28 @@ namespace dd4hep {
 
     /// Base class to output Geant4 event data to EDM4hep
     /**
+     *  The event data are converted without locking into collections owned by
+     *  the action instance. The filled frame is handed to the output stream.
+     *  If the property WriterQueueSize is non-zero, the frames are written by a
+     *  separate writer thread fed by a bounded queue (see Geant4WriterQueue).
+     *
+     *  In multi-threaded mode the action may be created once per worker
+     *  thread (non-shared). All instances writing to the same file share one
+     *  output stream. Every thread fiber of an instance is registered as user
+     *  of the stream before the run starts. The run header is written when the
+     *  last fiber ends the run. The file is closed with the file metadata when
+     *  the kernel terminates or the last user is destroyed. With FilesByRun the
+     *  run file is closed once all fibers ended the run.
+     *
      *  \author  F.Gaede
      *  \version 1.0
      *  \ingroup DD4HEP_SIMULATION
      */
     class Geant4Output2EDM4hep : public Geant4OutputAction  {
+    public:
+      /// Output file shared by all instances writing to the same file
+      class Stream;
+
     protected:
 #if PODIO_VERSION_MAJOR > 0 || (PODIO_VERSION_MAJOR == 0 && PODIO_VERSION_MINOR >= 99)
       using writer_t = podio::ROOTWriter;
@@ -61,7 +78,8 @@ namespace dd4hep {
       using trackermap_t = std::map< std::string, edm4hep::SimTrackerHitCollection >;
       using calorimeterpair_t = std::pair< edm4hep::SimCalorimeterHitCollection, edm4hep::CaloHitContributionCollection >;
       using calorimetermap_t = std::map< std::string, calorimeterpair_t >;
-      std::unique_ptr<writer_t>     m_file  { };
+      /// Output stream used by this instance
+      std::shared_ptr<Stream>       m_stream { };
       podio::Frame                  m_frame { };
       edm4hep::MCParticleCollection m_particles { };
       trackermap_t                  m_trackerHits;
@@ -77,16 +95,22 @@ namespace dd4hep {
       int                           m_eventNo           { 0 };
       int                           m_eventNumberOffset { 0 };
       bool                          m_filesByRun        { false };
+      /// Property: Size of the queue to the writer thread. 0: write in the calling thread
+      int                           m_writerQueueSize   { 0 };
+      /// Number of thread fibers registered as users of the output stream
+      int                           m_numFibers         { 0 };
+      /// Output name the thread fibers were registered for
+      std::string                   m_fiberOutput       { };
       
       /// Data conversion interface for MC particles to EDM4hep format
       void saveParticles(Geant4ParticleMap* particles);
-      /// Store the metadata frame with e.g. the cellID encoding strings
-      void saveFileMetaData();
     public:
       /// Standard constructor
       Geant4Output2EDM4hep(Geant4Context* ctxt, const std::string& nam);
       /// Default destructor
       virtual ~Geant4Output2EDM4hep();
+      /// Set or update client for the use in a new thread fiber
+      virtual void configureFiber(Geant4Context* thread_context)  override;
       /// Callback to store the Geant4 run information
       virtual void beginRun(const G4Run* run);
       /// Callback to store the Geant4 run information
@@ -183,8 +207,10 @@ namespace dd4hep {
 #include <DDG4/Geant4DataConversion.h>
 #include <DDG4/Geant4SensDetAction.h>
 #include <DDG4/Geant4Context.h>
+#include <DDG4/Geant4Kernel.h>
 #include <DDG4/Geant4Particle.h>
 #include <DDG4/Geant4Data.h>
+#include <DDG4/Geant4WriterQueue.h>
 
 ///#include <DDG4/Geant4Output2EDM4hep.h>
 /// Geant4 headers
@@ -201,11 +227,87 @@ namespace dd4hep {
 /// edm4hep include files
 #include <edm4hep/EventHeaderCollection.h>
 
+/// ROOT include files
+#include <TROOT.h>
+
 using namespace dd4hep::sim;
 using namespace dd4hep;
 
+/// Output file shared by all instances writing to the same file
+class Geant4Output2EDM4hep::Stream  {
+public:
+  /// File name
+  std::string                        name;
+  /// The podio writer
+  std::unique_ptr<writer_t>          file;
+  /// Optional writer thread
+  std::unique_ptr<Geant4WriterQueue> queue;
+  /// Cell ID encodings of all collections written by all users
+  stringmap_t                        cellIDEncodingStrings;
+  /// Number of thread fibers, which ended the current run
+  int                                runEnds  { 0 };
+  /// Protection of the writer if no writer thread is used
+  std::mutex                         lock;
+
+  /// Write frame
+  void write(podio::Frame&& frame, const std::string& category)  {
+    if ( queue )  {
+      // std::function needs a copyable request: the frame is held by a shared pointer
+      auto       data   = std::make_shared<podio::Frame>(std::move(frame));
+      writer_t*  writer = file.get();
+      queue->push([writer, data, category] { writer->writeFrame(*data, category); });
+      return;
+    }
+    std::lock_guard<std::mutex> protection(lock);
+    file->writeFrame(frame, category);
+  }
+  /// Write the file metadata and all pending frames and close the file
+  void finish()  {
+    if ( !file )  {
+      return;
+    }
+    podio::Frame metaFrame {};
+    for (const auto& [name, encodingStr] : cellIDEncodingStrings)
+      metaFrame.putParameter(name + "__CellIDEncoding", encodingStr);
+    write(std::move(metaFrame), "metadata");
+    if ( queue )  {
+      writer_t* writer = file.get();
+      queue->push([writer] { writer->finish(); });
+      queue->drain();
+      queue.reset();
+    }
+    else  {
+      file->finish();
+    }
+    file.reset();
+  }
+};
+
 namespace {
+  /// Protection of the output stream registry
   G4Mutex action_mutex = G4MUTEX_INITIALIZER;
+  /// Output streams by file name
+  std::map<std::string, std::shared_ptr<Geant4Output2EDM4hep::Stream> >& output_streams()  {
+    static std::map<std::string, std::shared_ptr<Geant4Output2EDM4hep::Stream> > streams;
+    return streams;
+  }
+  /// Number of thread fibers writing to an output: registered before the run starts
+  std::map<std::string, int>& output_users()  {
+    static std::map<std::string, int> users;
+    return users;
+  }
+  /// Flag if the kernel closes the output streams on terminate
+  bool terminate_registered = false;
+  /// Close all output streams. The action instances live as long as the kernel
+  void close_streams()  {
+    std::map<std::string, std::shared_ptr<Geant4Output2EDM4hep::Stream> > streams;  {
+      G4AutoLock protection_lock(&action_mutex);
+      streams = std::move(output_streams());
+      output_streams().clear();
+    }
+    for( auto& s : streams )
+      s.second->finish();
+  }
 }
 
 #include <DDG4/Factories.h>
@@ -223,20 +325,49 @@ Geant4Output2EDM4hep::Geant4Output2EDM4hep(Geant4Context* ctxt, const std::strin
   declareProperty("EventNumberOffset",     m_eventNumberOffset);
   declareProperty("SectionName",           m_section_name);
   declareProperty("FilesByRun",            m_filesByRun);
+  declareProperty("WriterQueueSize",       m_writerQueueSize);
   info("Writer is now instantiated ..." );
   InstanceCount::increment(this);
 }
 
 /// Default destructor
 Geant4Output2EDM4hep::~Geant4Output2EDM4hep()  {
-  G4AutoLock protection_lock(&action_mutex);
-  m_file.reset();
+  if ( m_numFibers > 0 )   {
+    bool last = false;   {
+      G4AutoLock protection_lock(&action_mutex);
+      // The last user closes the file
+      int& users = output_users()[m_fiberOutput];
+      users -= m_numFibers;
+      if ( users <= 0 && m_stream )   {
+        for (const auto& [name, encodingStr] : m_cellIDEncodingStrings)
+          m_stream->cellIDEncodingStrings.try_emplace(name, encodingStr);
+        output_streams().erase(m_stream->name);
+        last = true;
+      }
+    }
+    if ( last )   {
+      m_stream->finish();
+    }
+  }
+  m_stream.reset();
   InstanceCount::decrement(this);
 }
 
+/// Set or update client for the use in a new thread fiber
+void Geant4Output2EDM4hep::configureFiber(Geant4Context* thread_context)   {
+  Geant4OutputAction::configureFiber(thread_context);
+  // In multi-threaded mode the master prepared ROOT before the worker threads started
+  if ( m_writerQueueSize > 0 && G4Threading::IsMasterThread() )   {
+    ROOT::EnableThreadSafety();
+  }
+  G4AutoLock protection_lock(&action_mutex);
+  m_fiberOutput = m_output;
+  ++output_users()[m_fiberOutput];
+  ++m_numFibers;
+}
+
 // Callback to store the Geant4 run information
 void Geant4Output2EDM4hep::beginRun(const G4Run* run)  {
-  G4AutoLock protection_lock(&action_mutex);
   std::string fname = m_output;
   m_runNo = run->GetRunID();
   if ( m_filesByRun )    {
@@ -246,41 +377,60 @@ void Geant4Output2EDM4hep::beginRun(const G4Run* run)  {
     }
   }
   if ( !fname.empty() )   {
-#if PODIO_VERSION_MAJOR > 0 || (PODIO_VERSION_MAJOR == 0 && PODIO_VERSION_MINOR >= 99)
-    m_file = std::make_unique<podio::ROOTWriter>(fname);
-#else
-    m_file = std::make_unique<podio::ROOTFrameWriter>(fname);
-#endif
-    if ( !m_file )   {
-      fatal("+++ Failed to open output file: %s", fname.c_str());
+    // A shared instance acquires the stream once: the first thread fiber starting the run
+    G4AutoLock protection_lock(&action_mutex);
+    if ( m_stream && m_stream->name == fname )   {
+      return;
     }
-    printout( INFO, "Geant4Output2EDM4hep" ,"Opened %s for output", fname.c_str() ) ;
+    auto& stream = output_streams()[fname];
+    if ( !stream )   {
+      auto new_stream  = std::make_shared<Stream>();
+      new_stream->name = fname;
+      new_stream->file = std::make_unique<writer_t>(fname);
+      if ( !new_stream->file )   {
+        output_streams().erase(fname);
+        fatal("+++ Failed to open output file: %s", fname.c_str());
+      }
+      if ( m_writerQueueSize > 0 )   {
+        new_stream->queue = std::make_unique<Geant4WriterQueue>(m_writerQueueSize);
+      }
+      stream = new_stream;
+      printout( INFO, "Geant4Output2EDM4hep" ,"Opened %s for output", fname.c_str() ) ;
+      if ( !terminate_registered )   {
+        terminate_registered = true;
+        context()->kernel().master().register_terminate(close_streams);
+      }
+    }
+    m_stream = stream;
   }
 }
 
 /// Callback to store the Geant4 run information
 void Geant4Output2EDM4hep::endRun(const G4Run* run)  {
-  saveRun(run);
-  saveFileMetaData();
-  if ( m_file )   {
-    m_file->finish();
-    m_file.reset();
-  }
-}
-
-void Geant4Output2EDM4hep::saveFileMetaData() {
-  podio::Frame metaFrame{};
-  for (const auto& [name, encodingStr] : m_cellIDEncodingStrings) {
-    metaFrame.putParameter(name + "__CellIDEncoding", encodingStr);
+  if ( m_stream )   {
+    bool last = false;   {
+      G4AutoLock protection_lock(&action_mutex);
+      for (const auto& [name, encodingStr] : m_cellIDEncodingStrings)
+        m_stream->cellIDEncodingStrings.try_emplace(name, encodingStr);
+      // The last thread fiber ending the run writes the run header
+      if ( ++m_stream->runEnds >= output_users()[m_fiberOutput] )   {
+        m_stream->runEnds = 0;
+        last = true;
+        if ( m_filesByRun )
+          output_streams().erase(m_stream->name);
+      }
+    }
+    if ( last )   {
+      saveRun(run);
+      if ( m_filesByRun )
+        m_stream->finish();
+    }
   }
-
-  m_file->writeFrame(metaFrame, "metadata");
 }
 
 /// Commit data at end of filling procedure
 void Geant4Output2EDM4hep::commit( OutputContext<G4Event>& /* ctxt */)   {
-  if ( m_file )   {
-    G4AutoLock protection_lock(&action_mutex);
+  if ( m_stream )   {
     m_frame.put( std::move(m_particles), "MCParticles");
     for (auto it = m_trackerHits.begin(); it != m_trackerHits.end(); ++it)   {
       m_frame.put( std::move(it->second), it->first);
@@ -289,7 +439,7 @@ void Geant4Output2EDM4hep::commit( OutputContext<G4Event>& /* ctxt */)   {
       m_frame.put( std::move(calorimeterHits.first), colName);
       m_frame.put( std::move(calorimeterHits.second), colName + "Contributions");
     }
-    m_file->writeFrame(m_frame, m_section_name);
+    m_stream->write(std::move(m_frame), m_section_name);
     m_particles.clear();
     m_trackerHits.clear();
     m_calorimeterHits.clear();
@@ -301,7 +451,6 @@ void Geant4Output2EDM4hep::commit( OutputContext<G4Event>& /* ctxt */)   {
 
 /// Callback to store the Geant4 run information
 void Geant4Output2EDM4hep::saveRun(const G4Run* run)   {
-  G4AutoLock protection_lock(&action_mutex);
   // --- write an edm4hep::RunHeader ---------
   // Runs are just Frames with different contents in EDM4hep / podio. We simply
   // store everything as parameters for now
@@ -320,7 +469,7 @@ void Geant4Output2EDM4hep::saveRun(const G4Run* run)   {
     parameters->extractParameters(runHeader);
   }
 
-  m_file->writeFrame(runHeader, "runs");
+  m_stream->write(std::move(runHeader), "runs");
 }
 
 void Geant4Output2EDM4hep::begin(const G4Event* event)  {
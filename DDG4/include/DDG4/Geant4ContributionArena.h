@@ -0,0 +1,123 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+//==========================================================================
+#ifndef DDG4_GEANT4CONTRIBUTIONARENA_H
+#define DDG4_GEANT4CONTRIBUTIONARENA_H
+
+// Framework include files
+#include <DDG4/Geant4Data.h>
+
+// C/C++ include files
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the Geant4 based simulation part of the AIDA detector description toolkit
+  namespace sim {
+
+    /// Event scoped storage of the monte carlo contributions of calorimeter hits
+    /**
+     *  During the event the contributions of all hits are appended to one
+     *  contiguous buffer. The contributions of each hit are chained by index
+     *  and only at the end of the event they are moved to the truth vector
+     *  of the hit with a single allocation of the exact size.
+     *  The buffers keep their capacity from one event to the next:
+     *  in steady state adding contributions does not allocate memory.
+     *  The hits themselves and the key index of the hit collection are
+     *  allocated as without the arena.
+     *
+     *  Hits are addressed by their index in the hit collection: the lookup
+     *  by cell identifier is left to the key index of the collection.
+     *
+     *  Optionally the contributions of the same track to one hit are merged
+     *  (truth compaction): deposits and step lengths are summed, the
+     *  position is the energy weighted mean, the time the earliest time and
+     *  the momentum the one of the first contribution.
+     *
+     *  The hits themselves stay owned by the hit collection.
+     *  Until flush() is called the truth vectors of the hits are empty.
+     *
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4ContributionArena  {
+    public:
+      typedef Geant4Calorimeter::Hit      Hit;
+      typedef Geant4HitData::Contribution Contribution;
+      /// Truth compaction policies
+      enum Compaction  {
+        KEEP_ALL_CONTRIBUTIONS = 0,
+        MERGE_TRACK_CONTRIBUTIONS = 1
+      };
+
+    protected:
+      /// Chain of contributions of one hit
+      struct Block  {
+        Hit*          hit;
+        std::uint32_t first;
+        std::uint32_t last;
+        std::uint32_t count;
+      };
+      /// Contiguous contribution buffer of all hits
+      std::vector<Contribution>              m_contributions;
+      /// Index of the next contribution of the same hit
+      std::vector<std::uint32_t>             m_next;
+      /// Contribution chains indexed by the hit index in the collection
+      std::vector<Block>                     m_blocks;
+      /// Number of hits adopted
+      std::size_t                            m_numHits = 0;
+      /// Scratch map used by flush() to merge contributions by track
+      std::unordered_map<int,std::size_t>    m_tracks;
+      /// Statistics: number of merged contributions
+      std::size_t                            m_numMerged = 0;
+
+    public:
+      /// Truth compaction policy. One of the enum Compaction
+      int compaction = KEEP_ALL_CONTRIBUTIONS;
+
+    public:
+      /// Default constructor
+      Geant4ContributionArena() = default;
+      /// Inhibit copy constructor
+      Geant4ContributionArena(const Geant4ContributionArena& copy) = delete;
+      /// Default destructor
+      ~Geant4ContributionArena() = default;
+      /// Inhibit assignment
+      Geant4ContributionArena& operator=(const Geant4ContributionArena& copy) = delete;
+
+      /// Merge contribution of the same track
+      static void merge(Contribution& target, const Contribution& source);
+
+      /// Number of hits in the arena
+      std::size_t numHits()  const           {  return m_numHits;              }
+      /// Number of pending contributions in the arena
+      std::size_t numContributions()  const  {  return m_contributions.size(); }
+      /// Statistics: number of contributions merged since construction
+      std::size_t numMerged()  const         {  return m_numMerged;            }
+
+      /// Access hit by its collection index. Returns null if the hit was not adopted
+      Hit* hit(std::size_t which)  const   {
+        return which < m_blocks.size() ? m_blocks[which].hit : nullptr;
+      }
+      /// Register hit with its index in the hit collection. The hit is owned by the collection
+      void adopt(std::size_t which, Hit* hit);
+      /// Add contribution to the hit with the given index and update its energy deposit
+      void add(std::size_t which, const Contribution& contrib);
+      /// Move the pending contributions to the hits and reset the arena
+      std::size_t flush();
+      /// Drop all pending contributions without touching the hits
+      void clear();
+    };
+  }    // End namespace sim
+}      // End namespace dd4hep
+#endif // DDG4_GEANT4CONTRIBUTIONARENA_H
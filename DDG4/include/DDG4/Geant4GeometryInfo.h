@@ -108,6 +108,29 @@ namespace dd4hep {
 	PlacementFlags(int v) { this->value = v; }
       };
       typedef std::vector<const G4VPhysicalVolume*>  Geant4PlacementPath;
+      /// Flat open addressing index of g4Paths for allocation free lookups by touchable
+      struct PathIndex  {
+        struct Entry  {
+          /// Hash of the placement path
+          std::size_t hash      = 0;
+          /// Start of the placement path in 'volumes'
+          std::size_t offset    = 0;
+          /// Length of the placement path. 0 marks an empty slot
+          std::size_t length    = 0;
+          /// Start of the replicated/parametrised volume fields in 'fields'
+          std::size_t field     = 0;
+          /// Number of replicated/parametrised volume fields
+          std::size_t numFields = 0;
+          /// Volume ID of the path without replication/parametrisation fields
+          VolumeID    volumeID  = 0;
+        };
+        /// Hash table slots (size is a power of 2)
+        std::vector<Entry>                    slots;
+        /// Concatenated placement paths of all entries
+        std::vector<const G4VPhysicalVolume*> volumes;
+        /// Touchable depth and bit field for replicated/parametrised path elements
+        std::vector<std::pair<int, const DDSegmentation::BitFieldElement*> > fields;
+      };
       TGeoManager*                         manager = 0;
       Geant4GeometryMaps::IsotopeMap       g4Isotopes;
       Geant4GeometryMaps::ElementMap       g4Elements;
@@ -134,6 +157,7 @@ namespace dd4hep {
       std::map<VisAttr, G4VisAttributes*>                      g4Vis;
       std::map<LimitSet, G4UserLimits*>                        g4Limits;
       std::map<Geant4PlacementPath, Placement>                 g4Paths;
+      PathIndex                                                g4PathIndex;
       std::map<SensitiveDetector,std::set<const TGeoVolume*> > sensitives;
       std::map<Region,           std::set<const TGeoVolume*> > regions;
       std::map<LimitSet,         std::set<const TGeoVolume*> > limits;
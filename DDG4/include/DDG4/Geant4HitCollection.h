@@ -23,6 +23,8 @@
 #include <vector>
 #include <string>
 #include <climits>
+#include <functional>
+#include <unordered_map>
 #include <typeinfo>
 #include <stdexcept>
 
@@ -193,6 +195,11 @@ namespace dd4hep {
      * This obviously only helps, if contributions to the same cell come in
      * sequence ie. from the same G4Track.
      *
+     * Independent of the insertion order hits may be looked up in O(1)
+     * using one of the two hash indices:
+     *  - by key (typically the cell ID): add(key, hit) / findByKey(key)
+     *  - by position: addByPosition(hit) / findByPosition(pos)
+     *
      *
      *  \author  M.Frank
      *  \version 1.0
@@ -207,6 +214,8 @@ namespace dd4hep {
       typedef Geant4HitWrapper::HitManipulator Manip;
       /// Hit key map for fast random lookup
       typedef std::map<VolumeID, size_t>  Keys;
+      /// Hit position map for fast random lookup (hash of the position -> hit index)
+      typedef std::unordered_multimap<std::size_t, size_t>  Positions;
 
       /// Generic class template to compare/select hits in Geant4HitCollection objects
       /**
@@ -247,6 +256,8 @@ namespace dd4hep {
       size_t                           m_lastHit;
       /// Hit key map for fast random lookup
       Keys                             m_keys;
+      /// Hit position map for fast random lookup
+      Positions                        m_positions;
       /// Optimization flags
       CollectionFlags                  m_flags;
       
@@ -257,6 +268,17 @@ namespace dd4hep {
       void* findHit(const Compare& cmp);
       /// Find hit in a collection by comparison of the key
       Geant4HitWrapper* findHitByKey(VolumeID key);
+      /// Hash value of a hit position used by the position index
+      /** Positions comparing equal must have the same hash value: adding 0.0
+       *  maps -0.0 to +0.0. NaN coordinates never compare equal and are never found.
+       */
+      static std::size_t positionKey(double x, double y, double z)  {
+        std::hash<double> h;
+        std::size_t key = h(x + 0.0);
+        key ^= h(y + 0.0) + 0x9e3779b9 + (key<<6) + (key>>2);
+        key ^= h(z + 0.0) + 0x9e3779b9 + (key<<6) + (key>>2);
+        return key;
+      }
       /// Release all hits from the Geant4 container and pass ownership to the caller
       void releaseData(const ComponentCast& cast, std::vector<void*>* result);
       /// Release all hits from the Geant4 container. Ownership stays with the container
@@ -321,6 +343,10 @@ namespace dd4hep {
       virtual size_t GetSize() const {
         return m_hits.size();
       }
+      /// Index of the hit last added or found
+      size_t lastHitIndex() const {
+        return m_lastHit;
+      }
       /// Access the hit wrapper
       Geant4HitWrapper& hit(size_t which) {
         return m_hits.at(which);
@@ -346,6 +372,12 @@ namespace dd4hep {
         }
         throw std::runtime_error("Attempt to insert hit with same key to G4 hit-collection "+GetName());
       }
+      /// Add a new hit and register it to the position index. The hit position may not change afterwards
+      template <typename TYPE> void addByPosition(TYPE* hit_pointer) {
+        const auto& pos = hit_pointer->position;
+        m_positions.emplace(positionKey(pos.X(), pos.Y(), pos.Z()), m_hits.size());
+        add(hit_pointer);
+      }
       /// Find hits in a collection by comparison of attributes
       template <typename TYPE> TYPE* find(const Compare& cmp) {
         return (TYPE*) findHit(cmp);
@@ -358,6 +390,23 @@ namespace dd4hep {
         TYPE* obj = m_hits.at(m_lastHit);
         return obj;
       }
+      /// Find hits, which were added with addByPosition, by their position
+      /** Like find() with a PositionCompare the first hit added at this position is returned. */
+      template <typename TYPE, typename POSITION> TYPE* findByPosition(const POSITION& pos) {
+        auto range = m_positions.equal_range(positionKey(pos.X(), pos.Y(), pos.Z()));
+        TYPE*  found = 0;
+        size_t first = ULONG_MAX;
+        for( auto i = range.first; i != range.second; ++i )   {
+          if ( (*i).second > first ) continue;
+          TYPE* obj = m_hits.at((*i).second);
+          if ( obj && pos == obj->position )  {
+            first = (*i).second;
+            found = obj;
+          }
+        }
+        if ( found ) m_lastHit = first;
+        return found;
+      }
       /// Release all hits from the Geant4 container and pass ownership to the caller
       template <typename TYPE> std::vector<TYPE*> releaseHits() {
         std::vector<TYPE*> vec;
@@ -366,6 +415,7 @@ namespace dd4hep {
         }
         m_lastHit = ULONG_MAX;
         m_keys.clear();
+        m_positions.clear();
         return vec;
       }
       /// Release all hits from the Geant4 container and pass ownership to the caller
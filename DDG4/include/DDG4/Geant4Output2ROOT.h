@@ -30,6 +30,15 @@ namespace dd4hep {
 
     /// Class to output Geant4 event data to ROOT files
     /**
+     *  In multi-threaded mode with the property FilePerThread set, every worker
+     *  thread must own its instance of this action (non-shared event action).
+     *  Each instance writes the events of its thread to a separate file
+     *  (<output>.thread<NNN>.root) without locking the other threads.
+     *  One thread file is expected per worker thread (kernel property
+     *  NumberOfThreads). When all of them are closed, the thread files are merged
+     *  into the requested output file (property MergeThreadFiles). The thread
+     *  files are closed at the latest when the kernel terminates.
+     *
      *  \author  M.Frank
      *  \version 1.0
      *  \ingroup DD4HEP_SIMULATION
@@ -58,6 +67,29 @@ namespace dd4hep {
       bool m_handleMCTruth;
       /// Property: Flag if Monte-Carlo truth should be followed and checked
       bool m_filesByRun;
+      /// Property: Every worker thread writes its own output file
+      bool m_filePerThread;
+      /// Property: Merge the thread files into the output file once all threads closed them
+      bool m_mergeThreadFiles;
+      /// Property: Compression algorithm (ROOT::RCompressionSetting::EAlgorithm). -1: ROOT default
+      int  m_compressionAlgorithm;
+      /// Property: Compression level. -1: ROOT default
+      int  m_compressionLevel;
+      /// Property: Buffer size of the baskets of the event branches
+      int  m_basketSize;
+      /// Property: Auto-flush setting of the event tree (see TTree::SetAutoFlush)
+      long m_autoFlush;
+      /// Name of the merged output file if this instance writes a thread file
+      std::string m_mergeTarget;
+      /// Identifier of the thread owning the current output file
+      int  m_fileThread     { -1 };
+
+      /// Open the output file
+      void openOutput(const std::string& fname);
+      /// Merge the closed thread files into the output file
+      void mergeThreadFiles(const std::string& target, std::vector<std::string> inputs);
+      /// Close the thread files of all instances and merge them (called when the kernel terminates)
+      static void closeThreadFiles();
       
     public:
       /// Standard constructor
@@ -72,6 +72,8 @@ namespace dd4hep {
       //VolumeID volumeID(const std::vector<const G4VPhysicalVolume*>& path) const;
       /// Access CELLID by Geant4 touchable object
       VolumeID volumeID(const G4VTouchable* touchable) const;
+      /// Access CELLID by the placement path of the touchable without the path index (reference for checks)
+      VolumeID volumeIDByPath(const G4VTouchable* touchable) const;
       /// Accessfully decoded volume fields  by placement path
       void volumeDescriptor(const std::vector<const G4VPhysicalVolume*>& path,
                             std::pair<VolumeID,std::vector<std::pair<const BitFieldElement*, VolumeID> > >& volume_desc) const;
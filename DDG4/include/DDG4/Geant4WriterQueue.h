@@ -0,0 +1,87 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+//==========================================================================
+#ifndef DDG4_GEANT4WRITERQUEUE_H
+#define DDG4_GEANT4WRITERQUEUE_H
+
+// C/C++ include files
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <deque>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the Geant4 based simulation part of the AIDA detector description toolkit
+  namespace sim {
+
+    /// Single writer thread fed by a bounded queue of write requests
+    /**
+     *  Output actions convert the event data in the calling thread and
+     *  hand the final write to the writer thread. The requests are executed
+     *  in the order they were queued. If the queue is full the caller blocks
+     *  until the writer caught up, which limits the memory held by pending events.
+     *
+     *  An exception thrown by a request is rethrown to the caller of the
+     *  next call to push() or drain().
+     *
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4WriterQueue  {
+    public:
+      typedef std::function<void()> request_t;
+
+    protected:
+      /// Protection of the queue
+      std::mutex              m_lock;
+      /// Signal new requests and the stop of the queue
+      std::condition_variable m_pending;
+      /// Signal processed requests
+      std::condition_variable m_processed;
+      /// Queued requests
+      std::deque<request_t>   m_requests;
+      /// Maximal number of queued requests
+      std::size_t             m_capacity;
+      /// Flag if the writer is executing a request
+      bool                    m_busy  = false;
+      /// Flag to stop the writer thread
+      bool                    m_stop  = false;
+      /// First exception thrown by a request and not yet reported
+      std::exception_ptr      m_error;
+      /// The writer thread
+      std::thread             m_thread;
+
+      /// Writer thread: execute requests until stopped
+      void run();
+      /// Rethrow pending exception. Lock must be held
+      void rethrow();
+
+    public:
+      /// Initializing constructor. Starts the writer thread
+      Geant4WriterQueue(std::size_t capacity);
+      /// Inhibit copy constructor
+      Geant4WriterQueue(const Geant4WriterQueue& copy) = delete;
+      /// Default destructor. Executes all pending requests and stops the writer thread
+      ~Geant4WriterQueue();
+      /// Inhibit assignment
+      Geant4WriterQueue& operator=(const Geant4WriterQueue& copy) = delete;
+
+      /// Queue write request. Blocks while the queue is full
+      void push(request_t&& request);
+      /// Wait until all queued requests are executed
+      void drain();
+    };
+  }    // End namespace sim
+}      // End namespace dd4hep
+#endif // DDG4_GEANT4WRITERQUEUE_H
@@ -85,14 +85,38 @@ namespace dd4hep {
 
     /// Base class to output Geant4 event data to media
     /**
+     *  The event data are converted without locking. If the property
+     *  WriterQueueSize is non-zero, the events are written by a separate
+     *  writer thread fed by a bounded queue (see Geant4WriterQueue).
+     *  The LCIO event is then handed to the writer thread and removed
+     *  from the event context.
+     *
+     *  In multi-threaded mode the action may be created once per worker
+     *  thread (non-shared). All instances writing to the same file share one
+     *  output stream. Every thread fiber of an instance is registered as user
+     *  of the stream before the run starts. The run header is written by the
+     *  first instance starting the run. The file is closed when the kernel
+     *  terminates or the last user is destroyed.
+     *
      *  \author  M.Frank
      *  \author  R.Ete    (added event parameters treatment)
      *  \version 1.0
      *  \ingroup DD4HEP_SIMULATION
      */
     class Geant4Output2LCIO : public Geant4OutputAction  {
+    public:
+      /// Output file shared by all instances writing to the same file
+      class Stream;
+
     protected:
-      lcio::LCWriter*  m_file;
+      /// Output stream used by this instance
+      std::shared_ptr<Stream> m_stream;
+      /// Property: Size of the queue to the writer thread. 0: write in the calling thread
+      int              m_writerQueueSize;
+      /// Number of thread fibers registered as users of the output stream
+      int              m_numFibers;
+      /// Output name the thread fibers were registered for
+      std::string      m_fiberOutput;
       int              m_runNo;
       int              m_runNumberOffset;
       int              m_eventNumberOffset;
@@ -108,6 +132,8 @@ namespace dd4hep {
       Geant4Output2LCIO(Geant4Context* ctxt, const std::string& nam);
       /// Default destructor
       virtual ~Geant4Output2LCIO();
+      /// Set or update client for the use in a new thread fiber
+      virtual void configureFiber(Geant4Context* thread_context)  override;
       /// Callback to store the Geant4 run information
       virtual void beginRun(const G4Run* run);
       /// Callback to store the Geant4 run information
@@ -175,9 +201,11 @@ namespace dd4hep {
 #include "DDG4/Geant4HitCollection.h"
 #include "DDG4/Geant4DataConversion.h"
 #include "DDG4/Geant4Context.h"
+#include "DDG4/Geant4Kernel.h"
 #include "DDG4/Geant4Particle.h"
 #include "DDG4/Geant4Data.h"
 #include "DDG4/Geant4Action.h"
+#include "DDG4/Geant4WriterQueue.h"
 
 //#include "DDG4/Geant4Output2LCIO.h"
 #include "G4ParticleDefinition.hh"
@@ -198,8 +226,69 @@ namespace dd4hep {
 using namespace dd4hep::sim;
 using namespace dd4hep;
 using namespace std;
+
+/// Output file shared by all instances writing to the same file
+class Geant4Output2LCIO::Stream  {
+public:
+  /// File name
+  std::string                        name;
+  /// The LCIO writer
+  lcio::LCWriter*                    file     { nullptr };
+  /// Optional writer thread
+  std::unique_ptr<Geant4WriterQueue> queue;
+  /// Identifier of the last run written
+  int                                lastRun  { -1 };
+  /// Protection of the writer if no writer thread is used
+  std::mutex                         lock;
+
+  /// Execute write request
+  void execute(Geant4WriterQueue::request_t&& request)  {
+    if ( queue )  {
+      queue->push(std::move(request));
+      return;
+    }
+    std::lock_guard<std::mutex> protection(lock);
+    request();
+  }
+  /// Write all pending data and close the file
+  void close()  {
+    if ( !file )  {
+      return;
+    }
+    if ( queue )  {
+      queue->drain();
+      queue.reset();
+    }
+    file->close();
+    detail::deletePtr(file);
+  }
+};
+
 namespace {
+  /// Protection of the output stream registry
   G4Mutex action_mutex=G4MUTEX_INITIALIZER;
+  /// Output streams by file name
+  map<string, shared_ptr<Geant4Output2LCIO::Stream> >& output_streams()  {
+    static map<string, shared_ptr<Geant4Output2LCIO::Stream> > streams;
+    return streams;
+  }
+  /// Number of thread fibers writing to an output: registered before the run starts
+  map<string, int>& output_users()  {
+    static map<string, int> users;
+    return users;
+  }
+  /// Flag if the kernel closes the output streams on terminate
+  bool terminate_registered = false;
+  /// Close all output streams. The action instances live as long as the kernel
+  void close_streams()  {
+    map<string, shared_ptr<Geant4Output2LCIO::Stream> > streams;  {
+      G4AutoLock protection_lock(&action_mutex);
+      streams = std::move(output_streams());
+      output_streams().clear();
+    }
+    for( auto& s : streams )
+      s.second->close();
+  }
 }
 
 #include "DDG4/Factories.h"
@@ -207,7 +296,7 @@ DECLARE_GEANT4ACTION(Geant4Output2LCIO)
 
 /// Standard constructor
 Geant4Output2LCIO::Geant4Output2LCIO(Geant4Context* ctxt, const string& nam)
-: Geant4OutputAction(ctxt,nam), m_file(0), m_runNo(0), m_runNumberOffset(0), m_eventNumberOffset(0)
+: Geant4OutputAction(ctxt,nam), m_writerQueueSize(0), m_numFibers(0), m_runNo(0), m_runNumberOffset(0), m_eventNumberOffset(0)
 {
   declareProperty("RunHeader", m_runHeader);
   declareProperty("EventParametersInt",    m_eventParametersInt);
@@ -215,25 +304,58 @@ Geant4Output2LCIO::Geant4Output2LCIO(Geant4Context* ctxt, const string& nam)
   declareProperty("EventParametersString", m_eventParametersString);
   declareProperty("RunNumberOffset", m_runNumberOffset);
   declareProperty("EventNumberOffset", m_eventNumberOffset);
+  declareProperty("WriterQueueSize", m_writerQueueSize);
   InstanceCount::increment(this);
 }
 
 /// Default destructor
 Geant4Output2LCIO::~Geant4Output2LCIO()  {
-  G4AutoLock protection_lock(&action_mutex);
-  if ( m_file )  {
-    m_file->close();
-    detail::deletePtr(m_file);
+  if ( m_numFibers > 0 )  {
+    G4AutoLock protection_lock(&action_mutex);
+    // The last user closes the file
+    int& users = output_users()[m_fiberOutput];
+    users -= m_numFibers;
+    if ( users <= 0 && m_stream )  {
+      output_streams().erase(m_stream->name);
+      m_stream->close();
+    }
   }
+  m_stream.reset();
   InstanceCount::decrement(this);
 }
 
+/// Set or update client for the use in a new thread fiber
+void Geant4Output2LCIO::configureFiber(Geant4Context* thread_context)   {
+  Geant4OutputAction::configureFiber(thread_context);
+  G4AutoLock protection_lock(&action_mutex);
+  m_fiberOutput = m_output;
+  ++output_users()[m_fiberOutput];
+  ++m_numFibers;
+}
+
 // Callback to store the Geant4 run information
 void Geant4Output2LCIO::beginRun(const G4Run* run)  {
-  if ( 0 == m_file && !m_output.empty() )   {
+  if ( !m_output.empty() )   {
+    // A shared instance acquires the stream once: the first thread fiber starting the run
     G4AutoLock protection_lock(&action_mutex);
-    m_file = lcio::LCFactory::getInstance()->createLCWriter();
-    m_file->open(m_output,lcio::LCIO::WRITE_NEW);
+    if ( !m_stream )  {
+      auto& stream = output_streams()[m_output];
+      if ( !stream )  {
+        auto new_stream  = make_shared<Stream>();
+        new_stream->name = m_output;
+        new_stream->file = lcio::LCFactory::getInstance()->createLCWriter();
+        new_stream->file->open(m_output,lcio::LCIO::WRITE_NEW);
+        if ( m_writerQueueSize > 0 )  {
+          new_stream->queue = make_unique<Geant4WriterQueue>(m_writerQueueSize);
+        }
+        stream = new_stream;
+        if ( !terminate_registered )  {
+          terminate_registered = true;
+          context()->kernel().master().register_terminate(close_streams);
+        }
+      }
+      m_stream = stream;
+    }
   }
   
   saveRun(run);
@@ -246,10 +368,17 @@ void Geant4Output2LCIO::endRun(const G4Run* /*run*/)  {
 
 /// Commit data at end of filling procedure
 void Geant4Output2LCIO::commit( OutputContext<G4Event>& /* ctxt */)   {
-  lcio::LCEventImpl* e = context()->event().extension<lcio::LCEventImpl>();
-  if ( m_file )   {
-    G4AutoLock protection_lock(&action_mutex);
-    m_file->writeEvent(e);
+  if ( m_stream )   {
+    lcio::LCWriter* writer = m_stream->file;
+    if ( m_stream->queue )  {
+      // The writer thread takes over the event from the event context
+      void* ptr = context()->event().removeExtension(detail::typeHash64<lcio::LCEventImpl>(), false);
+      shared_ptr<lcio::LCEventImpl> e((lcio::LCEventImpl*)ptr);
+      m_stream->execute([writer, e] { writer->writeEvent(e.get()); });
+      return;
+    }
+    lcio::LCEventImpl* e = context()->event().extension<lcio::LCEventImpl>();
+    m_stream->execute([writer, e] { writer->writeEvent(e); });
     return;
   }
   except("+++ Failed to write output file. [Stream is not open]");
@@ -257,13 +386,15 @@ void Geant4Output2LCIO::commit( OutputContext<G4Event>& /* ctxt */)   {
 
 /// Callback to store the Geant4 run information
 void Geant4Output2LCIO::saveRun(const G4Run* run)  {
-  G4AutoLock protection_lock(&action_mutex);
+  m_runNo = m_runNumberOffset > 0 ? m_runNumberOffset + run->GetRunID() : run->GetRunID();
+  if ( !m_stream )  {
+    return;
+  }
   // --- write an lcio::RunHeader ---------
   lcio::LCRunHeaderImpl* rh =  new lcio::LCRunHeaderImpl;
   for (std::map< std::string, std::string >::iterator it = m_runHeader.begin(); it != m_runHeader.end(); ++it) {
     rh->parameters().setValue( it->first, it->second );
   }
-  m_runNo = m_runNumberOffset > 0 ? m_runNumberOffset + run->GetRunID() : run->GetRunID();
   rh->parameters().setValue("GEANT4Version", G4Version);
   rh->parameters().setValue("DD4HEPVersion", versionString());
   rh->setRunNumber(m_runNo);
@@ -272,7 +403,15 @@ void Geant4Output2LCIO::saveRun(const G4Run* run)  {
   if (parameters) {
     parameters->extractParameters(*rh);
   }
-  m_file->writeRunHeader(rh);
+  shared_ptr<lcio::LCRunHeaderImpl> header(rh);
+  lcio::LCWriter* writer = m_stream->file;
+  // The run header is written once by the first instance starting the run.
+  // It is queued under the lock: no other instance may write this run before the header.
+  G4AutoLock protection_lock(&action_mutex);
+  if ( m_stream->lastRun == run->GetRunID() )
+    return;
+  m_stream->lastRun = run->GetRunID();
+  m_stream->execute([writer, header] { writer->writeRunHeader(header.get()); });
 }
 
 void Geant4Output2LCIO::begin(const G4Event* /* event */)  {
@@ -13,6 +13,7 @@
 
 // Framework include files
 #include "DDG4/Geant4SensDetAction.inl"
+#include "DDG4/Geant4ContributionArena.h"
 #include "DDG4/Geant4FastSimHandler.h"
 #include "DDG4/Geant4EventAction.h"
 #include "G4OpticalPhoton.hh"
@@ -218,14 +219,105 @@ namespace dd4hep {
      *
      * @}
      */
+    /// User data of the calorimeter actions: hit truth storage
+    /**
+     *  Property "UseTruthArena": collect the hit contributions during the event
+     *  in a Geant4ContributionArena and attach them to the hits at the end of the event.
+     *  Property "TruthCompaction": merge the contributions of the same track to one hit
+     *  (see Geant4ContributionArena::Compaction). Implies the usage of the arena.
+     *
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    struct Geant4CalorimeterTruth  {
+      typedef Geant4Calorimeter::Hit Hit;
+      /// Event scoped contribution storage
+      Geant4ContributionArena arena;
+      /// Property: Use the contribution arena
+      bool enabled  { false };
+      /// Arena in use for the current event
+      bool active   { false };
+      /// Collection index of the last accessed hit
+      std::size_t current { 0 };
+
+      /// Declare the properties to the owning action
+      void declare(Geant4Action* action)  {
+        action->declareProperty("UseTruthArena",   enabled);
+        action->declareProperty("TruthCompaction", arena.compaction);
+      }
+      /// Start of event: reset the arena
+      void begin()  {
+        arena.clear();
+        active = enabled || arena.compaction != Geant4ContributionArena::KEEP_ALL_CONTRIBUTIONS;
+      }
+      /// End of event: move the pending contributions to the hits
+      void end(Geant4Sensitive* sensitive)  {
+        if ( active )  {
+          std::size_t num_hits = arena.numHits();
+          std::size_t num_contrib = arena.flush();
+          sensitive->info("+++ Attached %ld contributions to %ld hits [%ld merged in total]",
+                          num_contrib, num_hits, arena.numMerged());
+        }
+      }
+      /// Locate the hit of a given cell using the key index of the collection
+      Hit* find(Geant4HitCollection* coll, VolumeID cell)  {
+        Hit* hit = coll->findByKey<Hit>(cell);
+        if ( hit && active )  {
+          current = coll->lastHitIndex();
+          if ( arena.hit(current) != hit ) arena.adopt(current, hit);
+        }
+        return hit;
+      }
+      /// Register a newly created hit
+      void add(Geant4HitCollection* coll, Hit* hit)  {
+        coll->add(hit->cellID, hit);
+        if ( active )  {
+          current = coll->lastHitIndex();
+          arena.adopt(current, hit);
+        }
+      }
+      /// Add a contribution to the hit returned by the last call to find() or add()
+      void contribute(Hit* hit, const HitContribution& contrib)  {
+        if ( active )  {
+          arena.add(current, contrib);
+          return;
+        }
+        hit->truth.emplace_back(contrib);
+        hit->energyDeposit += contrib.deposit;
+      }
+    };
+
+    /// Initialization overload for specialization
+    template <> void Geant4SensitiveAction<Geant4CalorimeterTruth>::initialize() {
+      m_userData.declare(this);
+    }
+
+    /// G4VSensitiveDetector interface: Method invoked at the begining of each event.
+    template <> void Geant4SensitiveAction<Geant4CalorimeterTruth>::begin(G4HCofThisEvent* hce) {
+      m_userData.begin();
+      Geant4Sensitive::begin(hce);
+    }
+
+    /// G4VSensitiveDetector interface: Method invoked at the end of each event.
+    template <> void Geant4SensitiveAction<Geant4CalorimeterTruth>::end(G4HCofThisEvent* hce) {
+      m_userData.end(this);
+      Geant4Sensitive::end(hce);
+    }
+
+    /// G4VSensitiveDetector interface: Method invoked if the event was aborted.
+    template <> void Geant4SensitiveAction<Geant4CalorimeterTruth>::clear(G4HCofThisEvent* hce) {
+      m_userData.arena.clear();
+      Geant4Sensitive::clear(hce);
+    }
+
     /// Define collections created by this sensitivie action object
-    template <> void Geant4SensitiveAction<Geant4Calorimeter>::defineCollections() {
+    template <> void Geant4SensitiveAction<Geant4CalorimeterTruth>::defineCollections() {
       m_collectionID = declareReadoutFilteredCollection<Geant4Calorimeter::Hit>();
     }
 
     /// Method for generating hit(s) using the information of G4Step object.
     template <> bool
-    Geant4SensitiveAction<Geant4Calorimeter>::process(const G4Step* step,G4TouchableHistory*) {
+    Geant4SensitiveAction<Geant4CalorimeterTruth>::process(const G4Step* step,G4TouchableHistory*) {
       typedef Geant4Calorimeter::Hit Hit;
       Geant4StepHandler    h(step);
       HitContribution      contrib = Hit::extractContribution(step);
@@ -251,14 +343,14 @@ namespace dd4hep {
       }
 
       //Hit* hit = coll->find<Hit>(CellIDCompare<Hit>(cell));
-      Hit* hit = coll->findByKey<Hit>(cell);
+      Hit* hit = m_userData.find(coll, cell);
       if ( !hit ) {
         Geant4TouchableHandler handler(step);
         DDSegmentation::Vector3D pos = m_segmentation.position(cell);
         Position global = h.localToGlobal(pos);
         hit = new Hit(global);
         hit->cellID = cell;
-        coll->add(cell, hit);
+        m_userData.add(coll, hit);
         printM2("%s> CREATE hit with deposit:%e MeV  Pos:%8.2f %8.2f %8.2f  %s  [%s]",
                 c_name(),contrib.deposit,pos.X,pos.Y,pos.Z,handler.path().c_str(),
                 coll->GetName().c_str());
@@ -267,14 +359,13 @@ namespace dd4hep {
           except("+++ Invalid CELL ID for hit!");
         }
       }
-      hit->truth.emplace_back(contrib);
-      hit->energyDeposit += contrib.deposit;
+      m_userData.contribute(hit, contrib);
       mark(h.track);
       return true;
     }
     /// GFlash/FastSim interface: Method for generating hit(s) using the information of Geant4FastSimSpot object.
     template <> bool
-    Geant4SensitiveAction<Geant4Calorimeter>::processFastSim(const Geant4FastSimSpot* spot,
+    Geant4SensitiveAction<Geant4CalorimeterTruth>::processFastSim(const Geant4FastSimSpot* spot,
 							     G4TouchableHistory* /* hist */)
     {
       typedef Geant4Calorimeter::Hit Hit;
@@ -294,14 +385,14 @@ namespace dd4hep {
         std::cout << out.str();
         return true;
       }
-      Hit* hit = coll->findByKey<Hit>(cell);
+      Hit* hit = m_userData.find(coll, cell);
       if ( !hit ) {
 	Geant4TouchableHandler   handler(h.touchable());
         DDSegmentation::Vector3D pos = m_segmentation.position(cell);
         Position global = h.localToGlobal(pos);
         hit = new Hit(global);
         hit->cellID = cell;
-        coll->add(cell, hit);
+        m_userData.add(coll, hit);
         printM2("%s> CREATE hit with deposit:%e MeV  Pos:%8.2f %8.2f %8.2f  %s  [%s]",
                 c_name(),contrib.deposit,pos.X,pos.Y,pos.Z,handler.path().c_str(),
                 coll->GetName().c_str());
@@ -310,13 +401,12 @@ namespace dd4hep {
           except("+++ Invalid CELL ID for hit!");
         }
       }
-      hit->truth.emplace_back(contrib);
-      hit->energyDeposit += contrib.deposit;
+      m_userData.contribute(hit, contrib);
       mark(h.track);
       return true;
     }
 
-    typedef Geant4SensitiveAction<Geant4Calorimeter> Geant4CalorimeterAction;
+    typedef Geant4SensitiveAction<Geant4CalorimeterTruth> Geant4CalorimeterAction;
 
     // ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
     //               Geant4SensitiveAction<OpticalCalorimeter>
@@ -359,11 +449,11 @@ namespace dd4hep {
         Geant4HitCollection*  coll    = collection(m_collectionID);
         HitContribution       contrib = Hit::extractContribution(step);
         Position              pos     = h.prePos();
-        Hit* hit = coll->find<Hit>(PositionCompare<Hit,Position>(pos));
+        Hit* hit = coll->findByPosition<Hit>(pos);
         if ( !hit ) {
           hit = new Hit(pos);
           hit->cellID = volumeID(step);
-          coll->add(hit);
+          coll->addByPosition(hit);
           if ( 0 == hit->cellID )  {
             hit->cellID = volumeID(step);
             except("+++ Invalid CELL ID for hit!");
@@ -395,11 +485,11 @@ namespace dd4hep {
         Geant4HitCollection* coll = collection(m_collectionID);
         HitContribution   contrib = Hit::extractContribution(spot);
         Position          pos     = h.avgPosition();
-        Hit* hit = coll->find<Hit>(PositionCompare<Hit,Position>(pos));
+        Hit* hit = coll->findByPosition<Hit>(pos);
         if ( !hit ) {
           hit = new Hit(pos);
           hit->cellID = volumeID(h.touchable());
-          coll->add(hit);
+          coll->addByPosition(hit);
           if ( 0 == hit->cellID )  {
             hit->cellID = volumeID(h.touchable());
             except("+++ Invalid CELL ID for hit!");
@@ -431,7 +521,30 @@ namespace dd4hep {
      * @}
      */
     /// Class to implement the standard sensitive detector for scintillator calorimeters
-    struct Geant4ScintillatorCalorimeter {};
+    struct Geant4ScintillatorCalorimeter : public Geant4CalorimeterTruth {};
+
+    /// Initialization overload for specialization
+    template <> void Geant4SensitiveAction<Geant4ScintillatorCalorimeter>::initialize() {
+      m_userData.declare(this);
+    }
+
+    /// G4VSensitiveDetector interface: Method invoked at the begining of each event.
+    template <> void Geant4SensitiveAction<Geant4ScintillatorCalorimeter>::begin(G4HCofThisEvent* hce) {
+      m_userData.begin();
+      Geant4Sensitive::begin(hce);
+    }
+
+    /// G4VSensitiveDetector interface: Method invoked at the end of each event.
+    template <> void Geant4SensitiveAction<Geant4ScintillatorCalorimeter>::end(G4HCofThisEvent* hce) {
+      m_userData.end(this);
+      Geant4Sensitive::end(hce);
+    }
+
+    /// G4VSensitiveDetector interface: Method invoked if the event was aborted.
+    template <> void Geant4SensitiveAction<Geant4ScintillatorCalorimeter>::clear(G4HCofThisEvent* hce) {
+      m_userData.arena.clear();
+      Geant4Sensitive::clear(hce);
+    }
 
     /// Define collections created by this sensitivie action object
     template <> void Geant4SensitiveAction<Geant4ScintillatorCalorimeter>::defineCollections() {
@@ -462,14 +575,14 @@ namespace dd4hep {
         std::cout << out.str();
         return true;
       }
-      Hit* hit = coll->findByKey<Hit>(cell);
+      Hit* hit = m_userData.find(coll, cell);
       if ( !hit ) {
         Geant4TouchableHandler handler(step);
         DDSegmentation::Vector3D pos = m_segmentation.position(cell);
         Position global = h.localToGlobal(pos);
         hit = new Hit(global);
         hit->cellID = cell;
-        coll->add(cell, hit);
+        m_userData.add(coll, hit);
         printM2("CREATE hit with deposit:%e MeV  Pos:%8.2f %8.2f %8.2f  %s",
                 contrib.deposit,pos.X,pos.Y,pos.Z,handler.path().c_str());
         if ( 0 == hit->cellID )  { // for debugging only!
@@ -477,8 +590,7 @@ namespace dd4hep {
           except("+++ Invalid CELL ID for hit!");
         }
       }
-      hit->truth.emplace_back(contrib);
-      hit->energyDeposit += contrib.deposit;
+      m_userData.contribute(hit, contrib);
       mark(h.track);
       return true;
     }
@@ -505,14 +617,14 @@ namespace dd4hep {
         std::cout << out.str();
         return true;
       }
-      Hit* hit = coll->findByKey<Hit>(cell);
+      Hit* hit = m_userData.find(coll, cell);
       if ( !hit ) {
 	Geant4TouchableHandler   handler(h.touchable());
         DDSegmentation::Vector3D pos = m_segmentation.position(cell);
         Position global = h.localToGlobal(pos);
         hit = new Hit(global);
         hit->cellID = cell;
-        coll->add(cell, hit);
+        m_userData.add(coll, hit);
         printM2("CREATE hit with deposit:%e MeV  Pos:%8.2f %8.2f %8.2f  %s",
                 contrib.deposit,pos.X,pos.Y,pos.Z,handler.path().c_str());
         if ( 0 == hit->cellID )  { // for debugging only!
@@ -520,8 +632,7 @@ namespace dd4hep {
           except("+++ Invalid CELL ID for hit!");
         }
       }
-      hit->truth.emplace_back(contrib);
-      hit->energyDeposit += contrib.deposit;
+      m_userData.contribute(hit, contrib);
       mark(h.track);
       return true;
     }
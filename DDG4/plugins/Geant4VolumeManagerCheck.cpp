@@ -0,0 +1,152 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+//==========================================================================
+#ifndef DD4HEP_DDG4_GEANT4VOLUMEMANAGERCHECK_H
+#define DD4HEP_DDG4_GEANT4VOLUMEMANAGERCHECK_H
+
+// Framework include files
+#include <DDG4/Geant4RunAction.h>
+#include <DDG4/Geant4VolumeManager.h>
+
+// Forward declarations
+class G4NavigationHistory;
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the Geant4 based simulation part of the AIDA detector description toolkit
+  namespace sim {
+
+    /// Check the volume identifiers of the hashed path index against the placement path lookup
+    /** At the start of each run all touchables of the Geant4 geometry are visited.
+     *  Every copy of replicated and parametrised volumes is a separate touchable.
+     *  For each of them the fast lookup Geant4VolumeManager::volumeID() must
+     *  give the same result as the lookup by the placement path.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4VolumeManagerCheck : public Geant4RunAction {
+    protected:
+      /// Property: Maximal number of differences to be printed
+      long m_maxPrint = 10;
+      /// Number of checked touchables
+      long m_numChecked = 0;
+      /// Number of checked touchables with a volume identifier
+      long m_numSensitive = 0;
+      /// Number of checked touchables inside replicated or parametrised volumes
+      long m_numReplicated = 0;
+      /// Number of differences between both lookups
+      long m_numBad = 0;
+
+      /// Check the touchable of the current level and descend into the daughter volumes
+      void check(Geant4VolumeManager& mgr, G4NavigationHistory& history, bool replicated);
+
+    public:
+      /// Standard constructor
+      Geant4VolumeManagerCheck(Geant4Context* context, const std::string& name);
+      /// Default destructor
+      virtual ~Geant4VolumeManagerCheck();
+      /// Begin-of-run callback: check all touchables
+      virtual void begin(const G4Run* run)  override;
+    };
+  }    // End namespace sim
+}      // End namespace dd4hep
+#endif // DD4HEP_DDG4_GEANT4VOLUMEMANAGERCHECK_H
+
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+//==========================================================================
+
+// Framework include files
+#include <DD4hep/InstanceCount.h>
+#include <DDG4/Geant4Mapping.h>
+#include <DDG4/Geant4TouchableHandler.h>
+
+// Geant4 include files
+#include <G4TransportationManager.hh>
+#include <G4NavigationHistory.hh>
+#include <G4TouchableHistory.hh>
+#include <G4VPhysicalVolume.hh>
+#include <G4LogicalVolume.hh>
+#include <G4Navigator.hh>
+
+using namespace dd4hep::sim;
+
+/// Standard constructor
+Geant4VolumeManagerCheck::Geant4VolumeManagerCheck(Geant4Context* ctxt, const std::string& nam)
+  : Geant4RunAction(ctxt, nam)
+{
+  declareProperty("MaxPrint", m_maxPrint);
+  InstanceCount::increment(this);
+}
+
+/// Default destructor
+Geant4VolumeManagerCheck::~Geant4VolumeManagerCheck()   {
+  InstanceCount::decrement(this);
+}
+
+/// Check the touchable of the current level and descend into the daughter volumes
+void Geant4VolumeManagerCheck::check(Geant4VolumeManager& mgr, G4NavigationHistory& history, bool replicated)   {
+  G4TouchableHistory touchable(history);
+  VolumeID fast = mgr.volumeID(&touchable);
+  VolumeID slow = mgr.volumeIDByPath(&touchable);
+  ++m_numChecked;
+  if ( replicated ) ++m_numReplicated;
+  if ( slow != Geant4VolumeManager::Insensitive && slow != Geant4VolumeManager::NonExisting &&
+       slow != Geant4VolumeManager::InvalidPath )
+    ++m_numSensitive;
+  if ( fast != slow && ++m_numBad <= m_maxPrint )   {
+    error("+++ Volume ID differs: indexed:%016llX placement path:%016llX %s",
+          (unsigned long long)fast, (unsigned long long)slow,
+          Geant4TouchableHandler(&touchable).path().c_str());
+  }
+  const G4LogicalVolume* vol = history.GetTopVolume()->GetLogicalVolume();
+  for( std::size_t i=0, n=vol->GetNoDaughters(); i < n; ++i )   {
+    G4VPhysicalVolume* daughter = vol->GetDaughter(i);
+    if ( daughter->IsReplicated() )   {
+      /// Every copy of a replica or a parametrisation is a separate touchable
+      for( int copy=0, num=daughter->GetMultiplicity(); copy < num; ++copy )   {
+        history.NewLevel(daughter, daughter->VolumeType(), copy);
+        check(mgr, history, true);
+        history.BackLevel();
+      }
+      continue;
+    }
+    history.NewLevel(daughter, kNormal, daughter->GetCopyNo());
+    check(mgr, history, replicated);
+    history.BackLevel();
+  }
+}
+
+/// Begin-of-run callback: check all touchables
+void Geant4VolumeManagerCheck::begin(const G4Run* /* run */)   {
+  G4Navigator* navigator = G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
+  G4VPhysicalVolume* world = navigator->GetWorldVolume();
+  Geant4VolumeManager mgr = Geant4Mapping::instance().volumeManager();
+  G4NavigationHistory history;
+  m_numChecked = m_numSensitive = m_numReplicated = m_numBad = 0;
+  history.SetFirstEntry(world);
+  check(mgr, history, false);
+  bool ok = m_numBad == 0 && m_numSensitive > 0;
+  always("+++ Test %s: Checked %ld touchables, %ld with volume ID, %ld in replicas. Differences: %ld",
+         ok ? "PASSED" : "FAILED", m_numChecked, m_numSensitive, m_numReplicated, m_numBad);
+}
+
+#include <DDG4/Factories.h>
+DECLARE_GEANT4ACTION(Geant4VolumeManagerCheck)
@@ -758,14 +758,19 @@ class Geant4:
       self.kernel().generatorAction().add(gun)
     return gun
 
-  def setupROOTOutput(self, name, output, mc_truth=True):
+  def setupROOTOutput(self, name, output, mc_truth=True, file_per_thread=False):
     """
     Configure ROOT output for the simulated events
 
+    If file_per_thread is set, every worker thread writes its own file.
+    The thread files are merged into the output file at the end.
+    Must then be called for each worker thread (see DDG4/examples/SiDSim_MT.py).
+
     \author  M.Frank
     """
-    evt_root = EventAction(self.kernel(), 'Geant4Output2ROOT/' + name, True)
+    evt_root = EventAction(self.kernel(), 'Geant4Output2ROOT/' + name, not file_per_thread)
     evt_root.HandleMCTruth = mc_truth
+    evt_root.FilePerThread = file_per_thread
     evt_root.Control = True
     if not output.endswith('.root'):
       output = output + '.root'
@@ -774,22 +779,29 @@ class Geant4:
     self.kernel().eventAction().add(evt_root)
     return evt_root
 
-  def setupLCIOOutput(self, name, output):
+  def setupLCIOOutput(self, name, output, shared=True):
     """
     Configure LCIO output for the simulated events
 
+    If shared is False, the conversion runs in every worker thread without locking
+    and all instances write to the same file. Must then be called for each worker thread.
+
     \author  M.Frank
     """
-    evt_lcio = EventAction(self.kernel(), 'Geant4Output2LCIO/' + name, True)
+    evt_lcio = EventAction(self.kernel(), 'Geant4Output2LCIO/' + name, shared)
     evt_lcio.Control = True
     evt_lcio.Output = output
     evt_lcio.enableUI()
     self.kernel().eventAction().add(evt_lcio)
     return evt_lcio
 
-  def setupEDM4hepOutput(self, name, output):
-    """Configure EDM4hep root output for the simulated events."""
-    evt_edm4hep = EventAction(self.kernel(), 'Geant4Output2EDM4hep/' + name, True)
+  def setupEDM4hepOutput(self, name, output, shared=True):
+    """Configure EDM4hep root output for the simulated events.
+
+    If shared is False, the conversion runs in every worker thread without locking
+    and all instances write to the same file. Must then be called for each worker thread.
+    """
+    evt_edm4hep = EventAction(self.kernel(), 'Geant4Output2EDM4hep/' + name, shared)
     evt_edm4hep.Control = True
     evt_edm4hep.Output = output
     evt_edm4hep.enableUI()
@@ -0,0 +1,121 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+//==========================================================================
+
+// Framework include files
+#include <DDG4/Geant4ContributionArena.h>
+
+using namespace dd4hep::sim;
+
+namespace {
+  /// End of a contribution chain
+  const std::uint32_t END_OF_CHAIN = ~std::uint32_t(0);
+  /// Maximal number of contributions per hit merged without track map
+  const std::size_t   SHORT_CHAIN  = 16;
+}
+
+/// Merge contribution of the same track
+void Geant4ContributionArena::merge(Contribution& target, const Contribution& source)   {
+  double deposit = target.deposit + source.deposit;
+  if ( deposit > 0e0 )  {
+    double w_t = target.deposit / deposit, w_s = source.deposit / deposit;
+    target.setPosition(w_t*target.x + w_s*source.x,
+                       w_t*target.y + w_s*source.y,
+                       w_t*target.z + w_s*source.z);
+  }
+  if ( source.time < target.time ) target.time = source.time;
+  target.length += source.length;
+  target.deposit = deposit;
+}
+
+/// Register hit with its index in the hit collection. The hit is owned by the collection
+void Geant4ContributionArena::adopt(std::size_t which, Hit* hit)   {
+  if ( which >= m_blocks.size() )
+    m_blocks.resize(which+1, Block{nullptr, END_OF_CHAIN, END_OF_CHAIN, 0});
+  m_blocks[which] = Block{hit, END_OF_CHAIN, END_OF_CHAIN, 0};
+  ++m_numHits;
+}
+
+/// Add contribution to the hit with the given index and update its energy deposit
+void Geant4ContributionArena::add(std::size_t which, const Contribution& contrib)   {
+  Block& b = m_blocks[which];
+  b.hit->energyDeposit += contrib.deposit;
+  // Consecutive steps of one track in one cell are the common case: merge immediately
+  if ( compaction == MERGE_TRACK_CONTRIBUTIONS && b.count > 0 &&
+       m_contributions[b.last].trackID == contrib.trackID )  {
+    merge(m_contributions[b.last], contrib);
+    ++m_numMerged;
+    return;
+  }
+  std::uint32_t idx = std::uint32_t(m_contributions.size());
+  m_contributions.emplace_back(contrib);
+  m_next.emplace_back(END_OF_CHAIN);
+  if ( b.count == 0 )
+    b.first = idx;
+  else
+    m_next[b.last] = idx;
+  b.last = idx;
+  ++b.count;
+}
+
+/// Move the pending contributions to the hits and reset the arena
+std::size_t Geant4ContributionArena::flush()   {
+  std::size_t num_contrib = 0;
+  for( const Block& b : m_blocks )  {
+    if ( !b.hit ) continue;
+    Hit::Contributions& truth = b.hit->truth;
+    truth.reserve(truth.size() + b.count);
+    if ( compaction == MERGE_TRACK_CONTRIBUTIONS )  {
+      // Short chains are searched linearly, long ones through the track map
+      bool use_map = truth.size() + b.count > SHORT_CHAIN;
+      if ( use_map )  {
+        m_tracks.clear();
+        for( std::size_t i = 0; i < truth.size(); ++i )
+          m_tracks.emplace(truth[i].trackID, i);
+      }
+      for( std::uint32_t i = b.first; i != END_OF_CHAIN; i = m_next[i] )  {
+        const Contribution& c = m_contributions[i];
+        std::size_t match = truth.size();
+        if ( use_map )  {
+          match = m_tracks.emplace(c.trackID, truth.size()).first->second;
+        }
+        else  {
+          for( std::size_t j = 0; j < truth.size(); ++j )  {
+            if ( truth[j].trackID == c.trackID )  {
+              match = j;
+              break;
+            }
+          }
+        }
+        if ( match == truth.size() )  {
+          truth.emplace_back(c);
+          continue;
+        }
+        merge(truth[match], c);
+        ++m_numMerged;
+      }
+    }
+    else  {
+      for( std::uint32_t i = b.first; i != END_OF_CHAIN; i = m_next[i] )
+        truth.emplace_back(m_contributions[i]);
+    }
+    num_contrib += b.count;
+  }
+  clear();
+  return num_contrib;
+}
+
+/// Drop all pending contributions without touching the hits
+void Geant4ContributionArena::clear()   {
+  m_contributions.clear();
+  m_next.clear();
+  m_blocks.clear();
+  m_numHits = 0;
+}
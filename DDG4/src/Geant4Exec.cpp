@@ -42,6 +42,9 @@
 #include <G4VUserActionInitialization.hh>
 #include <G4VUserDetectorConstruction.hh>
 
+// ROOT include files
+#include <TROOT.h>
+
 // C/C++ include files
 #include <memory>
 #include <stdexcept>
@@ -559,6 +562,10 @@ int Geant4Exec::configure(Geant4Kernel& kernel) {
     rndm->initialize();
   }
   Geant4Random::setMainInstance(rndm);
+  /// Worker threads may write ROOT files concurrently: ROOT must be prepared before they start
+  if ( kernel.isMultiThreaded() )  {
+    ROOT::EnableThreadSafety();
+  }
   kernel.executePhase("configure",0);
 
   /// Construct the default run manager
@@ -18,11 +18,13 @@
 #include <DDG4/Geant4HitCollection.h>
 #include <DDG4/Geant4Output2ROOT.h>
 #include <DDG4/Geant4Particle.h>
+#include <DDG4/Geant4Kernel.h>
 #include <DDG4/Geant4Data.h>
 
 // Geant4 include files
 #include <G4HCofThisEvent.hh>
 #include <G4ParticleTable.hh>
+#include <G4Threading.hh>
 #include <G4Run.hh>
 
 // ROOT include files
@@ -30,10 +32,47 @@
 #include <TTree.h>
 #include <TBranch.h>
 #include <TSystem.h>
+#include <TFileMerger.h>
 
+// C/C++ include files
+#include <algorithm>
+#include <mutex>
+#include <set>
 
 using namespace dd4hep::sim;
 
+namespace {
+  /// Bookkeeping of the thread files to be merged into one output file
+  struct ThreadFiles  {
+    /// Thread files of one output file
+    struct Target  {
+      /// Number of thread files to be merged: one per worker thread
+      std::size_t              expected = 0;
+      /// Names of the closed thread files
+      std::vector<std::string> closed;
+      /// Instance which closed the last thread file
+      Geant4Output2ROOT*       owner = nullptr;
+    };
+    std::mutex                    lock;
+    std::map<std::string, Target> targets;
+    /// Instances with an open thread file
+    std::set<Geant4Output2ROOT*>  writers;
+    /// Flag if the kernel closes the thread files on terminate
+    bool                          terminateRegistered = false;
+  };
+  ThreadFiles& thread_files()   {
+    static ThreadFiles files;
+    return files;
+  }
+  /// Insert a tag in front of the file name extension
+  std::string tagged_name(const std::string& fname, const std::string& tag)   {
+    size_t idx = fname.rfind(".");
+    if ( idx == std::string::npos )
+      return fname + tag;
+    return fname.substr(0, idx) + tag + fname.substr(idx);
+  }
+}
+
 /// Standard constructor
 Geant4Output2ROOT::Geant4Output2ROOT(Geant4Context* ctxt, const std::string& nam)
   : Geant4OutputAction(ctxt, nam), m_file(nullptr), m_tree(nullptr) {
@@ -42,6 +81,12 @@ Geant4Output2ROOT::Geant4Output2ROOT(Geant4Context* ctxt, const std::string& nam
   declareProperty("DisabledCollections",  m_disabledCollections);
   declareProperty("DisableParticles",     m_disableParticles);
   declareProperty("FilesByRun",           m_filesByRun = false);
+  declareProperty("FilePerThread",        m_filePerThread = false);
+  declareProperty("MergeThreadFiles",     m_mergeThreadFiles = true);
+  declareProperty("CompressionAlgorithm", m_compressionAlgorithm = -1);
+  declareProperty("CompressionLevel",     m_compressionLevel = -1);
+  declareProperty("BasketSize",           m_basketSize = 32000);
+  declareProperty("AutoFlush",            m_autoFlush = -30000000);
   InstanceCount::increment(this);
 }
 
@@ -56,7 +101,8 @@ void Geant4Output2ROOT::closeOutput()   {
   if (m_file) {
     TDirectory::TContext ctxt(m_file);
     Sections::iterator i = m_sections.find(m_section);
-    info("+++ Closing ROOT output file %s", m_file->GetName());
+    std::string fname = m_file->GetName();
+    info("+++ Closing ROOT output file %s", fname.c_str());
     if ( i != m_sections.end() )
       m_sections.erase(i);
     m_branches.clear();
@@ -64,6 +110,135 @@ void Geant4Output2ROOT::closeOutput()   {
     m_file->Close();
     m_tree = nullptr;
     detail::deletePtr (m_file);
+    if ( !m_mergeTarget.empty() )  {
+      std::vector<std::string> inputs;
+      ThreadFiles& files = thread_files();  {
+        std::lock_guard<std::mutex> lock(files.lock);
+        ThreadFiles::Target& target = files.targets[m_mergeTarget];
+        files.writers.erase(this);
+        target.closed.emplace_back(fname);
+        target.owner = this;
+        // The thread closing the last of the expected files collects all of them.
+        // Counting the open files instead would merge early if one thread finishes
+        // the run before a slower thread opened its file.
+        if ( target.closed.size() >= target.expected )  {
+          inputs = std::move(target.closed);
+          files.targets.erase(m_mergeTarget);
+        }
+      }
+      if ( !inputs.empty() && m_mergeThreadFiles )  {
+        mergeThreadFiles(m_mergeTarget, std::move(inputs));
+      }
+      m_mergeTarget.clear();
+    }
+  }
+}
+
+/// Close the thread files of all instances and merge them
+void Geant4Output2ROOT::closeThreadFiles()   {
+  ThreadFiles& files = thread_files();
+  std::vector<Geant4Output2ROOT*> writers;  {
+    std::lock_guard<std::mutex> lock(files.lock);
+    writers.assign(files.writers.begin(), files.writers.end());
+  }
+  for( auto* w : writers )
+    w->closeOutput();
+  // Worker threads, which did not take part in a run, did not write a file.
+  // No further files will come: merge the files, which were written.
+  std::map<std::string, ThreadFiles::Target> targets;  {
+    std::lock_guard<std::mutex> lock(files.lock);
+    targets = std::move(files.targets);
+    files.targets.clear();
+  }
+  for( auto& t : targets )  {
+    Geant4Output2ROOT* owner = t.second.owner;
+    if ( owner && owner->m_mergeThreadFiles )
+      owner->mergeThreadFiles(t.first, std::move(t.second.closed));
+  }
+}
+
+/// Merge the closed thread files into the output file
+void Geant4Output2ROOT::mergeThreadFiles(const std::string& target, std::vector<std::string> inputs)   {
+  TDirectory::TContext ctxt(TDirectory::CurrentDirectory());
+  std::sort(inputs.begin(), inputs.end());
+  if ( !gSystem->AccessPathName(target.c_str()) )  {
+    gSystem->Unlink(target.c_str());
+  }
+  std::unique_ptr<TFile> file(TFile::Open(target.c_str(), "RECREATE", "dd4hep Simulation data"));
+  if ( !file || file->IsZombie() )  {
+    error("+++ Failed to create ROOT output file:'%s'. %ld thread files are kept.",
+          target.c_str(), inputs.size());
+    return;
+  }
+  if ( m_compressionAlgorithm >= 0 )
+    file->SetCompressionAlgorithm(m_compressionAlgorithm);
+  if ( m_compressionLevel >= 0 )
+    file->SetCompressionLevel(m_compressionLevel);
+
+  TFileMerger merger(false, false);
+  merger.SetPrintLevel(0);
+  merger.OutputFile(std::move(file));
+  for( const auto& f : inputs )   {
+    if ( !merger.AddFile(f.c_str(), false) )  {
+      error("+++ Failed to add thread file %s to the merge of %s.", f.c_str(), target.c_str());
+    }
+  }
+  if ( !merger.Merge() )   {
+    error("+++ Failed to merge %ld thread files into ROOT output file %s. The thread files are kept.",
+          inputs.size(), target.c_str());
+    return;
+  }
+  for( const auto& f : inputs )
+    gSystem->Unlink(f.c_str());
+  info("+++ Merged %ld thread files into ROOT output file %s", inputs.size(), target.c_str());
+}
+
+/// Open the output file
+void Geant4Output2ROOT::openOutput(const std::string& fname)   {
+  int         thread_id = G4Threading::G4GetThreadId();
+  std::string file_name = fname;
+  bool        thread_file = m_filePerThread && thread_id >= 0;
+
+  TDirectory::TContext ctxt(TDirectory::CurrentDirectory());
+  if ( thread_file )  {
+    // ROOT thread safety is enabled by the master before the worker threads start
+    file_name = tagged_name(fname, _toString(thread_id, ".thread%03d"));
+  }
+  if ( !gSystem->AccessPathName(file_name.c_str()) )  {
+    gSystem->Unlink(file_name.c_str());
+  }
+  std::unique_ptr<TFile> file(TFile::Open(file_name.c_str(), "RECREATE", "dd4hep Simulation data"));
+  if ( !file )  {
+    file.reset(TFile::Open((file_name+".1").c_str(), "RECREATE", "dd4hep Simulation data"));
+  }
+  if ( !file )  {
+    except("Failed to create ROOT output file:'%s'", file_name.c_str());
+  }
+  if (file->IsZombie()) {
+    detail::deletePtr (m_file);
+    except("Failed to open ROOT output file:'%s'", file_name.c_str());
+  }
+  if ( m_compressionAlgorithm >= 0 )
+    file->SetCompressionAlgorithm(m_compressionAlgorithm);
+  if ( m_compressionLevel >= 0 )
+    file->SetCompressionLevel(m_compressionLevel);
+  m_file = file.release();
+  m_tree = section(m_section);
+  m_fileThread = thread_id;
+  if ( thread_file )  {
+    ThreadFiles& files = thread_files();
+    Geant4Kernel& master = context()->kernel().master();
+    std::size_t num_threads = master.property("NumberOfThreads").value<int>();
+    std::lock_guard<std::mutex> lock(files.lock);
+    files.targets[fname].expected = num_threads;
+    files.writers.insert(this);
+    m_mergeTarget = fname;
+    // The worker instances live as long as the master kernel: close their files
+    // when the kernel terminates, once the worker threads are idle.
+    if ( !files.terminateRegistered )  {
+      files.terminateRegistered = true;
+      master.register_terminate(Geant4Output2ROOT::closeThreadFiles);
+    }
   }
 }
 
@@ -73,6 +248,7 @@ TTree* Geant4Output2ROOT::section(const std::string& nam) {
   if (i == m_sections.end()) {
     TDirectory::TContext ctxt(m_file);
     TTree* t = new TTree(nam.c_str(), ("Geant4 " + nam + " information").c_str());
+    t->SetAutoFlush(m_autoFlush);
     m_sections.emplace(nam, t);
     return t;
   }
@@ -83,33 +259,17 @@ TTree* Geant4Output2ROOT::section(const std::string& nam) {
 void Geant4Output2ROOT::beginRun(const G4Run* run) {
   std::string fname = m_output;
   if ( m_filesByRun )    {
-    size_t idx = m_output.rfind(".");
     if ( m_file )  {
       closeOutput();
     }
-    fname  = m_output.substr(0, idx);
-    fname += _toString(run->GetRunID(), ".run%08d");
-    if ( idx != std::string::npos )
-      fname += m_output.substr(idx);
+    fname = tagged_name(m_output, _toString(run->GetRunID(), ".run%08d"));
+  }
+  if ( m_file && m_filePerThread && m_fileThread != G4Threading::G4GetThreadId() )  {
+    except("+++ FilePerThread: the output action is shared between threads. "
+           "Use one instance per worker thread.");
   }
   if ( !m_file && !fname.empty() ) {
-    TDirectory::TContext ctxt(TDirectory::CurrentDirectory());
-    if ( !gSystem->AccessPathName(fname.c_str()) )  {
-      gSystem->Unlink(fname.c_str());
-    }
-    std::unique_ptr<TFile> file(TFile::Open(fname.c_str(), "RECREATE", "dd4hep Simulation data"));
-    if ( !file )  {
-      file.reset(TFile::Open((fname+".1").c_str(), "RECREATE", "dd4hep Simulation data"));
-    }
-    if ( !file )  {
-      except("Failed to create ROOT output file:'%s'", fname.c_str());
-    }
-    if (file->IsZombie()) {
-      detail::deletePtr (m_file);
-      except("Failed to open ROOT output file:'%s'", fname.c_str());
-    }
-    m_file = file.release();
-    m_tree = section(m_section);
+    openOutput(fname);
   }
   Geant4OutputAction::beginRun(run);
 }
@@ -123,7 +283,7 @@ int Geant4Output2ROOT::fill(const std::string& nam, const ComponentCast& type, v
       const std::type_info& typ = type.type();
       TClass* cl = TBuffer::GetClass(typ);
       if (cl) {
-        b = m_tree->Branch(nam.c_str(), cl->GetName(), (void*) 0);
+        b = m_tree->Branch(nam.c_str(), cl->GetName(), (void*) 0, m_basketSize);
         b->SetAutoDelete(false);
         m_branches.emplace(nam, b);
       }
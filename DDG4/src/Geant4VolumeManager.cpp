@@ -26,6 +26,8 @@
 #include <G4VPhysicalVolume.hh>
 
 // C/C++ include files
+#include <algorithm>
+#include <cstdint>
 #include <sstream>
 
 using namespace dd4hep::sim::Geant4GeometryMaps;
@@ -211,6 +213,78 @@ namespace {
       throw std::runtime_error("Failed to populate Geant4 volume manager!");
     }
   };
+
+  typedef Geant4GeometryInfo::PathIndex PathIndex;
+
+  /// Maximal touchable depth handled by the path index
+  constexpr int MAX_INDEX_DEPTH = 64;
+
+  /// Combine the hash of a placement path with the next volume
+  inline std::size_t path_hash(std::size_t hash, const G4VPhysicalVolume* pv)  {
+    std::size_t v = reinterpret_cast<std::uintptr_t>(pv);
+    return hash ^ (v + 0x9e3779b97f4a7c15ULL + (hash<<6) + (hash>>2));
+  }
+
+  /// Build the flat index of the placement paths once the volume manager is populated
+  void build_path_index(Geant4GeometryInfo& geo)   {
+    PathIndex&  index = geo.g4PathIndex;
+    std::size_t size  = 16;
+    while ( size < 2*geo.g4Paths.size() ) size <<= 1;
+    index.slots.assign(size, PathIndex::Entry());
+    index.volumes.clear();
+    index.fields.clear();
+    for( const auto& p : geo.g4Paths )   {
+      const auto& path = p.first;
+      if ( path.empty() || path.size() > std::size_t(MAX_INDEX_DEPTH) ) continue;
+      PathIndex::Entry e;
+      e.hash = path.size();
+      for( const auto* phys : path ) e.hash = path_hash(e.hash, phys);
+      e.offset   = index.volumes.size();
+      e.length   = path.size();
+      e.field    = index.fields.size();
+      e.volumeID = p.second.volumeID;
+      /// Resolve the bit fields of replicated/parametrised volumes once
+      bool ok = true;
+      for( std::size_t j=0; ok && p.second.flags != 0 && j < path.size(); ++j )   {
+        const auto* phys = path[j];
+        const auto& m = phys->IsParameterised() ? geo.g4Parameterised : geo.g4Replicated;
+        if ( phys->IsParameterised() || phys->IsReplicated() )   {
+          auto it = m.find(phys);
+          if ( it != m.end() )
+            index.fields.emplace_back(int(j), (*it).second.data()->params->field);
+          else
+            ok = false;
+        }
+      }
+      if ( !ok )   {   // Leave it to the slow lookup to report the error
+        index.fields.resize(e.field);
+        continue;
+      }
+      e.numFields = index.fields.size() - e.field;
+      index.volumes.insert(index.volumes.end(), path.begin(), path.end());
+      std::size_t i = e.hash & (size-1);
+      while ( index.slots[i].length ) i = (i+1) & (size-1);
+      index.slots[i] = e;
+    }
+  }
+
+  /// Locate the path of a touchable in the flat index without allocating memory
+  const PathIndex::Entry* find_path(const PathIndex& index, const G4VTouchable* touchable)   {
+    const G4VPhysicalVolume* path[MAX_INDEX_DEPTH];
+    int depth = touchable->GetHistoryDepth();
+    if ( depth <= 0 || depth > MAX_INDEX_DEPTH ) return nullptr;
+    std::size_t hash = depth;
+    for( int i=0; i < depth; ++i )
+      hash = path_hash(hash, path[i] = touchable->GetVolume(i));
+    std::size_t mask = index.slots.size()-1;
+    for( std::size_t i = hash & mask; index.slots[i].length; i = (i+1) & mask )   {
+      const PathIndex::Entry& e = index.slots[i];
+      if ( e.hash == hash && e.length == std::size_t(depth) &&
+           std::equal(path, path+depth, index.volumes.begin()+e.offset) )
+        return &e;
+    }
+    return nullptr;
+  }
 }
 
 /// Initializing constructor. The tree will automatically be built if possible
@@ -219,6 +293,7 @@ Geant4VolumeManager::Geant4VolumeManager(const Detector& description, Geant4Geom
   if (info && info->valid && info->g4Paths.empty()) {
     Populator p(description, *info);
     p.populate(description.world());
+    build_path_index(*info);
     return;
   }
   except("Geant4VolumeManager", "Attempt populate from invalid Geant4 geometry info [Invalid-Info]");
@@ -264,6 +339,25 @@ VolumeID Geant4VolumeManager::volumeID(const std::vector<const G4VPhysicalVolume
 
 /// Access CELLID by Geant4 touchable object
 VolumeID Geant4VolumeManager::volumeID(const G4VTouchable* touchable) const {
+  /// Fast path: hashed lookup without building the placement path
+  if ( touchable && checkValidity() && !ptr()->g4PathIndex.slots.empty() )   {
+    const PathIndex& index = ptr()->g4PathIndex;
+    const PathIndex::Entry* e = find_path(index, touchable);
+    if ( e )   {
+      VolumeID volid = e->volumeID;
+      for( std::size_t j = e->field; j < e->field + e->numFields; ++j )   {
+        const auto& f = index.fields[j];
+        volid |= IDDescriptor::encode(f.second, touchable->GetCopyNumber(f.first));
+      }
+      return volid;
+    }
+  }
+  /// Not indexed (e.g. insensitive volumes): full lookup by placement path
+  return volumeIDByPath(touchable);
+}
+
+/// Access CELLID by the placement path of the touchable without the path index (reference for checks)
+VolumeID Geant4VolumeManager::volumeIDByPath(const G4VTouchable* touchable) const {
   Geant4TouchableHandler handler(touchable);
   std::vector<const G4VPhysicalVolume*> path = handler.placementPath();
   if (!path.empty() && checkValidity()) {
@@ -0,0 +1,92 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+//==========================================================================
+
+// Framework include files
+#include <DDG4/Geant4WriterQueue.h>
+
+using namespace dd4hep::sim;
+
+/// Initializing constructor. Starts the writer thread
+Geant4WriterQueue::Geant4WriterQueue(std::size_t capacity)
+  : m_capacity(capacity > 0 ? capacity : 1)
+{
+  m_thread = std::thread([this] { this->run(); });
+}
+
+/// Default destructor. Executes all pending requests and stops the writer thread
+Geant4WriterQueue::~Geant4WriterQueue()   {
+  {
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_stop = true;
+  }
+  m_pending.notify_all();
+  if ( m_thread.joinable() )  {
+    m_thread.join();
+  }
+}
+
+/// Rethrow pending exception. Lock must be held
+void Geant4WriterQueue::rethrow()   {
+  if ( m_error )  {
+    std::exception_ptr error = m_error;
+    m_error = nullptr;
+    std::rethrow_exception(error);
+  }
+}
+
+/// Writer thread: execute requests until stopped
+void Geant4WriterQueue::run()   {
+  for(;;)  {
+    request_t request;
+    {
+      std::unique_lock<std::mutex> lock(m_lock);
+      m_pending.wait(lock, [this] { return m_stop || !m_requests.empty(); });
+      if ( m_requests.empty() )  {
+        return;
+      }
+      request = std::move(m_requests.front());
+      m_requests.pop_front();
+      m_busy = true;
+    }
+    m_processed.notify_all();
+    std::exception_ptr error;
+    try  {
+      request();
+    }
+    catch(...)  {
+      error = std::current_exception();
+    }
+    {
+      std::lock_guard<std::mutex> lock(m_lock);
+      if ( error && !m_error ) m_error = error;
+      m_busy = false;
+    }
+    m_processed.notify_all();
+  }
+}
+
+/// Queue write request. Blocks while the queue is full
+void Geant4WriterQueue::push(request_t&& request)   {
+  {
+    std::unique_lock<std::mutex> lock(m_lock);
+    m_processed.wait(lock, [this] { return m_requests.size() < m_capacity; });
+    rethrow();
+    m_requests.emplace_back(std::move(request));
+  }
+  m_pending.notify_one();
+}
+
+/// Wait until all queued requests are executed
+void Geant4WriterQueue::drain()   {
+  std::unique_lock<std::mutex> lock(m_lock);
+  m_processed.wait(lock, [this] { return m_requests.empty() && !m_busy; });
+  rethrow();
+}
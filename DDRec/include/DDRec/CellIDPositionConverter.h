@@ -21,6 +21,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 
 namespace dd4hep {
@@ -29,6 +30,48 @@ namespace dd4hep {
     typedef DDSegmentation::CellID CellID;
     typedef DDSegmentation::VolumeID VolumeID;
 
+    /** Index of all sensitive volumes for navigation-free position to cellID conversions:
+     *  every sensitive placement is stored with its bounding box and transformation in the
+     *  world frame and the pre-encoded volume ID. The entries are binned in a regular 3D grid
+     *  covering all bounding boxes. The index is immutable once built.
+     */
+    struct SensitiveVolumeIndex {
+
+      /// One sensitive placement
+      struct Entry {
+        /// Lower corner of the bounding box in the world frame
+        double lower[3] ;
+        /// Upper corner of the bounding box in the world frame
+        double upper[3] ;
+        /// Rotation of the local-to-world transformation (row major)
+        double rotation[9] ;
+        /// Translation of the local-to-world transformation
+        double translation[3] ;
+        /// The placed sensitive volume
+        const TGeoVolume* volume ;
+        /// The segmentation of the volume's readout
+        Segmentation segmentation ;
+        /// Encoded volume ID of the placement including all mother placements
+        VolumeID volumeID ;
+      } ;
+
+      /// All indexed sensitive placements
+      std::vector<Entry> entries{} ;
+      /// Grid cell offsets into gridEntries (size: number of grid cells + 1)
+      std::vector<unsigned> gridOffsets{} ;
+      /// Entry indices sorted by grid cell
+      std::vector<unsigned> gridEntries{} ;
+      /// Lower corner of the grid
+      double gridLower[3] = { 0., 0., 0. } ;
+      /// Inverse grid cell size along each axis
+      double gridInvStep[3] = { 0., 0., 0. } ;
+      /// Number of grid cells along each axis
+      int gridBins[3] = { 0, 0, 0 } ;
+
+      /// True if the index was built
+      bool isValid() const { return !gridOffsets.empty() ; }
+    } ;
+
     /** Utility for position to cellID and cellID to position conversions.
      *  (Correctly re-implements some of the functionality of the deprecated IDDecoder).
      *
@@ -47,9 +90,14 @@ namespace dd4hep {
       
     public:
       
-      /// The constructor - takes the main description object.
-      CellIDPositionConverter(const Detector& description ) : _description( &description )  {
+      /** The constructor - takes the main description object.
+       *  If volumeIndex is true, the index of all sensitive volumes is built,
+       *  which is then used by cellID(const Position&) instead of the TGeo navigation.
+       */
+      CellIDPositionConverter(const Detector& description, bool volumeIndex=false ) : _description( &description )  {
         _volumeManager = VolumeManager::getVolumeManager(description);
+        if( volumeIndex )
+          buildSensitiveVolumeIndex() ;
       }
 
       /// Destructor
@@ -67,13 +115,38 @@ namespace dd4hep {
        */
       Position position(const CellID& cellID) const;
 
+      /** Return the nominal global positions for a batch of cellIDs of sensitive volumes.
+       *  Equivalent to calling positionNominal(cellID) for every entry, but the cellIDs
+       *  are grouped by volume, so that the readout search and the transformation to
+       *  global coordinates are resolved only once per volume and the transformation
+       *  is applied in a tight loop over all cells of the volume.
+       *  The result array must have room for count entries.
+       */
+      void positionsNominal(const CellID* cellIDs, std::size_t count, Position* result) const;
+
+      /** Return the global positions for a batch of cellIDs of sensitive volumes.
+       *  Alignment corrections are applied (TO BE DONE).
+       *  The result array must have room for count entries.
+       */
+      void positions(const CellID* cellIDs, std::size_t count, Position* result) const;
+
 
       /** Return the global cellID for the given global position.
        *  Note: this call is rather slow - only use it when really needed !
-       *  
+       *  If the index of sensitive volumes was built, the lookup is done
+       *  without the TGeo navigator and is thread safe.
        */
       CellID cellID(const Position& global) const;
 
+      /** Build the index of all sensitive volumes in the world frame with their
+       *  pre-encoded volume IDs. Subsequent calls to cellID(const Position&) use the
+       *  index and neither need string paths nor touch the shared TGeo navigator.
+       */
+      void buildSensitiveVolumeIndex() ;
+
+      /// Access the index of sensitive volumes (invalid unless built)
+      const SensitiveVolumeIndex& sensitiveVolumeIndex() const { return _volumeIndex ; }
+
 
 
       /** Find the context with DetElement, placements etc for a given cellID of a sensitive volume.
@@ -117,8 +190,12 @@ namespace dd4hep {
     std::vector<double> cellDimensions(const CellID& cell) const ;
 
     protected:
+      /// Position to cellID conversion using the index of sensitive volumes
+      CellID cellIDFromIndex(const Position& global) const ;
+
       VolumeManager _volumeManager{} ;
       const Detector* _description ;
+      SensitiveVolumeIndex _volumeIndex{} ;  //! No ROOT persistency
 
     };
 
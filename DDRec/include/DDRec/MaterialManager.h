@@ -20,9 +20,11 @@
 #include "DD4hep/DD4hepUnits.h"
 
 #include <vector>
+#include <memory>
 
 
 class TGeoManager ;
+class TGeoNavigator ;
 
 namespace dd4hep {
   namespace rec {
@@ -34,6 +36,16 @@ namespace dd4hep {
      *  Material can be accessed either for a given point or as a list of materials along a straight
      *  line between two points.
      *
+     *  The methods returning references to internally cached results use the global
+     *  navigator of the TGeoManager and are not thread safe. If the manager is constructed
+     *  for concurrent use, the const overloads taking caller owned buffers may be called
+     *  from several threads: each thread navigates with its own TGeoNavigator and keeps
+     *  a small LRU cache of its recently queried segments. The navigation state of a thread
+     *  is created on first use and released when the thread exits or calls releaseThread().
+     *  The MaterialManager does not change the threading setup of the TGeoManager: the
+     *  application must enable multi-threaded navigation (TGeoManager::SetMaxThreads)
+     *  before querying from more than one thread.
+     *
      * @author F.Gaede, DESY
      * @date May, 19 2014
      * @version $Id:$
@@ -45,6 +57,11 @@ namespace dd4hep {
       /// Instantiate the MaterialManager for this (world) volume
       MaterialManager(Volume world);
 
+      /** Instantiate the MaterialManager for this (world) volume for concurrent use.
+       *  cacheSize is the number of segments cached per thread for materialsBetween().
+       */
+      MaterialManager(Volume world, std::size_t cacheSize);
+
 #if defined(G__ROOT)
       MaterialManager() = default ;
 #else
@@ -78,7 +95,35 @@ namespace dd4hep {
        */
       MaterialData createAveragedMaterial( const MaterialVec& materials ) ;
 
+      /** Thread safe version of materialsBetween(): the materials and, if requested, the placements
+       *  between the two points are filled into the caller owned vectors. The navigation uses the
+       *  TGeoNavigator of the calling thread. Requires construction for concurrent use.
+       */
+      void materialsBetween(const Vector3D& p0, const Vector3D& p1, MaterialVec& materials,
+                            PlacementVec* placements=nullptr, double epsilon=1e-4 ) const ;
+
+      /** Thread safe version of materialAt(): the placed volume at the given position is
+       *  returned in placement. Requires construction for concurrent use.
+       */
+      Material materialAt(const Vector3D& pos, PlacedVolume& placement ) const ;
+
+      /** Release the navigation state of the calling thread. It is created again on the next
+       *  concurrent query. Without this call the state is released when the thread exits.
+       */
+      void releaseThread() const ;
+
     protected :
+      /// Per-thread navigation state for concurrent use
+      struct ThreadData ;
+      /// Navigation states of all threads for concurrent use
+      struct ThreadRegistry ;
+      /// Navigation states used by the calling thread
+      struct ThreadCache ;
+      /// Access the navigation state of the calling thread
+      ThreadData& threadData() const ;
+      /// Access the cache of the calling thread
+      static ThreadCache& threadCache() ;
+
       /// Cached materials
       MaterialVec  _mV ;
       Material     _m ;
@@ -89,6 +134,10 @@ namespace dd4hep {
       Vector3D     _p0 , _p1, _pos ;
       /// Reference to the TGeoManager
       TGeoManager* _tgeoMgr ;
+      /// Navigation states per thread (only if constructed for concurrent use)
+      std::shared_ptr<ThreadRegistry> _threads ;  //! No ROOT persistency
+      /// Number of segments cached per thread
+      std::size_t  _cacheSize = 0 ;
     };
 
     /// dump Material operator 
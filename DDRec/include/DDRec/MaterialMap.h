@@ -0,0 +1,114 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+//==========================================================================
+#ifndef DDREC_MATERIALMAP_H
+#define DDREC_MATERIALMAP_H
+
+#include "DDRec/Vector3D.h"
+
+#include <string>
+#include <vector>
+
+namespace dd4hep {
+  namespace rec {
+
+    class MaterialManager ;
+
+    /** Precomputed map of averaged material properties in a (r,z) grid.
+     *  The map is filled once from the detector geometry by stepping with the MaterialManager
+     *  along lines of constant r and phi, and averaging the density, the inverse radiation
+     *  length and the inverse interaction length of all materials in each bin weighted by
+     *  their path length. Queries interpolate bilinearly between the bin centers and do not
+     *  touch the geometry, hence they are cheap and thread safe.
+     *  The exact stepping in MaterialManager::materialsBetween() stays available for validation.
+     *
+     *  The map can be written to and read back from a binary file, so it needs to be
+     *  computed only once per geometry version.
+     *
+     *  Example:
+     *    MaterialManager matMgr( description.world().volume() ) ;
+     *    MaterialMap map( 200, 2000.*dd4hep::mm, 400, -3000.*dd4hep::mm, 3000.*dd4hep::mm ) ;
+     *    map.build( matMgr ) ;
+     *    map.write( "materialmap.bin" ) ;
+     *    double x0 = map.radiationLengths( p0, p1 ) ;
+     */
+    class MaterialMap {
+
+    public:
+      /// Averaged material properties of one bin
+      struct Bin {
+        /// Averaged density
+        float density   = 0.f ;
+        /// Averaged inverse radiation length
+        float invX0     = 0.f ;
+        /// Averaged inverse interaction length
+        float invLambda = 0.f ;
+      } ;
+
+      /// Default constructor: empty map
+      MaterialMap() = default ;
+
+      /// Create an empty map with nR bins in [0,rMax] and nZ bins in [zMin,zMax]
+      MaterialMap( unsigned nR, double rMax, unsigned nZ, double zMin, double zMax ) ;
+
+      /// Default destructor
+      ~MaterialMap() = default ;
+
+      /** Fill the map from the geometry: in every r bin, nSamples lines parallel to the z axis
+       *  at nPhi azimuthal angles are stepped through with the material manager.
+       */
+      void build( MaterialManager& matMgr, unsigned nSamples=2, unsigned nPhi=4 ) ;
+
+      /// Write the map to a binary file
+      void write( const std::string& fileName ) const ;
+
+      /// Read the map from a binary file written with write()
+      void read( const std::string& fileName ) ;
+
+      /// Interpolated material properties at the given position. Outside the map an empty bin is returned.
+      Bin at( const Vector3D& pos ) const ;
+
+      /// Interpolated material properties at the given cylindrical coordinates
+      Bin at( double r, double z ) const ;
+
+      /** Number of radiation lengths traversed along the straight line between p0 and p1,
+       *  integrated in steps of the size of the map bins.
+       */
+      double radiationLengths( const Vector3D& p0, const Vector3D& p1 ) const ;
+
+      /** Number of interaction lengths traversed along the straight line between p0 and p1,
+       *  integrated in steps of the size of the map bins.
+       */
+      double interactionLengths( const Vector3D& p0, const Vector3D& p1 ) const ;
+
+      /// Number of bins in r
+      unsigned nR() const { return _nR ; }
+      /// Number of bins in z
+      unsigned nZ() const { return _nZ ; }
+      /// Access a bin by its indices
+      const Bin& bin( unsigned iR, unsigned iZ ) const { return _bins[ iR * _nZ + iZ ] ; }
+
+    protected:
+      /// Integrate the given bin member along the straight line between p0 and p1
+      double integrate( const Vector3D& p0, const Vector3D& p1, float Bin::* value ) const ;
+
+      unsigned _nR = 0 ;
+      unsigned _nZ = 0 ;
+      double   _rMax = 0. ;
+      double   _zMin = 0. ;
+      double   _zMax = 0. ;
+      /// The bins - r major
+      std::vector<Bin> _bins ;  //! Persistent via write() and read()
+    };
+
+  } /* namespace rec */
+} /* namespace dd4hep */
+
+#endif // DDREC_MATERIALMAP_H
@@ -16,7 +16,15 @@
 #include "DD4hep/Detector.h"
 #include "DD4hep/detail/VolumeManagerInterna.h"
 
+#include "DD4hep/Printout.h"
+
 #include "TGeoManager.h"
+#include "TGeoBBox.h"
+
+#include <map>
+#include <cmath>
+#include <limits>
+#include <algorithm>
 
 namespace dd4hep {
   namespace rec {
@@ -84,8 +92,118 @@ namespace dd4hep {
 
 
 
+    void CellIDPositionConverter::positions(const CellID* cells, std::size_t count, Position* result) const {
+
+      // untill we have the alignment map object, we return the nominal positions
+
+      positionsNominal( cells, count, result ) ;
+    }
+
+    void CellIDPositionConverter::positionsNominal(const CellID* cells, std::size_t count, Position* result) const {
+
+      if( count == 0 )
+	return ;
+
+      // resolve the context of every cell - repeated cellIDs re-use the previous lookup
+      std::vector<const VolumeManagerContext*> contexts( count ) ;
+      std::vector<std::size_t> order( count ) ;
+
+      for(std::size_t i=0 ; i<count ; ++i ){
+	contexts[i] = ( i > 0 && cells[i] == cells[i-1] ) ? contexts[i-1] : findContext( cells[i] ) ;
+	order[i] = i ;
+      }
+
+      // group the cells by DetElement and by volume context
+      std::sort( order.begin(), order.end(), [&contexts]( std::size_t a, std::size_t b ){
+	  const VolumeManagerContext* ca = contexts[a] ;
+	  const VolumeManagerContext* cb = contexts[b] ;
+	  if( ca == nullptr || cb == nullptr )
+	    return ca < cb ;
+	  if( ca->element.ptr() != cb->element.ptr() )
+	    return ca->element.ptr() < cb->element.ptr() ;
+	  return ca < cb ;
+	} ) ;
+
+      std::vector<double> lx, ly, lz ;
+      lx.reserve( count ) ; ly.reserve( count ) ; lz.reserve( count ) ;
+      std::vector<CellID> groupCells ;
+      std::vector<DDSegmentation::Vector3D> local ;
+      groupCells.reserve( count ) ; local.reserve( count ) ;
+
+      DetElement::Object* lastDet = nullptr ;
+      Segmentation seg ;
+
+      for(std::size_t first=0 ; first<count ; ){
+
+	const VolumeManagerContext* context = contexts[ order[first] ] ;
+
+	std::size_t last = first + 1 ;
+	while( last < count && contexts[ order[last] ] == context )
+	  ++last ;
+
+	if( context == nullptr ){
+	  for(std::size_t k=first ; k<last ; ++k )
+	    result[ order[k] ] = Position() ;
+	  first = last ;
+	  continue ;
+	}
+
+	DetElement det = context->element ;
+
+	// the recursive readout search is only done once per DetElement
+	if( det.ptr() != lastDet ){
+	  seg = findReadout( det ).segmentation() ;
+	  lastDet = det.ptr() ;
+	}
+
+	// combined volume to global transformation of this group
+	TGeoHMatrix volToGlobal( det.nominal().worldTransformation() ) ;
+	volToGlobal.Multiply( &context->toElement() ) ;
+
+	const double* r = volToGlobal.GetRotationMatrix() ;
+	const double* t = volToGlobal.GetTranslation() ;
+
+	std::size_t n = last - first ;
+	lx.resize( n ) ; ly.resize( n ) ; lz.resize( n ) ;
+
+	// local positions of the whole group from the bulk segmentation interface
+	groupCells.resize( n ) ; local.resize( n ) ;
+	for(std::size_t k=0 ; k<n ; ++k )
+	  groupCells[k] = cells[ order[first+k] ] ;
+	seg.segmentation()->positions( groupCells.data(), local.data(), n ) ;
+
+	for(std::size_t k=0 ; k<n ; ++k ){
+	  lx[k] = local[k].X ;
+	  ly[k] = local[k].Y ;
+	  lz[k] = local[k].Z ;
+	}
+
+	// apply the transformation in place: branch-free and vectorisable
+	double* x = lx.data() ;
+	double* y = ly.data() ;
+	double* z = lz.data() ;
+	for(std::size_t k=0 ; k<n ; ++k ){
+	  double gx = t[0] + r[0]*x[k] + r[1]*y[k] + r[2]*z[k] ;
+	  double gy = t[1] + r[3]*x[k] + r[4]*y[k] + r[5]*z[k] ;
+	  double gz = t[2] + r[6]*x[k] + r[7]*y[k] + r[8]*z[k] ;
+	  x[k] = gx ;
+	  y[k] = gy ;
+	  z[k] = gz ;
+	}
+
+	for(std::size_t k=0 ; k<n ; ++k )
+	  result[ order[first+k] ] = Position( x[k], y[k], z[k] ) ;
+
+	first = last ;
+      }
+    }
+
+
     CellID CellIDPositionConverter::cellID(const Position& global) const {
 
+      if( _volumeIndex.isValid() )
+	return cellIDFromIndex( global ) ;
+
       CellID result(0) ;
       
       TGeoManager *geoManager = _description->world().volume()->GetGeoManager() ;
@@ -188,6 +306,88 @@ namespace dd4hep {
 
 
     namespace {
+
+      /// Helper to collect all sensitive placements in the world frame for the SensitiveVolumeIndex
+      class SensitiveVolumeScanner {
+	std::vector<SensitiveVolumeIndex::Entry>& _entries ;
+	std::map<const TGeoVolume*, bool> _hasSensitive{} ;
+
+	static bool isSensitive( const TGeoVolume* vol ) {
+	  // volumes without DD4hep extension (e.g. imported shapes) cannot be sensitive
+	  return vol->GetUserExtension() != nullptr && Volume( vol ).isSensitive() ;
+	}
+
+      public:
+	SensitiveVolumeScanner( std::vector<SensitiveVolumeIndex::Entry>& entries ) : _entries( entries ) {}
+
+	/// Check (and cache) if a volume or any of its daughters is sensitive
+	bool containsSensitive( const TGeoVolume* vol ) {
+	  auto it = _hasSensitive.find( vol ) ;
+	  if( it != _hasSensitive.end() )
+	    return it->second ;
+	  bool result = isSensitive( vol ) ;
+	  for( int i=0, n=vol->GetNdaughters() ; !result && i<n ; ++i )
+	    result = containsSensitive( vol->GetNode(i)->GetVolume() ) ;
+	  _hasSensitive[ vol ] = result ;
+	  return result ;
+	}
+
+	/// Scan a placement with the accumulated world transformation and volIDs of its mothers
+	void scan( const TGeoNode* node, const TGeoHMatrix& toWorld, PlacedVolume::VolIDs& volIDs, bool isWorld ) {
+
+	  const TGeoVolume* vol = node->GetVolume() ;
+	  if( ! containsSensitive( vol ) )
+	    return ;
+
+	  PlacedVolume pv( node ) ;
+	  std::size_t nIDs = volIDs.size() ;
+	  if( ! isWorld )   // world has no volIDs
+	    volIDs.insert( std::end(volIDs), std::begin(pv.volIDs()), std::end(pv.volIDs()) ) ;
+
+	  if( isSensitive( vol ) ) {
+
+	    Readout r = Volume( vol ).sensitiveDetector().readout() ;
+
+	    if( r.isValid() ) {
+	      SensitiveVolumeIndex::Entry e ;
+	      e.volume       = vol ;
+	      e.segmentation = r.segmentation() ;
+	      e.volumeID     = r.idSpec().encode( volIDs ) ;
+	      std::copy( toWorld.GetRotationMatrix(), toWorld.GetRotationMatrix()+9, e.rotation ) ;
+	      std::copy( toWorld.GetTranslation(), toWorld.GetTranslation()+3, e.translation ) ;
+
+	      // world frame bounding box from the 8 corners of the local bounding box
+	      const TGeoBBox* box = static_cast<const TGeoBBox*>( vol->GetShape() ) ;
+	      const double* o = box->GetOrigin() ;
+	      const double  d[3] = { box->GetDX(), box->GetDY(), box->GetDZ() } ;
+	      for(int k=0 ; k<3 ; ++k ){
+		e.lower[k] =  std::numeric_limits<double>::max() ;
+		e.upper[k] = -std::numeric_limits<double>::max() ;
+	      }
+	      for(int c=0 ; c<8 ; ++c ){
+		double l[3] = { o[0] + ((c&1) ? d[0] : -d[0]),
+				o[1] + ((c&2) ? d[1] : -d[1]),
+				o[2] + ((c&4) ? d[2] : -d[2]) } ;
+		double g[3] ;
+		toWorld.LocalToMaster( l, g ) ;
+		for(int k=0 ; k<3 ; ++k ){
+		  e.lower[k] = std::min( e.lower[k], g[k] ) ;
+		  e.upper[k] = std::max( e.upper[k], g[k] ) ;
+		}
+	      }
+	      _entries.emplace_back( e ) ;
+	    }
+	  }
+
+	  for( int i=0, n=vol->GetNdaughters() ; i<n ; ++i ){
+	    const TGeoNode* dau = vol->GetNode( i ) ;
+	    TGeoHMatrix dauToWorld( toWorld ) ;
+	    dauToWorld.Multiply( dau->GetMatrix() ) ;
+	    scan( dau, dauToWorld, volIDs, false ) ;
+	  }
+	  volIDs.resize( nIDs ) ;
+	}
+      } ;
       
       bool containsPoint( const DetElement& det, const Position& global ) {
 	
@@ -206,6 +406,126 @@ namespace dd4hep {
       
     }
 
+    void CellIDPositionConverter::buildSensitiveVolumeIndex() {
+
+      SensitiveVolumeIndex index ;
+      SensitiveVolumeScanner scanner( index.entries ) ;
+      PlacedVolume::VolIDs volIDs ;
+      TGeoHMatrix identity ;
+
+      scanner.scan( _description->manager().GetTopNode(), identity, volIDs, true ) ;
+
+      std::size_t nEntries = index.entries.size() ;
+      if( nEntries == 0 ){
+	printout( WARNING, "CellIDPositionConverter", "+++ No sensitive volumes found: volume index not built." ) ;
+	_volumeIndex = SensitiveVolumeIndex() ;
+	return ;
+      }
+
+      // grid covering all bounding boxes with roughly one entry per grid cell
+      double lower[3], upper[3] ;
+      for(int k=0 ; k<3 ; ++k ){
+	lower[k] =  std::numeric_limits<double>::max() ;
+	upper[k] = -std::numeric_limits<double>::max() ;
+      }
+      for( const auto& e : index.entries ){
+	for(int k=0 ; k<3 ; ++k ){
+	  lower[k] = std::min( lower[k], e.lower[k] ) ;
+	  upper[k] = std::max( upper[k], e.upper[k] ) ;
+	}
+      }
+      int nBins = std::max( 1, std::min( 128, int( std::cbrt( double( nEntries ) ) ) ) ) ;
+      for(int k=0 ; k<3 ; ++k ){
+	double width = std::max( upper[k] - lower[k], 1e-6 ) ;
+	index.gridLower[k]   = lower[k] ;
+	index.gridBins[k]    = nBins ;
+	index.gridInvStep[k] = nBins / width ;
+      }
+
+      auto bin = [&index]( int k, double x ){
+	int b = int( ( x - index.gridLower[k] ) * index.gridInvStep[k] ) ;
+	return std::max( 0, std::min( index.gridBins[k]-1, b ) ) ;
+      } ;
+
+      auto forEachCell = [&]( const SensitiveVolumeIndex::Entry& e, auto&& action ){
+	for(int ix=bin(0,e.lower[0]), mx=bin(0,e.upper[0]) ; ix<=mx ; ++ix )
+	  for(int iy=bin(1,e.lower[1]), my=bin(1,e.upper[1]) ; iy<=my ; ++iy )
+	    for(int iz=bin(2,e.lower[2]), mz=bin(2,e.upper[2]) ; iz<=mz ; ++iz )
+	      action( ( std::size_t( ix ) * nBins + iy ) * nBins + iz ) ;
+      } ;
+
+      // first count the entries per grid cell, then fill the cells
+      std::size_t nCells = std::size_t( nBins ) * nBins * nBins ;
+      index.gridOffsets.assign( nCells + 1, 0 ) ;
+      for( const auto& e : index.entries )
+	forEachCell( e, [&index]( std::size_t cell ){ ++index.gridOffsets[ cell + 1 ] ; } ) ;
+      for(std::size_t c=0 ; c<nCells ; ++c )
+	index.gridOffsets[ c + 1 ] += index.gridOffsets[ c ] ;
+
+      std::vector<unsigned> fill( index.gridOffsets.begin(), index.gridOffsets.end() - 1 ) ;
+      index.gridEntries.resize( index.gridOffsets[ nCells ] ) ;
+      for(unsigned i=0 ; i<nEntries ; ++i )
+	forEachCell( index.entries[i], [&index,&fill,i]( std::size_t cell ){ index.gridEntries[ fill[cell]++ ] = i ; } ) ;
+
+      printout( INFO, "CellIDPositionConverter", "+++ Built index of %ld sensitive volumes on a %d^3 grid [%ld references].",
+		long( nEntries ), nBins, long( index.gridEntries.size() ) ) ;
+      _volumeIndex = std::move( index ) ;
+    }
+
+    CellID CellIDPositionConverter::cellIDFromIndex(const Position& global) const {
+
+      const SensitiveVolumeIndex& index = _volumeIndex ;
+      double g[3] ;
+      global.GetCoordinates( g ) ;
+
+      std::size_t cell = 0 ;
+      for(int k=0 ; k<3 ; ++k ){
+	double x = ( g[k] - index.gridLower[k] ) * index.gridInvStep[k] ;
+	if( x < 0. || x >= index.gridBins[k] ){
+	  // the upper edge of the grid still belongs to the last bin
+	  if( x != index.gridBins[k] )
+	    return CellID(0) ;
+	  x = index.gridBins[k] - 1 ;
+	}
+	cell = cell * index.gridBins[k] + std::size_t( x ) ;
+      }
+
+      for(unsigned j=index.gridOffsets[cell], n=index.gridOffsets[cell+1] ; j<n ; ++j ){
+
+	const SensitiveVolumeIndex::Entry& e = index.entries[ index.gridEntries[j] ] ;
+
+	if( g[0] < e.lower[0] || g[0] > e.upper[0] ||
+	    g[1] < e.lower[1] || g[1] > e.upper[1] ||
+	    g[2] < e.lower[2] || g[2] > e.upper[2] )
+	  continue ;
+
+	// world to local: inverse rotation applied to the translated point
+	const double* r = e.rotation ;
+	double d[3] = { g[0]-e.translation[0], g[1]-e.translation[1], g[2]-e.translation[2] } ;
+	double l[3] = { r[0]*d[0] + r[3]*d[1] + r[6]*d[2],
+			r[1]*d[0] + r[4]*d[1] + r[7]*d[2],
+			r[2]*d[0] + r[5]*d[1] + r[8]*d[2] } ;
+
+	if( ! e.volume->Contains( l ) )
+	  continue ;
+
+	// as the TGeo navigation: points inside a daughter are not in the sensitive volume itself
+	bool inDaughter = false ;
+	for( int i=0, nd=e.volume->GetNdaughters() ; !inDaughter && i<nd ; ++i ){
+	  const TGeoNode* dau = e.volume->GetNode( i ) ;
+	  double dl[3] ;
+	  dau->MasterToLocal( l, dl ) ;
+	  inDaughter = dau->GetVolume()->Contains( dl ) ;
+	}
+	if( inDaughter )
+	  continue ;
+
+	return e.segmentation.cellID( Position( l[0], l[1], l[2] ), global, e.volumeID ) ;
+      }
+
+      return CellID(0) ;
+    }
+
     DetElement CellIDPositionConverter::findDetElement(const Position& global,
 						       const DetElement& d) const {
 
@@ -16,36 +16,84 @@
 
 #include "TGeoVolume.h"
 #include "TGeoManager.h"
+#include "TGeoNavigator.h"
 #include "TGeoNode.h"
+#include "TGeoCache.h"
 #include "TVirtualGeoTrack.h"
 
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <thread>
+
 #define MINSTEP 1.e-5
 
 namespace dd4hep {
   namespace rec {
 
-    MaterialManager::MaterialManager(Volume world) : _mV(0), _m( Material() ), _p0(),_p1(),_pos() {
-      _tgeoMgr = world->GetGeoManager();
-    }
-    
-    MaterialManager::~MaterialManager(){
-      
-    }
-    
-    const PlacementVec& MaterialManager::placementsBetween(const Vector3D& p0, const Vector3D& p1 , double epsilon) {
-      materialsBetween(p0,p1,epsilon);
-      return _placeV;
-    }
+    /// Per-thread navigation state for concurrent use
+    struct MaterialManager::ThreadData {
+      /// One cached segment
+      struct Segment {
+        Vector3D     p0, p1 ;
+        double       epsilon = 0 ;
+        MaterialVec  materials ;
+        PlacementVec placements ;
+      } ;
+      /// The navigator owned by this thread
+      std::unique_ptr<TGeoNavigator> navigator ;
+      /// Recently queried segments - most recent first
+      std::vector<Segment> segments ;
+    } ;
 
-    const MaterialVec& MaterialManager::materialsBetween(const Vector3D& p0, const Vector3D& p1 , double epsilon) {
-      if( ( p0 != _p0 ) || ( p1 != _p1 ) ) {	
-        //---------------------------------------	
-        _mV.clear() ;
-        _placeV.clear();
-        //
-        // algorithm copied from TGeoGearDistanceProperties.cc (A.Munnich):
-        // 
-	
+    /// Navigation states of all threads for concurrent use
+    struct MaterialManager::ThreadRegistry {
+      /// Unique identifier of the registry: addresses may be reused by later managers
+      const unsigned long id ;
+      /// Protection of the thread map
+      std::mutex lock ;
+      /// Navigation state keyed by thread identifier
+      std::map<std::thread::id, std::unique_ptr<ThreadData> > threads ;
+
+      ThreadRegistry() : id( next_id() ) {}
+      /// Release the navigation state of a thread
+      void release( std::thread::id tid ) {
+        std::lock_guard<std::mutex> guard( lock ) ;
+        threads.erase( tid ) ;
+      }
+      static unsigned long next_id() {
+        static std::atomic<unsigned long> counter( 0 ) ;
+        return ++counter ;
+      }
+    } ;
+
+    /// Navigation states used by the calling thread
+    struct MaterialManager::ThreadCache {
+      /// Registry of the last access. The lock is only taken if the manager changes
+      unsigned long registry = 0 ;
+      /// Navigation state of the last access
+      ThreadData*   data = nullptr ;
+      /// All registries holding a navigation state of this thread
+      std::vector<std::weak_ptr<ThreadRegistry> > registries ;
+
+      /// The thread exits: release its navigation states of all managers still alive
+      ~ThreadCache() {
+        for( auto& r : registries ) {
+          if( auto reg = r.lock() )
+            reg->release( std::this_thread::get_id() ) ;
+        }
+      }
+    } ;
+
+    namespace {
+
+      /// Collect the materials and placements between p0 and p1 stepping with the given navigator
+      /** Algorithm copied from TGeoGearDistanceProperties.cc (A.Munnich).
+       *  If a track is given, the step points are added to it.
+       */
+      void stepBetween( TGeoNavigator* nav, const Vector3D& p0, const Vector3D& p1 , double epsilon,
+                        MaterialVec& mV, PlacementVec& placeV, TVirtualGeoTrack* track ) {
         double startpoint[3], endpoint[3], direction[3];
         double L=0;
         for(unsigned int i=0; i<3; i++) {
@@ -55,99 +103,203 @@ namespace dd4hep {
           L+=direction[i]*direction[i];
         }
         double totDist = sqrt( L ) ;
-	
+
         //normalize direction
         for(unsigned int i=0; i<3; i++)
           direction[i]=direction[i]/totDist;
-	
-        _tgeoMgr->AddTrack(0, 12 ) ; // electron neutrino
 
-        TGeoNode *node1 = _tgeoMgr->InitTrack(startpoint, direction);
+        TGeoNode *node1 = nav->InitTrack(startpoint, direction);
 
         //check if there is a node at startpoint
         if(!node1)
           throw std::runtime_error("No geometry node found at given location. Either there is no node placed here or position is outside of top volume.");
 
-        while ( !_tgeoMgr->IsOutside() )  {
-	  
-          // TGeoNode *node2;
-          // TVirtualGeoTrack *track; 
-	  
+        while ( !nav->IsOutside() )  {
+
           // step to (and over) the next Boundary
-          TGeoNode * node2 = _tgeoMgr->FindNextBoundaryAndStep( 500, 1) ;
-	  
-          if( !node2 || _tgeoMgr->IsOutside() )
+          TGeoNode * node2 = nav->FindNextBoundaryAndStep( 500, 1) ;
+
+          if( !node2 || nav->IsOutside() )
             break;
-	  
-          const double *position    =  _tgeoMgr->GetCurrentPoint();
-          const double *previouspos =  _tgeoMgr->GetLastPoint();
-	  
-          double length = _tgeoMgr->GetStep();
 
-          TVirtualGeoTrack *track = _tgeoMgr->GetLastTrack();
+          const double *position    =  nav->GetCurrentPoint();
+          const double *previouspos =  nav->GetLastPoint();
+
+          double length = nav->GetStep();
 
           //protection against infinitive loop in root which should not happen, but well it does...
           //work around until solution within root can be found when the step gets very small e.g. 1e-10
           //and the next boundary is never reached
- 	  
-#if 1   //fg: is this still needed ?
           if( length < MINSTEP ) {
-	    
-            _tgeoMgr->SetCurrentPoint( position[0] + MINSTEP * direction[0], 
-                                       position[1] + MINSTEP * direction[1], 
-                                       position[2] + MINSTEP * direction[2] );
-	    
-            length = _tgeoMgr->GetStep();
-            node2  = _tgeoMgr->FindNextBoundaryAndStep(500, 1) ;
-	    
-            position    = _tgeoMgr->GetCurrentPoint();
-            previouspos = _tgeoMgr->GetLastPoint();
+
+            nav->SetCurrentPoint( position[0] + MINSTEP * direction[0],
+                                  position[1] + MINSTEP * direction[1],
+                                  position[2] + MINSTEP * direction[2] );
+
+            length = nav->GetStep();
+            node2  = nav->FindNextBoundaryAndStep(500, 1) ;
+
+            position    = nav->GetCurrentPoint();
+            previouspos = nav->GetLastPoint();
           }
-#endif 	  
-          //	printf( " --  step length :  %1.8e %1.8e   %1.8e   %1.8e   %1.8e   %1.8e   %1.8e   - %s \n" , length ,
-          //		position[0], position[1], position[2], previouspos[0], previouspos[1], previouspos[2] , node1->GetMedium()->GetMaterial()->GetName() ) ;
-	  
+
           Vector3D posV( position ) ;
-	  
+
           double currDistance = ( posV - p0 ).r() ;
-	  
-          // //if the next boundary is further than end point
-          //  if(fabs(position[0])>fabs(endpoint[0]) || fabs(position[1])>fabs(endpoint[1]) 
-          //  || fabs(position[2])>fabs(endpoint[2]))
-	  
+
           //if we travelled too far:
           if( currDistance > totDist  ) {
-	    
-            length = sqrt( pow(endpoint[0]-previouspos[0],2) + 
+
+            length = sqrt( pow(endpoint[0]-previouspos[0],2) +
                            pow(endpoint[1]-previouspos[1],2) +
                            pow(endpoint[2]-previouspos[2],2)   );
-	    
-            track->AddPoint( endpoint[0], endpoint[1], endpoint[2], 0. );
-	    
-	    
+
+            if( track )
+              track->AddPoint( endpoint[0], endpoint[1], endpoint[2], 0. );
+
             if( length > epsilon )   {
-              _mV.emplace_back(node1->GetMedium(), length ); 
-              _placeV.emplace_back(node1,length);
+              mV.emplace_back(node1->GetMedium(), length );
+              placeV.emplace_back(node1,length);
             }
             break;
           }
-	  
-          track->AddPoint( position[0], position[1], position[2], 0.);
-	  
+
+          if( track )
+            track->AddPoint( position[0], position[1], position[2], 0.);
+
           if( length > epsilon )   {
-            _mV.emplace_back(node1->GetMedium(), length); 
-            _placeV.emplace_back(node1,length);
+            mV.emplace_back(node1->GetMedium(), length);
+            placeV.emplace_back(node1,length);
           }
           node1 = node2;
         }
-	
 
         //fg: protect against empty list:
-        if( _mV.empty() ){
-          _mV.emplace_back(node1->GetMedium(), totDist); 
-          _placeV.emplace_back(node1,totDist);
+        if( mV.empty() ){
+          mV.emplace_back(node1->GetMedium(), totDist);
+          placeV.emplace_back(node1,totDist);
         }
+      }
+    }
+
+    MaterialManager::MaterialManager(Volume world) : _mV(0), _m( Material() ), _p0(),_p1(),_pos() {
+      _tgeoMgr = world->GetGeoManager();
+    }
+
+    MaterialManager::MaterialManager(Volume world, std::size_t cacheSize)
+      : _mV(0), _m( Material() ), _p0(),_p1(),_pos(), _threads( new ThreadRegistry ), _cacheSize( cacheSize ) {
+      _tgeoMgr = world->GetGeoManager();
+    }
+    
+    MaterialManager::~MaterialManager(){
+      
+    }
+
+    MaterialManager::ThreadCache& MaterialManager::threadCache() {
+      thread_local ThreadCache cache ;
+      return cache ;
+    }
+
+    MaterialManager::ThreadData& MaterialManager::threadData() const {
+      if( !_threads )
+        throw std::runtime_error("MaterialManager: the manager was not constructed for concurrent use.");
+      ThreadCache& cache = threadCache() ;
+      if( cache.registry == _threads->id )
+        return *cache.data ;
+
+      ThreadData* result = nullptr ;
+      {
+        std::lock_guard<std::mutex> guard( _threads->lock ) ;
+        auto& data = _threads->threads[ std::this_thread::get_id() ] ;
+        if( !data ) {
+          // Private navigator: not registered with the TGeoManager, which is not modified
+          auto* nav = new TGeoNavigator( _tgeoMgr ) ;
+          nav->BuildCache( kTRUE, kFALSE ) ;
+          nav->GetCache()->BuildInfoBranch() ;
+          data.reset( new ThreadData ) ;
+          data->navigator.reset( nav ) ;
+        }
+        result = data.get() ;
+      }
+      auto& regs = cache.registries ;
+      regs.erase( std::remove_if( regs.begin(), regs.end(),
+                                  [this]( const std::weak_ptr<ThreadRegistry>& r ) {
+                                    auto reg = r.lock() ;
+                                    return !reg || reg == _threads ;
+                                  } ), regs.end() ) ;
+      regs.emplace_back( _threads ) ;
+      cache.registry = _threads->id ;
+      cache.data = result ;
+      return *result ;
+    }
+
+    void MaterialManager::releaseThread() const {
+      if( !_threads )
+        return ;
+      ThreadCache& cache = threadCache() ;
+      if( cache.registry == _threads->id ) {
+        cache.registry = 0 ;
+        cache.data = nullptr ;
+      }
+      _threads->release( std::this_thread::get_id() ) ;
+    }
+
+    void MaterialManager::materialsBetween(const Vector3D& p0, const Vector3D& p1, MaterialVec& materials,
+                                           PlacementVec* placements, double epsilon ) const {
+      ThreadData& data = threadData() ;
+      auto& segments = data.segments ;
+
+      for( auto it = segments.begin() ; it != segments.end() ; ++it ) {
+        if( it->p0 == p0 && it->p1 == p1 && it->epsilon == epsilon ) {
+          std::rotate( segments.begin(), it, it+1 ) ;  // most recently used first
+          materials = segments.front().materials ;
+          if( placements )
+            *placements = segments.front().placements ;
+          return ;
+        }
+      }
+
+      ThreadData::Segment seg ;
+      seg.p0 = p0 ;
+      seg.p1 = p1 ;
+      seg.epsilon = epsilon ;
+      stepBetween( data.navigator.get(), p0, p1, epsilon, seg.materials, seg.placements, nullptr ) ;
+      materials = seg.materials ;
+      if( placements )
+        *placements = seg.placements ;
+
+      if( _cacheSize > 0 ) {
+        if( segments.size() >= _cacheSize )
+          segments.pop_back() ;
+        segments.insert( segments.begin(), std::move( seg ) ) ;
+      }
+    }
+
+    Material MaterialManager::materialAt(const Vector3D& pos, PlacedVolume& placement ) const {
+      ThreadData& data = threadData() ;
+      TGeoNode *node = data.navigator->FindNode( pos[0], pos[1], pos[2] ) ;
+      if( ! node ) {
+        std::stringstream err ;
+        err << " MaterialManager::material: No geometry node found at location: " << pos ;
+        throw std::runtime_error( err.str() );
+      }
+      placement = node ;
+      return Material( node->GetMedium() ) ;
+    }
+    
+    const PlacementVec& MaterialManager::placementsBetween(const Vector3D& p0, const Vector3D& p1 , double epsilon) {
+      materialsBetween(p0,p1,epsilon);
+      return _placeV;
+    }
+
+    const MaterialVec& MaterialManager::materialsBetween(const Vector3D& p0, const Vector3D& p1 , double epsilon) {
+      if( ( p0 != _p0 ) || ( p1 != _p1 ) ) {	
+        //---------------------------------------	
+        _mV.clear() ;
+        _placeV.clear();
+        _tgeoMgr->AddTrack(0, 12 ) ; // electron neutrino
 
+        stepBetween( _tgeoMgr->GetCurrentNavigator(), p0, p1, epsilon, _mV, _placeV, _tgeoMgr->GetLastTrack() ) ;
 
         _tgeoMgr->ClearTracks();
 
@@ -0,0 +1,219 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+//==========================================================================
+#include "DDRec/MaterialMap.h"
+#include "DDRec/MaterialManager.h"
+#include "DD4hep/Printout.h"
+
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+#include <fstream>
+#include <algorithm>
+#include <stdexcept>
+
+namespace dd4hep {
+  namespace rec {
+
+    namespace {
+      /// File signature and format version of the binary map files
+      const char     MAP_MAGIC[8] = { 'D','D','4','H','M','M','A','P' } ;
+      const uint32_t MAP_VERSION  = 1 ;
+    }
+
+    MaterialMap::MaterialMap( unsigned nR, double rMax, unsigned nZ, double zMin, double zMax )
+      : _nR( nR ), _nZ( nZ ), _rMax( rMax ), _zMin( zMin ), _zMax( zMax ) {
+      if( nR == 0 || nZ == 0 || rMax <= 0. || zMax <= zMin )
+        throw std::runtime_error( "MaterialMap: invalid binning of the material map." ) ;
+      _bins.resize( std::size_t( _nR ) * _nZ ) ;
+    }
+
+    void MaterialMap::build( MaterialManager& matMgr, unsigned nSamples, unsigned nPhi ) {
+
+      if( _bins.empty() )
+        throw std::runtime_error( "MaterialMap::build: the map has no bins." ) ;
+
+      nSamples = std::max( 1u, nSamples ) ;
+      nPhi     = std::max( 1u, nPhi ) ;
+
+      const double dr = _rMax / _nR ;
+      const double dz = ( _zMax - _zMin ) / _nZ ;
+
+      /// path length weighted sums per z bin: length, density, 1/X0, 1/lambda
+      std::vector<double> sumL( _nZ ), sumRho( _nZ ), sumX0( _nZ ), sumLambda( _nZ ) ;
+
+      for( unsigned iR=0 ; iR<_nR ; ++iR ) {
+
+        std::fill( sumL.begin(), sumL.end(), 0. ) ;
+        std::fill( sumRho.begin(), sumRho.end(), 0. ) ;
+        std::fill( sumX0.begin(), sumX0.end(), 0. ) ;
+        std::fill( sumLambda.begin(), sumLambda.end(), 0. ) ;
+
+        for( unsigned is=0 ; is<nSamples ; ++is ) {
+
+          double r = ( iR + ( is + 0.5 ) / nSamples ) * dr ;
+
+          for( unsigned ip=0 ; ip<nPhi ; ++ip ) {
+
+            double phi = 2. * M_PI * ( ip + 0.5 ) / nPhi ;
+            Vector3D p0( r * std::cos( phi ), r * std::sin( phi ), _zMin ) ;
+            Vector3D p1( r * std::cos( phi ), r * std::sin( phi ), _zMax ) ;
+
+            // keep all segments: the cumulated lengths define the z positions
+            const MaterialVec& materials = matMgr.materialsBetween( p0, p1, 0. ) ;
+
+            double z = _zMin ;
+            for( const auto& m : materials ) {
+              double z0 = z, z1 = std::min( z + m.second, _zMax ) ;
+              double rho    = m.first.density() ;
+              double x0     = m.first.radLength() ;
+              double lambda = m.first.intLength() ;
+              for( unsigned iZ = unsigned( std::max( 0., ( z0 - _zMin ) / dz ) ) ; iZ<_nZ ; ++iZ ) {
+                double lo = _zMin + iZ * dz ;
+                double hi = lo + dz ;
+                if( lo >= z1 )
+                  break ;
+                double l = std::min( hi, z1 ) - std::max( lo, z0 ) ;
+                if( l <= 0. )
+                  continue ;
+                sumL[iZ]      += l ;
+                sumRho[iZ]    += l * rho ;
+                sumX0[iZ]     += ( x0 > 0. )     ? l / x0     : 0. ;
+                sumLambda[iZ] += ( lambda > 0. ) ? l / lambda : 0. ;
+              }
+              z += m.second ;
+            }
+          }
+        }
+
+        for( unsigned iZ=0 ; iZ<_nZ ; ++iZ ) {
+          Bin& b = _bins[ iR * _nZ + iZ ] ;
+          if( sumL[iZ] > 0. ) {
+            b.density   = float( sumRho[iZ]    / sumL[iZ] ) ;
+            b.invX0     = float( sumX0[iZ]     / sumL[iZ] ) ;
+            b.invLambda = float( sumLambda[iZ] / sumL[iZ] ) ;
+          }
+          else {
+            b = Bin() ;
+          }
+        }
+      }
+      printout( INFO, "MaterialMap", "+++ Built material map with %u x %u bins in r:[0,%g] z:[%g,%g]",
+                _nR, _nZ, _rMax, _zMin, _zMax ) ;
+    }
+
+    void MaterialMap::write( const std::string& fileName ) const {
+
+      std::ofstream out( fileName, std::ios::binary ) ;
+      if( !out )
+        throw std::runtime_error( "MaterialMap::write: cannot open file " + fileName ) ;
+
+      uint32_t header[3] = { MAP_VERSION, _nR, _nZ } ;
+      double   limits[3] = { _rMax, _zMin, _zMax } ;
+      out.write( MAP_MAGIC, sizeof( MAP_MAGIC ) ) ;
+      out.write( reinterpret_cast<const char*>( header ), sizeof( header ) ) ;
+      out.write( reinterpret_cast<const char*>( limits ), sizeof( limits ) ) ;
+      for( const auto& b : _bins ) {
+        float values[3] = { b.density, b.invX0, b.invLambda } ;
+        out.write( reinterpret_cast<const char*>( values ), sizeof( values ) ) ;
+      }
+      if( !out )
+        throw std::runtime_error( "MaterialMap::write: failed to write file " + fileName ) ;
+    }
+
+    void MaterialMap::read( const std::string& fileName ) {
+
+      std::ifstream in( fileName, std::ios::binary ) ;
+      if( !in )
+        throw std::runtime_error( "MaterialMap::read: cannot open file " + fileName ) ;
+
+      char     magic[sizeof( MAP_MAGIC )] ;
+      uint32_t header[3] ;
+      double   limits[3] ;
+      in.read( magic, sizeof( magic ) ) ;
+      in.read( reinterpret_cast<char*>( header ), sizeof( header ) ) ;
+      in.read( reinterpret_cast<char*>( limits ), sizeof( limits ) ) ;
+      if( !in || std::memcmp( magic, MAP_MAGIC, sizeof( magic ) ) != 0 )
+        throw std::runtime_error( "MaterialMap::read: " + fileName + " is no material map file." ) ;
+      if( header[0] != MAP_VERSION )
+        throw std::runtime_error( "MaterialMap::read: unsupported format version of " + fileName ) ;
+
+      MaterialMap map( header[1], limits[0], header[2], limits[1], limits[2] ) ;
+      for( auto& b : map._bins ) {
+        float values[3] ;
+        in.read( reinterpret_cast<char*>( values ), sizeof( values ) ) ;
+        b.density   = values[0] ;
+        b.invX0     = values[1] ;
+        b.invLambda = values[2] ;
+      }
+      if( !in )
+        throw std::runtime_error( "MaterialMap::read: truncated material map file " + fileName ) ;
+      *this = std::move( map ) ;
+    }
+
+    MaterialMap::Bin MaterialMap::at( const Vector3D& pos ) const {
+      return at( pos.rho(), pos.z() ) ;
+    }
+
+    MaterialMap::Bin MaterialMap::at( double r, double z ) const {
+
+      if( _bins.empty() || r > _rMax || z < _zMin || z > _zMax )
+        return Bin() ;
+
+      // bilinear interpolation between the bin centers
+      double u = std::min( std::max( r / _rMax * _nR - 0.5, 0. ), double( _nR - 1 ) ) ;
+      double v = std::min( std::max( ( z - _zMin ) / ( _zMax - _zMin ) * _nZ - 0.5, 0. ), double( _nZ - 1 ) ) ;
+      unsigned iR0 = unsigned( u ), iZ0 = unsigned( v ) ;
+      unsigned iR1 = std::min( iR0 + 1, _nR - 1 ), iZ1 = std::min( iZ0 + 1, _nZ - 1 ) ;
+      float fR = float( u - iR0 ), fZ = float( v - iZ0 ) ;
+
+      const Bin& b00 = bin( iR0, iZ0 ) ;
+      const Bin& b01 = bin( iR0, iZ1 ) ;
+      const Bin& b10 = bin( iR1, iZ0 ) ;
+      const Bin& b11 = bin( iR1, iZ1 ) ;
+      float w00 = ( 1.f - fR ) * ( 1.f - fZ ), w01 = ( 1.f - fR ) * fZ ;
+      float w10 = fR * ( 1.f - fZ ), w11 = fR * fZ ;
+
+      Bin result ;
+      result.density   = w00 * b00.density   + w01 * b01.density   + w10 * b10.density   + w11 * b11.density ;
+      result.invX0     = w00 * b00.invX0     + w01 * b01.invX0     + w10 * b10.invX0     + w11 * b11.invX0 ;
+      result.invLambda = w00 * b00.invLambda + w01 * b01.invLambda + w10 * b10.invLambda + w11 * b11.invLambda ;
+      return result ;
+    }
+
+    double MaterialMap::integrate( const Vector3D& p0, const Vector3D& p1, float Bin::* value ) const {
+
+      if( _bins.empty() )
+        return 0. ;
+
+      Vector3D d = p1 - p0 ;
+      double length = d.r() ;
+      double step   = 0.5 * std::min( _rMax / _nR, ( _zMax - _zMin ) / _nZ ) ;
+      unsigned nSteps = std::max( 1u, unsigned( std::ceil( length / step ) ) ) ;
+
+      // midpoint rule
+      double sum = 0. ;
+      for( unsigned i=0 ; i<nSteps ; ++i ) {
+        Vector3D pos = p0 + ( ( i + 0.5 ) / nSteps ) * d ;
+        sum += at( pos ).*value ;
+      }
+      return sum * length / nSteps ;
+    }
+
+    double MaterialMap::radiationLengths( const Vector3D& p0, const Vector3D& p1 ) const {
+      return integrate( p0, p1, &Bin::invX0 ) ;
+    }
+
+    double MaterialMap::interactionLengths( const Vector3D& p0, const Vector3D& p1 ) const {
+      return integrate( p0, p1, &Bin::invLambda ) ;
+    }
+
+  } /* namespace rec */
+} /* namespace dd4hep */
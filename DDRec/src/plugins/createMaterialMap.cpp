@@ -0,0 +1,86 @@
+//==========================================================================
+//  AIDA Detector description implementation 
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+//==========================================================================
+#include "DD4hep/Detector.h"
+#include "DD4hep/Factories.h"
+#include "DD4hep/Printout.h"
+#include "DD4hep/DD4hepUnits.h"
+
+#include "DDRec/MaterialManager.h"
+#include "DDRec/MaterialMap.h"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+namespace dd4hep{
+  namespace rec{
+
+    /**
+    \addtogroup MaterialMapPlugin
+    @{
+    \package MaterialMap
+
+    *  \brief Plugin that computes a (r,z) material map from the geometry and writes it to a file.
+    *
+    @}
+    */
+    static long createMaterialMap(Detector& description, int argc, char** argv) {
+
+      std::string output = "materialmap.bin" ;
+      unsigned nR = 200, nZ = 400, nSamples = 2, nPhi = 4 ;
+      double rMax = 2000.*dd4hep::mm, zMin = -3000.*dd4hep::mm, zMax = 3000.*dd4hep::mm ;
+
+      for(int i=0; i<argc && argv[i]; ++i)  {
+        if ( 0 == ::strncmp("-output",argv[i],4) && i+1<argc )
+          output = argv[++i] ;
+        else if ( 0 == ::strncmp("-nr",argv[i],3) && i+1<argc )
+          nR = ::atoi(argv[++i]) ;
+        else if ( 0 == ::strncmp("-nz",argv[i],3) && i+1<argc )
+          nZ = ::atoi(argv[++i]) ;
+        else if ( 0 == ::strncmp("-rmax",argv[i],5) && i+1<argc )
+          rMax = ::atof(argv[++i]) * dd4hep::mm ;
+        else if ( 0 == ::strncmp("-zmin",argv[i],5) && i+1<argc )
+          zMin = ::atof(argv[++i]) * dd4hep::mm ;
+        else if ( 0 == ::strncmp("-zmax",argv[i],5) && i+1<argc )
+          zMax = ::atof(argv[++i]) * dd4hep::mm ;
+        else if ( 0 == ::strncmp("-samples",argv[i],4) && i+1<argc )
+          nSamples = ::atoi(argv[++i]) ;
+        else if ( 0 == ::strncmp("-nphi",argv[i],4) && i+1<argc )
+          nPhi = ::atoi(argv[++i]) ;
+        else   {
+          std::cout <<
+            "Usage: -plugin DD4hep_MaterialMap -arg [-arg]                                      \n"
+            "     -output   <string> Output file of the material map. Default: materialmap.bin  \n"
+            "     -nr       <number> Number of bins in r.                Default: 200            \n"
+            "     -nz       <number> Number of bins in z.                Default: 400            \n"
+            "     -rmax     <number> Maximal radius in mm.               Default: 2000           \n"
+            "     -zmin     <number> Minimal z in mm.                    Default: -3000          \n"
+            "     -zmax     <number> Maximal z in mm.                    Default: 3000           \n"
+            "     -samples  <number> Sampled lines per r bin.            Default: 2              \n"
+            "     -nphi     <number> Sampled azimuthal angles per line.  Default: 4              \n"
+            "     -help              Show this help message                                     \n"
+            << std::endl << std::flush;
+          ::exit(EINVAL);
+        }
+      }
+
+      MaterialManager matMgr( description.world().volume() ) ;
+      MaterialMap map( nR, rMax, nZ, zMin, zMax ) ;
+      map.build( matMgr, nSamples, nPhi ) ;
+      map.write( output ) ;
+      printout(INFO,"MaterialMap","+++ Material map written to %s", output.c_str() );
+      return 1;
+    }
+  }
+}
+
+DECLARE_APPLY( DD4hep_MaterialMap, dd4hep::rec::createMaterialMap )
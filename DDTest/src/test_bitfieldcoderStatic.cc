@@ -0,0 +1,124 @@
+#include "DD4hep/DDTest.h"
+#include <exception>
+#include <iostream>
+#include <cmath>
+
+#include "DDSegmentation/BitFieldCoder.h"
+#include "DDSegmentation/StaticBitFieldCoder.h"
+
+using namespace std;
+using namespace dd4hep;
+using namespace DDSegmentation;
+
+// layout as emitted by the DD4hep_BitFieldCoderGenerator plugin for
+// "system:5,side:-2,layer:9,module:8,sensor:8,x:32:-16,y:-16"
+namespace TestIDs {
+  namespace CellID {
+    struct system : dd4hep::DDSegmentation::StaticBitFieldElement<0,5> {
+      static constexpr const char* name() { return "system"; }
+    };
+    struct side : dd4hep::DDSegmentation::StaticBitFieldElement<5,-2> {
+      static constexpr const char* name() { return "side"; }
+    };
+    struct layer : dd4hep::DDSegmentation::StaticBitFieldElement<7,9> {
+      static constexpr const char* name() { return "layer"; }
+    };
+    struct module : dd4hep::DDSegmentation::StaticBitFieldElement<16,8> {
+      static constexpr const char* name() { return "module"; }
+    };
+    struct sensor : dd4hep::DDSegmentation::StaticBitFieldElement<24,8> {
+      static constexpr const char* name() { return "sensor"; }
+    };
+    struct x : dd4hep::DDSegmentation::StaticBitFieldElement<32,-16> {
+      static constexpr const char* name() { return "x"; }
+    };
+    struct y : dd4hep::DDSegmentation::StaticBitFieldElement<48,-16> {
+      static constexpr const char* name() { return "y"; }
+    };
+    struct Coder : dd4hep::DDSegmentation::StaticBitFieldCoder<system,side,layer,module,sensor,x,y> {
+      static constexpr const char* fieldDescription() { return "system:0:5,side:5:-2,layer:7:9,module:16:8,sensor:24:8,x:32:-16,y:48:-16"; }
+    };
+  }
+}
+
+//=============================================================================
+int main(int /* argc */, char** /* argv */ ){
+  // this should be the first line in your test
+  DDTest test( "bitfieldcoderStatic" );
+
+  try{
+
+    // ----- write your tests in here -------------------------------------
+
+    test.log( "test static bitfieldcoder" );
+
+    namespace ids = TestIDs::CellID ;
+    typedef ids::Coder Coder ;
+
+    const BitFieldCoder bf( Coder::fieldDescription() ) ;
+
+    test( Coder::matches( bf ), true , " static layout matches the runtime coder " );
+    test( Coder::matches( BitFieldCoder("system:5,side:2,layer:9,module:8,sensor:8,x:32:-16,y:-16") ), false ,
+          " static layout does not match a different sign " );
+    test( Coder::matches( BitFieldCoder("system:5,side:-2,layer:9") ), false ,
+          " static layout does not match a different number of fields " );
+    test( Coder::mask() , bf.mask() , " mask of all fields " );
+
+    // the values are compile-time constants
+    static_assert( ids::x::value( 0xbebafecacafebabeUL ) == -310 , "constexpr decoding" );
+    static_assert( ids::layer::mask() == 0xff80UL , "constexpr mask" );
+
+    CellID field = 0 ;
+    Coder::set<ids::layer>(  field, 373 );
+    Coder::set<ids::module>( field, 254 );
+    Coder::set<ids::sensor>( field, 202 );
+    Coder::set<ids::side>(   field, 1 );
+    Coder::set<ids::system>( field, 30 );
+    Coder::set<ids::x>(      field, -310 );
+    Coder::set<ids::y>(      field, -16710 );
+
+    test(  field , CellID(0xbebafecacafebabeUL)  , " same value 0xbebafecacafebabeUL from individual initialization " );
+
+    test( Coder::get<ids::layer>( field ) ,  373 , " acces field value: layer" );
+    test( Coder::get<ids::module>( field ),  254 , " acces field value: module" );
+    test( Coder::get<ids::sensor>( field ),  202 , " acces field value: sensor" );
+    test( Coder::get<ids::side>( field ),    1   , " acces field value: side" );
+    test( Coder::get<ids::system>( field ),  30  , " acces field value: system" );
+    test( Coder::get<ids::x>( field ),      -310 , " acces field value: x" );
+    test( Coder::get<ids::y>( field ),    -16710 , " acces field value: y" );
+
+    // compare with the runtime coder for a range of bit patterns
+    unsigned int differences = 0 ;
+    CellID id = 0x9e3779b97f4a7c15UL ;
+    for( int i = 0 ; i < 10000 ; ++i ) {
+      id = id * 6364136223846793005UL + 1442695040888963407UL ;
+      if( Coder::get<ids::system>( id ) != bf.get( id, 0 ) ) ++differences ;
+      if( Coder::get<ids::side>( id )   != bf.get( id, 1 ) ) ++differences ;
+      if( Coder::get<ids::layer>( id )  != bf.get( id, 2 ) ) ++differences ;
+      if( Coder::get<ids::x>( id )      != bf.get( id, 5 ) ) ++differences ;
+      if( Coder::get<ids::y>( id )      != bf.get( id, 6 ) ) ++differences ;
+      CellID a = id, b = id ;
+      Coder::set<ids::y>( a, -i ) ;
+      bf.set( b, 6, -i ) ;
+      if( a != b ) ++differences ;
+    }
+    test( differences , 0u , " static and runtime coder agree" );
+
+    bool thrown = false ;
+    try { Coder::set<ids::side>( field, 2 ); } catch( const std::runtime_error& ) { thrown = true ; }
+    test( thrown , true , " out of range value rejected" );
+
+    // --------------------------------------------------------------------
+
+
+  } catch( exception &e ){
+    //} catch( ... ){
+
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+
+  return 0;
+}
+
+//=============================================================================
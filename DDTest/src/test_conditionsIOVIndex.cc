@@ -0,0 +1,199 @@
+#include "DD4hep/DDTest.h"
+
+#include "DD4hep/Conditions.h"
+#include "DDCond/ConditionsPool.h"
+#include "DDCond/ConditionsIOVPool.h"
+#include "DDCond/ConditionsIOVIndex.h"
+#include "DDCond/ConditionsCleanup.h"
+
+#include <exception>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace dd4hep ;
+using namespace dd4hep::cond ;
+
+// this should be the first line in your test
+static DDTest test( "conditionsIOVIndex" ) ;
+
+namespace {
+
+  /// Minimal conditions pool: only the IOV is relevant for the index
+  class TestPool : public ConditionsPool  {
+  public:
+    IOV validity ;
+    TestPool( const IOVType* typ, const IOV::Key& key )
+      : ConditionsPool( ConditionsManager(), &validity ), validity( typ, key )  {}
+    size_t size()  const  override                              { return 1 ; }
+    void clear()  override                                      {}
+    bool insert( Condition )  override                          { return false ; }
+    void insert( RangeConditions& )  override                   {}
+    Condition exists( Condition::key_type )  const  override    { return Condition() ; }
+    size_t select( Condition::key_type, RangeConditions& )  override { return 0 ; }
+    size_t select_all( RangeConditions& )  override             { return 0 ; }
+    size_t select_all( const ConditionsSelect& )  override      { return 0 ; }
+    size_t select_all( ConditionsPool& )  override              { return 0 ; }
+  };
+
+  typedef ConditionsIOVPool::Elements Elements ;
+
+  /// Translate index entry numbers to the IOV keys
+  std::vector<IOV::Key> keys( const ConditionsIOVIndex& idx, const std::vector<size_t>& entries ) {
+    std::vector<IOV::Key> result ;
+    for( size_t i : entries ) result.emplace_back( idx.entry(i)->first ) ;
+    return result ;
+  }
+
+  /// Linear scan over all elements as reference for the containment query
+  std::vector<IOV::Key> scan_containing( const Elements& elements, const IOV::Key& range ) {
+    std::vector<IOV::Key> result ;
+    for( const auto& e : elements )
+      if( IOV::key_contains_range( e.first, range ) ) result.emplace_back( e.first ) ;
+    return result ;
+  }
+
+  /// Linear scan over all elements as reference for the overlap query
+  std::vector<IOV::Key> scan_overlapping( const Elements& elements, const IOV::Key& range ) {
+    std::vector<IOV::Key> result ;
+    for( const auto& e : elements )
+      if( IOV::key_is_contained( e.first, range ) ||
+          IOV::key_overlaps_lower_end( e.first, range ) ||
+          IOV::key_overlaps_higher_end( e.first, range ) )
+        result.emplace_back( e.first ) ;
+    return result ;
+  }
+
+  /// Linear scan over all elements as reference for the expiry query
+  std::vector<IOV::Key> scan_ending( const Elements& elements, IOV::Key_value_type value ) {
+    std::vector<IOV::Key> result ;
+    for( const auto& e : elements )
+      if( e.first.second < value ) result.emplace_back( e.first ) ;
+    return result ;
+  }
+}
+
+//=============================================================================
+
+int main(int /* argc */, char** /* argv */ ){
+
+  test.log( "test conditions IOV index" );
+
+  try{
+
+    IOVType type ;
+    type.type = 0 ;
+    type.name = "run" ;
+
+    // ----- lookup: compare the index queries with a linear scan -----------
+    std::mt19937 rndm( 12345 ) ;
+    std::uniform_int_distribution<int> value( 0, 1000 ), length( 0, 200 ) ;
+    Elements elements ;
+    while( elements.size() < 500 ) {
+      IOV::Key key ;
+      key.first  = value( rndm ) ;
+      key.second = key.first + length( rndm ) ;
+      elements.emplace( key, std::make_shared<TestPool>( &type, key ) ) ;
+    }
+    // Open ended ranges must be handled as well
+    elements.emplace( IOV::Key( IOV::MIN_KEY, IOV::MAX_KEY ), std::make_shared<TestPool>( &type, IOV::Key( IOV::MIN_KEY, IOV::MAX_KEY ) ) ) ;
+    elements.emplace( IOV::Key( 500, IOV::MAX_KEY ), std::make_shared<TestPool>( &type, IOV::Key( 500, IOV::MAX_KEY ) ) ) ;
+
+    ConditionsIOVIndex idx ;
+    idx.build( elements ) ;
+    test( idx.size() , elements.size() , " index contains all elements " ) ;
+
+    size_t num_contain = 0, num_overlap = 0, num_ending = 0 ;
+    size_t err_contain = 0, err_overlap = 0, err_ending = 0 ;
+    for( int i = 0 ; i < 2000 ; ++i ) {
+      IOV::Key range ;
+      range.first  = value( rndm ) - 50 ;
+      range.second = range.first + ( i%4 == 0 ? 0 : length( rndm ) ) ;
+
+      std::vector<size_t> entries ;
+      idx.containing( range, entries ) ;
+      num_contain += entries.size() ;
+      if( keys( idx, entries ) != scan_containing( elements, range ) ) ++err_contain ;
+
+      entries.clear() ;
+      idx.overlapping( range, entries ) ;
+      num_overlap += entries.size() ;
+      if( keys( idx, entries ) != scan_overlapping( elements, range ) ) ++err_overlap ;
+
+      entries.clear() ;
+      idx.endingBefore( range.first, entries ) ;
+      num_ending += entries.size() ;
+      if( keys( idx, entries ) != scan_ending( elements, range.first ) ) ++err_ending ;
+    }
+    test( num_contain > 0 && num_overlap > 0 && num_ending > 0 , " queries selected entries " ) ;
+    test( err_contain , size_t(0) , " containing() matches the linear scan " ) ;
+    test( err_overlap , size_t(0) , " overlapping() matches the linear scan " ) ;
+    test( err_ending  , size_t(0) , " endingBefore() matches the linear scan " ) ;
+
+    idx.clear() ;
+    std::vector<size_t> none ;
+    test( idx.empty() , true , " index is empty after clear " ) ;
+    test( idx.containing( IOV::Key( 10, 10 ), none ) , size_t(0) , " empty index selects nothing " ) ;
+
+    // ----- insert: the pool index follows new registrations ---------------
+    ConditionsIOVPool pool( &type ) ;
+    for( IOV::Key_value_type i = 0 ; i < 10 ; ++i ) {
+      IOV::Key key( i*10, i*10+9 ) ;
+      pool.insert( key, std::make_shared<TestPool>( &type, key ) ) ;
+    }
+    IOV::Key dup( 20, 29 ) ;
+    test( pool.insert( dup, std::make_shared<TestPool>( &type, dup ) ) , false , " duplicate IOV key is rejected " ) ;
+
+    std::vector<ConditionsIOVPool::Element> selected ;
+    test( pool.select( IOV( &type, IOV::Key( 25, 25 ) ), selected ) , size_t(1) , " one pool contains run 25 " ) ;
+
+    IOV::Key wide( 0, 99 ) ;
+    pool.insert( wide, std::make_shared<TestPool>( &type, wide ) ) ;
+    selected.clear() ;
+    test( pool.select( IOV( &type, IOV::Key( 25, 25 ) ), selected ) , size_t(2) , " inserted pool is selected " ) ;
+    test( pool.index().size() , pool.elements.size() , " index rebuilt after insert " ) ;
+
+    // ----- clean: removed pools disappear from the index ------------------
+    int removed = pool.clean( ConditionsExpiredCleanup( &type, 30 ) ) ;
+    test( removed , 3 , " pools ending before run 30 are removed " ) ;
+    test( pool.elements.size() , size_t(8) , " remaining pools after expiry cleanup " ) ;
+    test( pool.index().size() , pool.elements.size() , " index rebuilt after expiry cleanup " ) ;
+    selected.clear() ;
+    test( pool.select( IOV( &type, IOV::Key( 25, 25 ) ), selected ) , size_t(1) , " only the wide pool contains run 25 " ) ;
+    test( selected.size() == 1 && selected[0]->iov->keyData == wide , true , " selected pool is the wide pool " ) ;
+
+    // Age all pools not containing run 55 and remove them
+    RangeConditions valid ;
+    for( int i = 0 ; i < 3 ; ++i ) {
+      IOV cond_validity( &type ) ;
+      pool.select( IOV( &type, IOV::Key( 55, 55 ) ), valid, cond_validity ) ;
+    }
+    removed = pool.clean( 2 ) ;
+    test( removed , 6 , " aged pools are removed " ) ;
+    test( pool.elements.size() , size_t(2) , " pools selected by the last selections are kept " ) ;
+    test( pool.index().size() , pool.elements.size() , " index rebuilt after aging cleanup " ) ;
+    selected.clear() ;
+    test( pool.select( IOV( &type, IOV::Key( 75, 75 ) ), selected ) , size_t(1) , " removed pool of run 75 is not selected " ) ;
+    selected.clear() ;
+    test( pool.select( IOV( &type, IOV::Key( 55, 55 ) ), selected ) , size_t(2) , " kept pools of run 55 are selected " ) ;
+
+    // ----- direct modification: same number of elements, explicit invalidation ---
+    IOV::Key moved( 60, 69 ) ;
+    pool.elements.erase( IOV::Key( 50, 59 ) ) ;
+    pool.elements.emplace( moved, std::make_shared<TestPool>( &type, moved ) ) ;
+    pool.invalidateIndex() ;
+    selected.clear() ;
+    test( pool.select( IOV( &type, IOV::Key( 65, 65 ) ), selected ) , size_t(2) , " directly inserted pool is selected " ) ;
+    selected.clear() ;
+    test( pool.select( IOV( &type, IOV::Key( 55, 55 ) ), selected ) , size_t(1) , " directly removed pool is not selected " ) ;
+
+  } catch( std::exception &e ){
+    //} catch( ... ){
+
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+  return 0;
+}
+
+//=============================================================================
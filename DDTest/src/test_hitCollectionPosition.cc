@@ -0,0 +1,86 @@
+#include "DD4hep/DDTest.h"
+
+#include "DDG4/Geant4Data.h"
+#include "DDG4/Geant4HitCollection.h"
+
+#include <exception>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace dd4hep ;
+using namespace dd4hep::sim ;
+
+// this should be the first line in your test
+static DDTest test( "hitCollectionPosition" ) ;
+
+typedef Geant4Calorimeter::Hit Hit ;
+
+namespace {
+
+  /// Reference: linear scan with the position comparison
+  Hit* linear( Geant4HitCollection& coll, const Position& pos ) {
+    return coll.find<Hit>( PositionCompare<Hit,Position>( pos ) ) ;
+  }
+}
+
+int main(int /* argc */, char** /* argv */ ){
+
+  test.log( "test the position index of the Geant4 hit collection" );
+
+  try{
+
+    Geant4HitCollection coll( "Detector", "Hits", (Geant4Sensitive*)0, (const Hit*)0 ) ;
+
+    // ----- random positions: indexed lookup identical to the linear scan ---
+    std::mt19937 rndm( 4711 ) ;
+    std::uniform_real_distribution<double> flat( -1000., 1000. ) ;
+    std::vector<Position> positions ;
+    for( int i = 0 ; i < 500 ; ++i ) {
+      positions.emplace_back( flat( rndm ), flat( rndm ), flat( rndm ) ) ;
+      coll.addByPosition( new Hit( positions.back() ) ) ;
+    }
+    test( coll.GetSize() , size_t(500) , " all hits added " ) ;
+
+    unsigned long bad = 0, missing = 0 ;
+    for( const auto& pos : positions ) {
+      Hit* h = coll.findByPosition<Hit>( pos ) ;
+      if( !h ) ++missing ;
+      if( h != linear( coll, pos ) ) ++bad ;
+    }
+    test( missing , 0UL , " every added position is found " ) ;
+    test( bad , 0UL , " findByPosition identical to the linear find " ) ;
+
+    // positions which were never added
+    bad = 0 ;
+    for( int i = 0 ; i < 500 ; ++i ) {
+      Position pos( flat( rndm ), flat( rndm ), flat( rndm ) ) ;
+      if( coll.findByPosition<Hit>( pos ) != linear( coll, pos ) ) ++bad ;
+    }
+    test( bad , 0UL , " unknown positions: findByPosition identical to the linear find " ) ;
+
+    // ----- positions comparing equal: signed zeros -------------------------
+    Position zero( 0., 0., 0. ), neg_zero( -0., 0., -0. ) ;
+    test( zero == neg_zero , true , " +0 and -0 positions compare equal " ) ;
+    Hit* origin = new Hit( zero ) ;
+    coll.addByPosition( origin ) ;
+    test( coll.findByPosition<Hit>( neg_zero ) == origin , true , " -0 position finds the hit added at +0 " ) ;
+    test( coll.findByPosition<Hit>( neg_zero ) == linear( coll, neg_zero ) , true , " -0 position: identical to the linear find " ) ;
+
+    Hit* neg_origin = new Hit( Position( -0., -0., -0. ) ) ;
+    coll.addByPosition( neg_origin ) ;
+    test( coll.findByPosition<Hit>( zero ) == origin , true , " equal positions: the first added hit is found " ) ;
+    test( linear( coll, zero ) == origin , true , " equal positions: the linear find returns the first added hit " ) ;
+
+    // ----- the index is released with the hits -----------------------------
+    coll.clear() ;
+    test( coll.findByPosition<Hit>( positions.front() ) == 0 , true , " no hit found after clear " ) ;
+
+  } catch( std::exception &e ){
+
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+
+  return 0;
+}
@@ -0,0 +1,102 @@
+#include "DD4hep/DDTest.h"
+
+#include "DD4hep/Detector.h"
+#include "DDRec/MaterialManager.h"
+
+#include "TGeoManager.h"
+
+#include <cmath>
+#include <exception>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace dd4hep ;
+using namespace dd4hep::rec ;
+
+// this should be the first line in your test
+static DDTest test( "materialManagerMT" ) ;
+
+//=============================================================================
+
+namespace {
+
+  /// Count the differences of two material lists
+  unsigned long differences( const MaterialVec& a, const MaterialVec& b ) {
+    if( a.size() != b.size() ) return 1 ;
+    unsigned long bad = 0 ;
+    for( std::size_t i = 0 ; i < a.size() ; ++i ) {
+      if( a[i].first.ptr() != b[i].first.ptr() || std::fabs( a[i].second - b[i].second ) > 1e-9 ) ++bad ;
+    }
+    return bad ;
+  }
+}
+
+int main(int argc, char** argv ){
+
+  test.log( "test concurrent material queries" );
+
+  if( argc < 2 ) {
+    std::cout << " usage:  test_materialManagerMT compact.xml " << std::endl ;
+    exit(1) ;
+  }
+
+  try{
+
+    Detector& description = Detector::getInstance();
+    description.fromCompact( argv[1] );
+
+    // segments from the interaction point into the detector
+    std::vector<std::pair<Vector3D,Vector3D> > segments ;
+    for( int i = 0 ; i < 64 ; ++i ) {
+      double phi = 0.1 * i, cosTh = -0.9 + 1.8 * i / 63. ;
+      double sinTh = std::sqrt( 1. - cosTh * cosTh ) ;
+      Vector3D dir( sinTh * std::cos( phi ), sinTh * std::sin( phi ), cosTh ) ;
+      segments.emplace_back( Vector3D( 0., 0., 0. ), Vector3D( 150. * dir.x(), 150. * dir.y(), 150. * dir.z() ) ) ;
+    }
+
+    // serial reference with the global navigator
+    MaterialManager serial( description.world().volume() ) ;
+    std::vector<MaterialVec> reference ;
+    for( const auto& s : segments )
+      reference.push_back( serial.materialsBetween( s.first, s.second ) ) ;
+
+    // the application sets up multi-threaded navigation - not the material manager
+    const int nThreads = 4 ;
+    description.manager().SetMaxThreads( nThreads ) ;
+    MaterialManager matMgr( description.world().volume(), 4 ) ;
+
+    std::vector<unsigned long> bad( nThreads, 0 ) ;
+    std::vector<std::thread> threads ;
+    for( int t = 0 ; t < nThreads ; ++t ) {
+      threads.emplace_back( [&, t]() {
+        MaterialVec materials ;
+        // repeat the queries to exercise the per-thread segment cache
+        for( int pass = 0 ; pass < 3 ; ++pass ) {
+          for( std::size_t i = t ; i < segments.size() + t ; ++i ) {
+            std::size_t k = i % segments.size() ;
+            matMgr.materialsBetween( segments[k].first, segments[k].second, materials ) ;
+            bad[t] += differences( materials, reference[k] ) ;
+          }
+          // the navigation state is created again after an explicit release
+          if( pass == 1 ) matMgr.releaseThread() ;
+        }
+      } ) ;
+    }
+    for( auto& t : threads ) t.join() ;
+
+    unsigned long total = 0 ;
+    for( auto b : bad ) total += b ;
+    test( total , 0UL , " concurrent materialsBetween identical to serial materialsBetween " ) ;
+
+    // the concurrent manager does not change the threading setup of the TGeoManager
+    test( TGeoManager::GetMaxThreads() , nThreads , " maximal number of TGeo threads unchanged " ) ;
+
+  } catch( std::exception &e ){
+
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+
+  return 0;
+}
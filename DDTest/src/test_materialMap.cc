@@ -0,0 +1,100 @@
+#include "DD4hep/DDTest.h"
+
+#include "DD4hep/Detector.h"
+#include "DD4hep/DD4hepUnits.h"
+#include "DDRec/MaterialManager.h"
+#include "DDRec/MaterialMap.h"
+
+#include <cmath>
+#include <cstdio>
+#include <exception>
+#include <iostream>
+#include <sstream>
+
+using namespace dd4hep ;
+using namespace dd4hep::rec ;
+
+// this should be the first line in your test
+static DDTest test( "materialMap" ) ;
+
+//=============================================================================
+
+int main(int argc, char** argv ){
+
+  test.log( "test material map against the material manager" );
+
+  if( argc < 2 ) {
+    std::cout << " usage:  test_materialMap compact.xml " << std::endl ;
+    exit(1) ;
+  }
+
+  try{
+
+    Detector& description = Detector::getInstance();
+    description.fromCompact( argv[1] );
+
+    const unsigned nR = 20, nZ = 120 ;
+    const double rMax = 2000.*dd4hep::mm, zMin = -3000.*dd4hep::mm, zMax = 3000.*dd4hep::mm ;
+
+    MaterialManager matMgr( description.world().volume() ) ;
+    MaterialMap map( nR, rMax, nZ, zMin, zMax ) ;
+    // one line per r bin at phi=pi: the map is sampled exactly along the lines checked below
+    map.build( matMgr, 1, 1 ) ;
+
+    // integrals along the sampled lines must reproduce the stepping of the material manager
+    unsigned badX0 = 0, badLambda = 0 ;
+    double sumX0 = 0. ;
+    for( unsigned iR = 0 ; iR < nR ; ++iR ) {
+      double r = ( iR + 0.5 ) * rMax / nR ;
+      Vector3D p0( -r, 0., zMin ), p1( -r, 0., zMax ) ;
+
+      double x0 = 0., lambda = 0. ;
+      for( const auto& m : matMgr.materialsBetween( p0, p1, 0. ) ) {
+        x0     += m.second / m.first.radLength() ;
+        lambda += m.second / m.first.intLength() ;
+      }
+      double mapX0     = map.radiationLengths( p0, p1 ) ;
+      double mapLambda = map.interactionLengths( p0, p1 ) ;
+      sumX0 += x0 ;
+
+      std::stringstream sstr ;
+      sstr << " r: " << r << " X0 stepping: " << x0 << " map: " << mapX0
+           << "  lambda stepping: " << lambda << " map: " << mapLambda ;
+      test.log( sstr.str() ) ;
+
+      if( std::fabs( mapX0 - x0 ) > 1e-2 * x0 + 1e-6 ) ++badX0 ;
+      if( std::fabs( mapLambda - lambda ) > 1e-2 * lambda + 1e-6 ) ++badLambda ;
+    }
+    test( sumX0 > 0. , true , " geometry contains material along the sampled lines " ) ;
+    test( badX0 , 0u , " map radiation lengths agree with the material manager " ) ;
+    test( badLambda , 0u , " map interaction lengths agree with the material manager " ) ;
+
+    // write and read back: identical map
+    const std::string fileName = "test_materialMap.bin" ;
+    map.write( fileName ) ;
+    MaterialMap copy ;
+    copy.read( fileName ) ;
+    std::remove( fileName.c_str() ) ;
+
+    unsigned badBins = 0 ;
+    for( unsigned iR = 0 ; iR < nR ; ++iR ) {
+      for( unsigned iZ = 0 ; iZ < nZ ; ++iZ ) {
+        const MaterialMap::Bin& a = map.bin( iR, iZ ) ;
+        const MaterialMap::Bin& b = copy.bin( iR, iZ ) ;
+        if( a.density != b.density || a.invX0 != b.invX0 || a.invLambda != b.invLambda ) ++badBins ;
+      }
+    }
+    test( copy.nR() == nR && copy.nZ() == nZ , true , " binning of the map read back " ) ;
+    test( badBins , 0u , " bins of the map read back " ) ;
+
+    Vector3D q0( 0., 0., 0. ), q1( 1200.*dd4hep::mm, 300.*dd4hep::mm, 1500.*dd4hep::mm ) ;
+    test( copy.radiationLengths( q0, q1 ) , map.radiationLengths( q0, q1 ) , " radiation lengths of the map read back " ) ;
+
+  } catch( std::exception &e ){
+
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+
+  return 0;
+}
@@ -0,0 +1,109 @@
+#include "DDSegmentation/CartesianGridXY.h"
+#include "DDSegmentation/CartesianGridXYZ.h"
+#include "DDSegmentation/CartesianGridXZ.h"
+#include "DDSegmentation/CartesianGridYZ.h"
+#include "DDSegmentation/PolarGridRPhi.h"
+#include "DDSegmentation/ProjectiveCylinder.h"
+#include "DD4hep/DDTest.h"
+
+#include <cmath>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace dd4hep::DDSegmentation;
+
+/// Compare the bulk positions() and cellIDs() methods with the single cell methods
+void compare( dd4hep::DDTest& test, Segmentation& seg, const std::vector<Vector3D>& points ) {
+
+  const std::size_t n = points.size();
+  std::vector<VolumeID> volIDs( n );
+  for( std::size_t i = 0; i < n; ++i ) volIDs[i] = ( i % 7 ) + 1;
+
+  std::vector<CellID> cids( n );
+  seg.cellIDs( points.data(), points.data(), volIDs.data(), cids.data(), n );
+
+  std::vector<Vector3D> pos( n, Vector3D( 99., 99., 99. ) );
+  seg.positions( cids.data(), pos.data(), n );
+
+  unsigned int badIDs = 0, badPositions = 0;
+  for( std::size_t i = 0; i < n; ++i ) {
+    CellID cid = seg.cellID( points[i], points[i], volIDs[i] );
+    Vector3D p = seg.position( cid );
+    if( cid != cids[i] ) ++badIDs;
+    if( p.X != pos[i].X || p.Y != pos[i].Y || p.Z != pos[i].Z ) ++badPositions;
+  }
+  test( badIDs,       0u, seg.type() + " bulk cellIDs identical to cellID" );
+  test( badPositions, 0u, seg.type() + " bulk positions identical to position" );
+}
+
+/// Check that the bulk cellIDs() raises the same exception as cellID() for values out of range
+void compareOverflow( dd4hep::DDTest& test, Segmentation& seg, const Vector3D& point ) {
+  std::string single = "none", bulk = "none";
+  VolumeID volID = 0;
+  CellID   cid   = 0;
+  try { seg.cellID( point, point, volID ); }
+  catch( const std::exception& e ) { single = e.what(); }
+  try { seg.cellIDs( &point, &point, &volID, &cid, 1 ); }
+  catch( const std::exception& e ) { bulk = e.what(); }
+  test( bulk, single, seg.type() + " bulk cellIDs raises the same exception" );
+}
+
+int main() {
+
+  dd4hep::DDTest test( "segmentationBulk" );
+
+  try{
+
+    const std::string encoding = "system:8,barrel:3,layer:8,slice:5,x:-10,y:-10,z:-10" ;
+
+    std::vector<Vector3D> points;
+    for( int i = 0; i < 2000; ++i ) {
+      double t = 0.37 * i ;
+      points.push_back( Vector3D( 250. * std::sin( t ), 180. * std::cos( 1.3 * t ), 7. * i - 7000. ) ) ;
+    }
+
+    CartesianGridXY xy( encoding );
+    xy.setGridSizeX( 3.5 );
+    xy.setGridSizeY( 5.0 );
+    xy.setOffsetY( 1.25 );
+    compare( test, xy, points );
+
+    CartesianGridXYZ xyz( encoding );
+    xyz.setGridSizeX( 3.5 );
+    xyz.setGridSizeY( 5.0 );
+    xyz.setGridSizeZ( 20.0 );
+    compare( test, xyz, points );
+
+    CartesianGridXZ xz( encoding );
+    xz.setGridSizeX( 1.0 );
+    xz.setGridSizeZ( 15.0 );
+    compare( test, xz, points );
+
+    CartesianGridYZ yz( encoding );
+    yz.setGridSizeY( 2.0 );
+    yz.setGridSizeZ( 15.0 );
+    compare( test, yz, points );
+
+    PolarGridRPhi rphi( "system:8,barrel:3,layer:8,slice:5,r:16,phi:-16" );
+    rphi.setGridSizeR( 2.0 );
+    rphi.setGridSizePhi( M_PI / 180. );
+    compare( test, rphi, points );
+
+    ProjectiveCylinder proj( "system:8,barrel:3,layer:8,slice:5,theta:16,phi:-16" );
+    proj.setThetaBins( 1000 );
+    proj.setPhiBins( 2000 );
+    compare( test, proj, points );
+
+    // out of range values must fall back to the checks of the single cell method
+    compareOverflow( test, xy, Vector3D( 1.e5, 0., 0. ) );
+    compareOverflow( test, rphi, Vector3D( 1.e6, 0., 0. ) );
+
+  } catch( std::exception &e ){
+
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+  return 0;
+}
@@ -0,0 +1,91 @@
+#include "DD4hep/DDTest.h"
+
+#include "DD4hep/Detector.h"
+#include "DD4hep/VolumeManager.h"
+#include "DD4hep/detail/VolumeManagerInterna.h"
+
+#include <exception>
+#include <iostream>
+#include <map>
+#include <set>
+
+using namespace dd4hep ;
+
+// this should be the first line in your test
+static DDTest test( "volumeManagerFrozen" ) ;
+
+//=============================================================================
+
+int main(int argc, char** argv ){
+
+  test.log( "test frozen volume manager" );
+
+  if( argc < 2 ) {
+    std::cout << " usage:  test_volumeManagerFrozen compact.xml " << std::endl ;
+    exit(1) ;
+  }
+
+  try{
+
+    Detector& description = Detector::getInstance();
+    description.fromCompact( argv[1] );
+
+    VolumeManager mgr = VolumeManager::getVolumeManager( description ) ;
+    test( mgr.isFrozen() , false , " volume manager is not frozen after populating " ) ;
+
+    // collect all registered placements and their lookup results before freezing
+    std::map<VolumeID, VolumeManagerContext*> contexts ;
+    for( const auto& s : mgr.ptr()->subdetectors ) {
+      for( const auto& v : s.second.ptr()->volumes )
+        contexts.emplace( v.first, v.second ) ;
+    }
+    test( contexts.empty() , false , " volume manager has registered placements " ) ;
+
+    mgr.freeze() ;
+    test( mgr.isFrozen() , true , " volume manager is frozen " ) ;
+
+    // reads still work and return the same contexts as the placement maps
+    unsigned long bad = 0 ;
+    for( const auto& c : contexts ) {
+      if( mgr.lookupContext( c.first ) != c.second ) ++bad ;
+      else if( !( mgr.lookupDetElement( c.first ) == c.second->element ) ) ++bad ;
+    }
+    test( bad , 0UL , " frozen lookups identical to the placement maps " ) ;
+
+    // modifications are rejected: register a new placement identifier of an existing section
+    const VolumeManagerContext* ref = contexts.begin()->second ;
+    VolumeID vid = ref->identifier ;
+    do {
+      vid += 1ULL << 32 ;
+    } while( contexts.find( vid ) != contexts.end() ) ;
+
+    VolumeManagerContext* ctx = new VolumeManagerContext() ;
+    ctx->element    = ref->element ;
+    ctx->identifier = vid ;
+    bool rejected = false ;
+    try {
+      mgr.adoptPlacement( ctx ) ;
+    } catch( const std::exception& e ) {
+      test.log( e.what() ) ;
+      rejected = true ;
+    }
+    if( !rejected ) ctx = nullptr ;   // now owned by the manager
+    delete ctx ;
+    test( rejected , true , " frozen volume manager rejects new placements " ) ;
+    test( mgr.isFrozen() , true , " volume manager stays frozen after rejected modification " ) ;
+
+    // the frozen tables were not touched by the rejected modification
+    bad = 0 ;
+    for( const auto& c : contexts ) {
+      if( mgr.lookupContext( c.first ) != c.second ) ++bad ;
+    }
+    test( bad , 0UL , " frozen lookups unchanged after rejected modification " ) ;
+
+  } catch( std::exception &e ){
+
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+
+  return 0;
+}
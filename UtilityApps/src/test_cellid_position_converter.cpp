@@ -78,6 +78,8 @@ int main_wrapper(int argc, char** argv ){
 
   CellIDPositionConverter idposConv( description )  ;
 
+  CellIDPositionConverter idposConvIndex( description, true )  ;
+
   
   //---------------------------------------------------------------------
   //    open lcio file with SimCalorimeterHits
@@ -128,6 +130,9 @@ int main_wrapper(int argc, char** argv ){
       dd4hep::BitFieldCoder idDecoder1( cellIDEcoding ) ;
 
       int nHit = std::min( col->getNumberOfElements(), maxHit )  ;
+
+      std::vector<CellID>   batchIDs ;
+      std::vector<Position> singlePositions ;
      
       
       for(int i=0 ; i< nHit ; ++i){
@@ -156,9 +161,19 @@ int main_wrapper(int argc, char** argv ){
 	  tMap[ colNames[icol] ].cellid.passed++ ;
 	else
 	  tMap[ colNames[icol] ].cellid.failed++ ;
+
+	CellID idFromIndex = idposConvIndex.cellID( point ) ;
+
+	std::stringstream sst2 ;
+	sst2 << " compare ids from volume index: " << det.name() << " " <<  idDecoder0.valueString(idFromDecoder) << "  -  " << idDecoder1.valueString(idFromIndex) ;
+
+	test( idFromDecoder, idFromIndex,  sst2.str() ) ;
 	  
 	Position pointFromDecoder = idposConv.position( id ) ;
 
+	batchIDs.emplace_back( id ) ;
+	singlePositions.emplace_back( pointFromDecoder ) ;
+
 	double d = dist(pointFromDecoder, point)  ;
 	std::stringstream sst1 ;
 	sst1 << " dist " << d << " ( " <<  point << " ) - ( " << pointFromDecoder << " )  - detElement: "
@@ -172,6 +187,17 @@ int main_wrapper(int argc, char** argv ){
 	  tMap[ colNames[icol] ].position.failed++ ;
 
       }
+
+      // ====== test the batched cellID to position conversion against the single conversions ===========
+      std::vector<Position> batchPositions( batchIDs.size() ) ;
+      idposConv.positions( batchIDs.data(), batchIDs.size(), batchPositions.data() ) ;
+
+      for(unsigned i=0, n=batchIDs.size() ; i<n ; ++i ){
+	double d = dist( batchPositions[i], singlePositions[i] ) ;
+	std::stringstream sst ;
+	sst << " batch dist " << d << " ( " << singlePositions[i] << " ) - ( " << batchPositions[i] << " ) " ;
+	test( d < epsilon , true , sst.str() ) ;
+      }
     }
     
   }
@@ -22,6 +22,17 @@
    Populate the conditions store by hand for a set of IOVs.
    Then compute the corresponding alignment entries....
 
+   With the option -incremental finally a single delta is changed: only
+   the alignments of the sub-tree below must be recomputed and the result
+   must be identical to a full computation.
+
+   With the option -threads <n> (n > 1) the alignments are finally computed
+   once more with n threads and compared to a sequential computation.
+
+   With the option -transforms the transformations are also computed into
+   the compact AlignmentTransforms storage and compared to the matrices of
+   the alignment conditions.
+
 */
 // Framework include files
 #include "AlignmentExampleObjects.h"
@@ -30,10 +41,48 @@
 #include "TTimeStamp.h"
 #include "TRandom3.h"
 
+#include <cmath>
+
 using namespace std;
 using namespace dd4hep;
 using namespace dd4hep::AlignmentExamples;
 
+namespace  {
+  /// Number of detector elements of a sub-tree
+  size_t count_elements(DetElement de)  {
+    size_t count = 1;
+    for( const auto& c : de.children() )
+      count += count_elements(c.second);
+    return count;
+  }
+  /// Check if two transformations are equal within the numerical precision
+  bool same_matrix(const TGeoHMatrix& a, const TGeoHMatrix& b)  {
+    for( int i=0; i<3; ++i )
+      if ( std::fabs(a.GetTranslation()[i]-b.GetTranslation()[i]) > 1e-10 ) return false;
+    for( int i=0; i<9; ++i )
+      if ( std::fabs(a.GetRotationMatrix()[i]-b.GetRotationMatrix()[i]) > 1e-10 ) return false;
+    return true;
+  }
+  /// Compare the world transformations of two alignment sets. Returns the number of differences
+  size_t compare_alignments(DetElement de, ConditionsMap& a, ConditionsMap& b)  {
+    size_t bad = 0;
+    AlignmentCondition ca = a.get(de, align::Keys::alignmentKey);
+    AlignmentCondition cb = b.get(de, align::Keys::alignmentKey);
+    if ( ca.isValid() != cb.isValid() )  {
+      ++bad;
+    }
+    else if ( ca.isValid() )  {
+      if ( !same_matrix(ca.data().worldTrafo, cb.data().worldTrafo) )  {
+        printout(ERROR,"Compare","++ World transformation of %s differs.",de.path().c_str());
+        ++bad;
+      }
+    }
+    for( const auto& c : de.children() )
+      bad += compare_alignments(c.second, a, b);
+    return bad;
+  }
+}
+
 /// Plugin function: Alignment program example
 /**
  *  Factory: DD4hep_AlignmentExample_stress
@@ -45,8 +94,8 @@ using namespace dd4hep::AlignmentExamples;
 static int alignment_example (Detector& description, int argc, char** argv)  {
 
   string input;
-  int    num_iov = 10, num_runs = 10;
-  bool   arg_error = false;
+  int    num_iov = 10, num_runs = 10, num_threads = 0;
+  bool   arg_error = false, incremental = false, transforms = false;
   for(int i=0; i<argc && argv[i]; ++i)  {
     if ( 0 == ::strncmp("-input",argv[i],4) )
       input = argv[++i];
@@ -54,6 +103,12 @@ static int alignment_example (Detector& description, int argc, char** argv)  {
       num_iov = ::atol(argv[++i]);
     else if ( 0 == ::strncmp("-runs",argv[i],4) )
       num_runs = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-incremental",argv[i],4) )
+      incremental = true;
+    else if ( 0 == ::strncmp("-threads",argv[i],4) )
+      num_threads = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-transforms",argv[i],4) )
+      transforms = true;
     else
       arg_error = true;
   }
@@ -65,6 +120,9 @@ static int alignment_example (Detector& description, int argc, char** argv)  {
       "     -input   <string>        Geometry file                                   \n"
       "     -iovs    <number>        Number of parallel IOV slots for processing.    \n"
       "     -runs    <number>        Number of collision loads to be performed.      \n"
+      "     -incremental             Reuse unchanged alignments between IOVs.        \n"
+      "     -threads <number>        Threads to compute independent sub-trees.       \n"
+      "     -transforms              Check the compact transformation storage.       \n"
       "\tArguments given: " << arguments(argc,argv) << endl << flush;
     ::exit(EINVAL);
   }
@@ -114,6 +172,7 @@ static int alignment_example (Detector& description, int argc, char** argv)  {
 
   ConditionsManager::Result total_cres;
   AlignmentsCalculator::Result total_ares;
+  AlignmentsCalculator::IncrementalContext history;
   /******************** Compute  alignments *******************************/
   for(int i=0; i<num_iov; ++i)  {
     TTimeStamp start;
@@ -121,20 +180,111 @@ static int alignment_example (Detector& description, int argc, char** argv)  {
     shared_ptr<ConditionsSlice> sl(new ConditionsSlice(manager,content));
     ConditionsManager::Result cres = manager.prepare(req_iov,*sl);
     // Now compute the tranformation matrices
-    AlignmentsCalculator calculator;
-    AlignmentsCalculator::Result ares = calculator.compute(deltas,*sl);
+    AlignmentsCalculator calculator(num_threads);
+    AlignmentsCalculator::Result ares = incremental
+      ? calculator.compute(deltas,*sl,history)
+      : calculator.compute(deltas,*sl);
     TTimeStamp stop;
     total_cres += cres;
     total_ares += ares;
     //sl->manage(alignments.data);
     comp_stat.Fill(stop.AsDouble()-start.AsDouble());
     printout(INFO,"ComputedDerived",
-             "Setup %ld conditions (S:%ld,L:%ld,C:%ld,M:%ld) (D:%ld,A:%ld,M:%ld) for IOV:%-12s [%8.3f sec]",
+             "Setup %ld conditions (S:%ld,L:%ld,C:%ld,M:%ld) (D:%ld,A:%ld,R:%ld,M:%ld) for IOV:%-12s [%8.3f sec]",
              cres.total(), cres.selected, cres.loaded, cres.computed, cres.missing, 
-             deltas.size(),ares.computed, ares.missing, req_iov.str().c_str(),
+             deltas.size(),ares.computed, ares.reused, ares.missing, req_iov.str().c_str(),
              stop.AsDouble()-start.AsDouble());
   }
 
+  if ( incremental )  {
+    // ++++++++++++++++++++++++ Change a single delta: only its sub-tree shall be recomputed
+    IOV req_iov(iov_typ,15);
+    shared_ptr<ConditionsSlice> inc(new ConditionsSlice(manager,content));
+    shared_ptr<ConditionsSlice> ref(new ConditionsSlice(manager,content));
+    manager.prepare(req_iov,*inc);
+    manager.prepare(req_iov,*ref);
+    AlignmentsCalculator calculator;
+    AlignmentsCalculator::IncrementalContext context;
+    AlignmentsCalculator::Result full = calculator.compute(deltas,*inc,context);
+    DetElement changed;
+    for( const auto& d : deltas )  {
+      if ( !d.first.children().empty() && d.first.parent().ptr() != description.world().ptr() )  {
+        changed = d.first;
+        break;
+      }
+    }
+    if ( !changed.isValid() )  {
+      except("AlignmentExample","++ No delta with a dependent sub-tree found.");
+    }
+    map<DetElement, Delta> new_deltas(deltas);
+    Delta& delta = new_deltas[changed];
+    delta.translation.SetZ(delta.translation.Z()+0.05*dd4hep::cm);
+    delta.flags |= Delta::HAVE_TRANSLATION;
+    AlignmentsCalculator::Result ares = calculator.compute(new_deltas,*inc,context);
+    calculator.compute(new_deltas,*ref);
+    size_t expected = count_elements(changed);
+    size_t num_bad  = compare_alignments(description.world(), *inc, *ref);
+    bool   passed   = ares.computed == expected && ares.reused == full.computed-expected && num_bad == 0;
+    printout(ALWAYS,"Incremental","+++ Test %s: Changed delta of %s: %ld of %ld alignments recomputed, %ld reused. Differences: %ld",
+             passed ? "PASSED" : "FAILED", changed.path().c_str(), ares.computed, full.computed, ares.reused, num_bad);
+  }
+
+  if ( num_threads > 1 )  {
+    // ++++++++++++++++++++++++ Concurrent computation: compare with the sequential result
+    IOV req_iov(iov_typ,15);
+    shared_ptr<ConditionsSlice> con(new ConditionsSlice(manager,content));
+    shared_ptr<ConditionsSlice> seq(new ConditionsSlice(manager,content));
+    manager.prepare(req_iov,*con);
+    manager.prepare(req_iov,*seq);
+    AlignmentsCalculator::Result cres = AlignmentsCalculator(num_threads).compute(deltas,*con);
+    AlignmentsCalculator::Result sres = AlignmentsCalculator().compute(deltas,*seq);
+    size_t num_bad = compare_alignments(description.world(), *con, *seq);
+    bool   passed  = num_bad == 0 && cres.computed == sres.computed && sres.computed > 0;
+    printout(ALWAYS,"Threads","+++ Test %s: Computed %ld alignments with %d threads and %ld sequentially. Differences: %ld",
+             passed ? "PASSED" : "FAILED", cres.computed, num_threads, sres.computed, num_bad);
+  }
+
+  if ( transforms )  {
+    // ++++++++++++++++++++++++ Compact storage: compare with the alignment conditions
+    IOV req_iov(iov_typ,15);
+    shared_ptr<ConditionsSlice> sl(new ConditionsSlice(manager,content));
+    manager.prepare(req_iov,*sl);
+    AlignmentsCalculator calculator;
+    AlignmentsCalculator::OrderedDeltas ordered;
+    for( const auto& d : deltas )
+      ordered.emplace(d.first, &d.second);
+    AlignmentsCalculator::Result ares = calculator.compute(ordered,*sl);
+    align::AlignmentTransforms& compact = AlignmentsCalculator::transforms(*sl, description.world());
+    AlignmentsCalculator::Result tres = calculator.compute(ordered,compact);
+    Position local(1.0*dd4hep::cm, -2.0*dd4hep::cm, 3.0*dd4hep::cm);
+    size_t   num_bad = 0;
+    for( size_t i=0; i<compact.size(); ++i )  {
+      DetElement         de = compact.detector(i);
+      AlignmentCondition c  = sl->get(de, align::Keys::alignmentKey);
+      if ( !c.isValid() )  {
+        printout(ERROR,"Transforms","++ No alignment condition for %s.",de.path().c_str());
+        ++num_bad;
+        continue;
+      }
+      const AlignmentData& data = c.data();
+      double loc[3] = { local.X(), local.Y(), local.Z() }, glob[3];
+      data.worldTrafo.LocalToMaster(loc, glob);
+      Position world = compact.localToWorld(de, local);
+      Position back  = compact.worldToLocal(de, world);
+      bool ok = same_matrix(compact.worldTransformation(de), data.worldTrafo)
+        && same_matrix(compact.detectorTransformation(de), data.detectorTrafo)
+        && (world-Position(glob[0],glob[1],glob[2])).R() < 1e-10
+        && (back-local).R() < 1e-10;
+      if ( !ok )  {
+        printout(ERROR,"Transforms","++ Compact transformation of %s differs.",de.path().c_str());
+        ++num_bad;
+      }
+    }
+    bool passed = num_bad == 0 && compact.size() == ares.computed && tres.computed == ares.computed;
+    printout(ALWAYS,"Transforms","+++ Test %s: Compared %ld compact transformations to %ld alignments. Differences: %ld",
+             passed ? "PASSED" : "FAILED", compact.size(), ares.computed, num_bad);
+  }
+
   // ++++++++++++++++++++++++ Now access the conditions for every IOV....
   TRandom3 random;
   for(int i=0; i<num_runs; ++i)  {
@@ -159,9 +309,9 @@ static int alignment_example (Detector& description, int argc, char** argv)  {
   printout(INFO,"Statistics","+  %-12s:  %11.5g +- %11.4g  RMS = %11.5g  N = %lld",
            access_stat.GetName(), access_stat.GetMean(), access_stat.GetMeanErr(), access_stat.GetRMS(), access_stat.GetN());
   printout(INFO,"Statistics",
-           "+  Summary: Total %ld conditions used (S:%ld,L:%ld,C:%ld,M:%ld) (A:%ld,M:%ld). Created:%ld",
+           "+  Summary: Total %ld conditions used (S:%ld,L:%ld,C:%ld,M:%ld) (A:%ld,R:%ld,M:%ld). Created:%ld",
            total_cres.total(), total_cres.selected, total_cres.loaded, total_cres.computed, total_cres.missing, 
-           total_ares.computed, total_ares.missing, total_created);
+           total_ares.computed, total_ares.reused, total_ares.missing, total_created);
 
   printout(INFO,"Statistics","+==========================================================================");
   // All done.
@@ -0,0 +1,153 @@
+# ==========================================================================
+#  AIDA Detector description implementation
+# --------------------------------------------------------------------------
+# Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+# All rights reserved.
+#
+# For the licensing terms see $DD4hepINSTALL/LICENSE.
+# For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+#
+# ==========================================================================
+from __future__ import absolute_import, unicode_literals
+import os
+import glob
+import logging
+import DDG4
+from g4units import GeV, MeV
+#
+logging.basicConfig(format='%(levelname)s: %(message)s', level=logging.INFO)
+logger = logging.getLogger(__name__)
+#
+"""
+
+   dd4hep example setup in multi-threaded mode using the python configuration
+
+   Every worker thread writes its own ROOT file. At the end the thread
+   files are merged and the number of events in the merged file is checked.
+   With the option -edm4hep every worker thread owns an EDM4hep output action
+   (non-shared) and all of them write to the same file. The option -lcio does
+   the same with LCIO output actions.
+
+   Options:
+   -events  <number>     Number of events to be simulated (default: 10)
+   -threads <number>     Number of worker threads (default: 3)
+   -output  <file name>  Name of the output file (default: MiniTelMT.root)
+   -edm4hep              Write EDM4hep output from all worker threads to one file
+   -lcio                 Write LCIO output from all worker threads to one file
+   -queue   <number>     EDM4hep/LCIO: size of the queue to the writer thread (default: 0)
+
+   \author  M.Frank
+   \version 1.0
+
+"""
+
+
+def setupWorker(geant4, output, edm4hep, lcio, queue_size):
+  kernel = geant4.kernel()
+  logger.info('#PYTHON: +++ Creating Geant4 worker thread ....')
+  if edm4hep:
+    # Every worker thread converts its events without locking. All write to the same file.
+    evt_edm4hep = geant4.setupEDM4hepOutput('Edm4hepOutput', output, shared=False)
+    evt_edm4hep.WriterQueueSize = queue_size
+  elif lcio:
+    # Every worker thread converts its events without locking. All write to the same file.
+    evt_lcio = geant4.setupLCIOOutput('LcioOutput', output, shared=False)
+    evt_lcio.WriterQueueSize = queue_size
+  else:
+    # Every worker thread writes its own file. The files are merged at the end.
+    geant4.setupROOTOutput('RootOutput', output, file_per_thread=True)
+  geant4.setupGun('Gun', particle='pi-', energy=10 * GeV, multiplicity=1)
+  part = DDG4.GeneratorAction(kernel, "Geant4ParticleHandler/ParticleHandler")
+  kernel.generatorAction().adopt(part)
+  part.SaveProcesses = ['Decay']
+  part.MinimalKineticEnergy = 100 * MeV
+  part.enableUI()
+  return 1
+
+
+def setupMaster(geant4):
+  kernel = geant4.master()
+  logger.info('#PYTHON: +++ Setting up master thread for %d workers', int(kernel.NumberOfThreads))
+  return 1
+
+
+def setupSensitives(geant4):
+  from dd4hep import DetElement
+  for i in geant4.description.detectors():
+    det = DetElement(i.second.ptr())
+    sd = geant4.description.sensitiveDetector(str(det.name()))
+    if sd.isValid():
+      geant4.setupTracker(det.name())
+  return 1
+
+
+def count_events(file_name, tree_name):
+  import ROOT
+  f = ROOT.TFile.Open(file_name)
+  if not f or f.IsZombie():
+    return -1
+  tree = f.Get(tree_name)
+  num_events = tree.GetEntries() if tree else -1
+  f.Close()
+  return num_events
+
+
+def count_lcio(file_name):
+  from pyLCIO import IOIMPL
+  reader = IOIMPL.LCFactory.getInstance().createLCReader()
+  reader.open(file_name)
+  num_events = reader.getNumberOfEvents()
+  num_runs = reader.getNumberOfRuns()
+  reader.close()
+  return num_events, num_runs
+
+
+def run():
+  args = DDG4.CommandLine()
+  num_events = int(args.events) if args.events else 10
+  num_threads = int(args.threads) if args.threads else 3
+  output = args.output if args.output else 'MiniTelMT.root'
+  edm4hep = True if args.edm4hep else False
+  lcio = True if args.lcio else False
+  queue_size = int(args.queue) if args.queue else 0
+
+  kernel = DDG4.Kernel()
+  install_dir = os.environ['DD4hepExamplesINSTALL']
+  kernel.loadGeometry(str("file:" + install_dir + "/examples/ClientTests/compact/MiniTel.xml"))
+  kernel.NumberOfThreads = num_threads
+  kernel.RunManagerType = 'G4MTRunManager'
+  kernel.NumEvents = num_events
+  geant4 = DDG4.Geant4(kernel)
+  geant4.addUserInitialization(worker=setupWorker, worker_args=(geant4, output, edm4hep, lcio, queue_size),
+                               master=setupMaster, master_args=(geant4,))
+  geant4.addDetectorConstruction("Geant4DetectorGeometryConstruction/ConstructGeo")
+  geant4.addDetectorConstruction("Geant4PythonDetectorConstruction/SetupSD",
+                                 sensitives=setupSensitives, sensitives_args=(geant4,))
+  geant4.addDetectorConstruction("Geant4DetectorSensitivesConstruction/ConstructSD")
+  rndm = DDG4.Action(kernel, 'Geant4Random/Random')
+  rndm.Seed = 987654321
+  rndm.initialize()
+  geant4.setupPhysics('QGSP_BERT')
+  geant4.run()
+
+  # The output files are closed when the kernel terminates
+  if edm4hep or lcio:
+    if edm4hep:
+      found = count_events(output, 'events')
+      runs = count_events(output, 'runs')
+    else:
+      found, runs = count_lcio(output)
+    result = 'PASSED' if found == num_events and runs == 1 else 'FAILED'
+    logger.info('+++ Test %s: Output file %s contains %d of %d events and %d run(s) from %d threads.',
+                result, output, found, num_events, runs, num_threads)
+    return
+  # The thread files are merged when the kernel terminates
+  found = count_events(output, 'EVENT')
+  left = glob.glob(output.replace('.root', '.thread*.root'))
+  result = 'PASSED' if found == num_events and not left else 'FAILED'
+  logger.info('+++ Test %s: Merged output file %s contains %d of %d events from %d threads. %d thread files left.',
+              result, output, found, num_events, num_threads, len(left))
+
+
+if __name__ == "__main__":
+  run()
@@ -30,6 +30,7 @@ from ddsix.moves import range
 
 def run():
   batch = False
+  compact_truth = False
   kernel = DDG4.Kernel()
   install_dir = os.environ['DD4hepExamplesINSTALL']
   geometry = "file:" + install_dir + "/examples/ClientTests/compact/MultiCollections.xml"
@@ -44,6 +45,8 @@ def run():
       batch = True
     elif sys.argv[i] == 'batch':
       batch = True
+    elif sys.argv[i] == '-truth_compaction':
+      compact_truth = True
 
   kernel.loadGeometry(str(geometry))
   geant4 = DDG4.Geant4(kernel)
@@ -61,6 +64,11 @@ def run():
 
   # Now the test calorimeter with multiple collections
   seq, act = geant4.setupCalorimeter('TestCal')
+  if compact_truth:
+    # Collect the hit contributions in the event arena and merge them by track
+    for a in (act if isinstance(act, list) else [act]):
+      a.UseTruthArena = True
+      a.TruthCompaction = 1
 
   # And handle the simulation particles.
   part = DDG4.GeneratorAction(kernel, "Geant4ParticleHandler/ParticleHandler")
@@ -46,6 +46,8 @@ def run():
               -batch                          Run in batch mode for unit testing
               -events <number>                Run geant4 for specified number of events
                                               (batch mode only)
+              -checkids                       Compare the indexed volume ID lookup with the
+                                              lookup by placement path for all touchables
     """)
     sys.exit(0)
 
@@ -78,6 +80,10 @@ def run():
   prt.OutputType = 3  # Print both: table and tree
   kernel.eventAction().adopt(prt)
 
+  if args.checkids:
+    check = DDG4.RunAction(kernel, 'Geant4VolumeManagerCheck/VolumeManagerCheck')
+    kernel.runAction().adopt(check)
+
   generator_output_level = Output.INFO
 
   # Configure G4 geometry setup
@@ -23,13 +23,17 @@ using cond::DependencyBuilder;
 using cond::ConditionsLoadInfo;
 
 /// Install the consitions and the alignment manager
-ConditionsManager dd4hep::ConditionExamples::installManager(Detector& description)  {
+ConditionsManager dd4hep::ConditionExamples::installManager(Detector& description,
+                                                            const std::string& shared_arena)  {
   // Now we instantiate the conditions manager
   description.apply("DD4hep_ConditionsManagerInstaller",0,(char**)0);
   ConditionsManager manager = ConditionsManager::from(description);
   manager["PoolType"]       = "DD4hep_ConditionsLinearPool";
   manager["UserPoolType"]   = "DD4hep_ConditionsMapUserPool";
   manager["UpdatePoolType"] = "DD4hep_ConditionsLinearUpdatePool";
+  if ( !shared_arena.empty() )  {
+    manager["SharedArena"]  = shared_arena;
+  }
   manager.initialize();
   return manager;
 }
@@ -345,7 +345,8 @@ namespace dd4hep {
     typedef DetectorScanner Scanner;
     
     /// Install the consitions and the conditions manager
-    ConditionsManager installManager(Detector& description);
+    /** If a shared conditions arena is given, the loader reads the conditions published there. */
+    ConditionsManager installManager(Detector& description, const std::string& shared_arena = "");
   }       /* End namespace condExamples             */
 }         /* End namespace dd4hep                         */
 #endif // EXAMPLES_CONDITIONS_SRC_CONDITIONEXAMPLEOBJECTS_H
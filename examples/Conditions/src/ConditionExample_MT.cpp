@@ -22,6 +22,11 @@
    Populate the conditions store by hand for a set of IOVs.
    Then compute the corresponding alignment entries....
 
+   With the option -load only the first half of the IOVs is populated
+   before the worker threads start. The conditions of the second half are
+   registered by a loader thread while the workers prepare their slices.
+   Afterwards the workers process the IOVs of the second half.
+
 */
 // Framework include files
 #include "ConditionExampleObjects.h"
@@ -173,7 +178,7 @@ namespace {
 static int condition_example (Detector& description, int argc, char** argv)  {
   string input;
   int    num_iov = 10, num_threads = 1, num_run = 30;
-  bool   arg_error = false;
+  bool   arg_error = false, concurrent_load = false;
   for(int i=0; i<argc && argv[i]; ++i)  {
     if ( 0 == ::strncmp("-input",argv[i],4) )
       input = argv[++i];
@@ -183,6 +188,8 @@ static int condition_example (Detector& description, int argc, char** argv)  {
       num_run = ::atol(argv[++i]);
     else if ( 0 == ::strncmp("-threads",argv[i],4) )
       num_threads = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-load",argv[i],4) )
+      concurrent_load = true;
     else
       arg_error = true;
   }
@@ -195,6 +202,7 @@ static int condition_example (Detector& description, int argc, char** argv)  {
       "     -iovs    <number>        Number of parallel IOV slots for processing.    \n"
       "     -runs    <number>        Number of collision loads to be performed.      \n"
       "     -threads <number>        Number of execution threads.                    \n"
+      "     -load                    Register half of the IOVs while preparing.      \n"
       "\tArguments given: " << arguments(argc,argv) << endl << flush;
     ::exit(EINVAL);
   }
@@ -218,39 +226,66 @@ static int condition_example (Detector& description, int argc, char** argv)  {
   EventQueue events;
   /******************** Populate the conditions store *********************/
   // Have e.g. 10 run-slices [1,10], [11,20] .... [91,100]
-  for(int i=0; i<num_iov; ++i)  {
+  auto populate = [&](int i)  {
     TTimeStamp start;
     IOV iov(iov_typ, IOV::Key(1+i*10,(i+1)*10));
     ConditionsPool*   pool = manager.registerIOV(*iov.iovType, iov.key());
     // Create conditions with all deltas using a generic conditions creator
     int count = Scanner().scan(ConditionsCreator(*slice, *pool, DEBUG),description.world());
     TTimeStamp stop;
+    lock_guard<mutex> lock(stats.total_guard);
     stats.create.Fill(stop.AsDouble()-start.AsDouble());
     printout(INFO,"Example", "Setup %ld conditions for IOV:%s [%8.3f sec]",
              count, iov.str().c_str(),stop.AsDouble()-start.AsDouble());
     stats.total_created += count;
-    // Fill the event queue with 10 evt per run
-    for(int j=0; j<6; ++j)   {
-      events.push(make_pair((i*10)+j,num_run));
+  };
+  // Fill the event queue with 10 evt per run
+  auto schedule = [&](int first, int last)  {
+    for(int i=first; i<last; ++i)  {
+      for(int j=0; j<6; ++j)   {
+        events.push(make_pair((i*10)+j,num_run));
+      }
     }
-  }
-
+  };
   // ++++++++++++++++++++++++ Now compute the conditions for each of these IOVs
-  vector<thread*> threads;
-  for(int i=0; i<num_threads; ++i)  {
-    Executor* exec = new Executor(manager, iov_typ, i, events, stats);
-    exec->slice = new ConditionsSlice(*slice);
-    thread* t = new thread( [exec]{ exec->run(); delete exec; });
-    threads.push_back(t);
+  auto process = [&]()  {
+    vector<thread*> threads;
+    for(int i=0; i<num_threads; ++i)  {
+      Executor* exec = new Executor(manager, iov_typ, i, events, stats);
+      exec->slice = new ConditionsSlice(*slice);
+      thread* t = new thread( [exec]{ exec->run(); delete exec; });
+      threads.push_back(t);
+    }
+    for(thread* t : threads)  {
+      t->join();
+      delete t;
+    }
+  };
+
+  int num_preload = concurrent_load ? (num_iov+1)/2 : num_iov;
+  for(int i=0; i<num_preload; ++i)
+    populate(i);
+  schedule(0, num_preload);
+  // The loader registers conditions to the IOV pools, which the workers select from
+  thread loader;
+  if ( concurrent_load )   {
+    loader = thread([&]{ for(int i=num_preload; i<num_iov; ++i) populate(i); });
   }
-  for(thread* t : threads)  {
-    t->join();
-    delete t;
+  process();
+  if ( loader.joinable() )   {
+    loader.join();
+    schedule(num_preload, num_iov);
+    process();
   }
   printout(INFO,"Statistics",
            "+======= Summary: # of IOV: %3d  # of Threads: %3d ========================",
            num_iov, num_threads);
   stats.print();
+  if ( concurrent_load )   {
+    bool passed = stats.totals.missing == 0 && stats.total_created > 0 && stats.total_accesses > 0;
+    printout(ALWAYS,"Statistics","+++ Test %s: %d IOVs registered while preparing. Missing conditions: %ld",
+             passed ? "PASSED" : "FAILED", num_iov-num_preload, stats.totals.missing);
+  }
   // All done.
   return 1;
 }
@@ -29,8 +29,14 @@
 #include "DDCond/ConditionsIOVPool.h"
 #include "DDCond/ConditionsManager.h"
 #include "DDCond/ConditionsRootPersistency.h"
+#include "DDCond/ConditionsMappedSnapshot.h"
+#include "DDCond/ConditionsPrefetcher.h"
+#include "DDCond/ConditionsDataLoader.h"
 #include "DD4hep/Factories.h"
 
+// C/C++ include files
+#include <set>
+
 using namespace std;
 using namespace dd4hep;
 using namespace dd4hep::ConditionExamples;
@@ -44,6 +50,14 @@ static void help(int argc, char** argv)  {
     "     -conditions  <string>    Conditions input file                           \n"
     "     -iovs        <number>    Number of parallel IOV slots for processing.    \n"
     "     -restore     <string>    Restore strategy: iovpool, userpool or condpool.\n"
+    "                              mapped: the input is a memory mapped snapshot.  \n"
+    "                              loader: the conditions loader reads the mapped  \n"
+    "                              snapshot on demand.                             \n"
+    "     -prefetch                Prepare the slice of the next IOV in the background.\n"
+    "     -sources     <number>    Number of loader sources declared for the input.\n"
+    "     -threads     <number>    Number of threads reading the loader sources.   \n"
+    "     -shared      <string>    Load on demand from a shared conditions arena.  \n"
+    "                              The option -conditions is then not required.    \n"
     "\tArguments given: " << arguments(argc,argv) << endl << flush;
   ::exit(EINVAL);
 }
@@ -57,9 +71,9 @@ static void help(int argc, char** argv)  {
  *  \date    01/12/2016
  */
 static int condition_example (Detector& description, int argc, char** argv)  {
-  string input, conditions, restore="iovpool";
-  int    num_iov = 10, extend = 0;
-  bool   arg_error = false;
+  string input, conditions, arena, restore="iovpool";
+  int    num_iov = 10, extend = 0, num_sources = 1, num_threads = 0;
+  bool   arg_error = false, prefetch = false;
   for(int i=0; i<argc && argv[i]; ++i)  {
     if ( 0 == ::strncmp("-input",argv[i],4) )
       input = argv[++i];
@@ -71,10 +85,18 @@ static int condition_example (Detector& description, int argc, char** argv)  {
       num_iov = ::atol(argv[++i]);
     else if ( 0 == ::strncmp("-extend",argv[i],4) )
       extend = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-prefetch",argv[i],4) )
+      prefetch = true;
+    else if ( 0 == ::strncmp("-sources",argv[i],4) )
+      num_sources = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-threads",argv[i],4) )
+      num_threads = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-shared",argv[i],4) )
+      arena = argv[++i];
     else
       arg_error = true;
   }
-  if ( arg_error || input.empty() || conditions.empty() ) help(argc,argv);
+  if ( arg_error || input.empty() || (conditions.empty() && arena.empty()) ) help(argc,argv);
 
   // First we load the geometry
   description.fromXML(input);
@@ -82,37 +104,68 @@ static int condition_example (Detector& description, int argc, char** argv)  {
   detail::have_condition_item_inventory(1);
   
   /******************** Initialize the conditions manager *****************/
-  ConditionsManager manager = installManager(description);
+  ConditionsManager manager = installManager(description, arena);
   shared_ptr<ConditionsContent> content(new ConditionsContent());
   shared_ptr<ConditionsSlice>   slice(new ConditionsSlice(manager,content));
   Scanner(ConditionsKeys(*content,INFO),description.world());
   Scanner(ConditionsDependencyCreator(*content,DEBUG,false,extend),description.world());
 
   /******************** Load the conditions from file *********************/
-  printout(INFO,"ConditionsExample","+  Start conditions import from ROOT object(s): %s",
-           conditions.c_str());
-  try  {
-    auto pers = cond::ConditionsRootPersistency::load(conditions.c_str(),"DD4hep Conditions");
+  // The imported conditions reference the mapped file: keep it mapped until the end
+  unique_ptr<cond::ConditionsMappedSnapshot> snapshot;
+  if ( !arena.empty() )  {
+    // Nothing is imported: the loader reads the conditions published by another process
+    manager.registerIOVType(0,"run");
+    printout(ALWAYS,"Statistics","+  Conditions are loaded on demand from shared conditions arena '%s'.",
+             arena.c_str());
+  }
+  else if ( restore == "mapped" )  {
+    snapshot = cond::ConditionsMappedSnapshot::open(conditions);
+    size_t num_cond = snapshot->import("ConditionsIOVPool No 1","run",manager);
     printout(ALWAYS,"Statistics","+=========================================================================");
-    printout(ALWAYS,"Statistics","+  Loaded conditions object from file %s. Took %8.3f seconds.",
-             conditions.c_str(),pers->duration);
-    size_t num_cond = 0;
-    if      ( restore == "iovpool" )
-      num_cond = pers->importIOVPool("ConditionsIOVPool No 1","run",manager);
-    else if ( restore == "userpool" )
-      num_cond = pers->importUserPool("*","run",manager);
-    else if ( restore == "condpool" )
-      num_cond = pers->importConditionsPool("*","run",manager);
-    else
-      help(argc,argv);
-
-    printout(ALWAYS,"Statistics","+  Imported %ld conditions from %s to IOV pool. Took %8.3f seconds.",
-             num_cond, restore.c_str(), pers->duration);
+    printout(ALWAYS,"Statistics","+  Imported %ld conditions from mapped snapshot %s. Took %8.3f seconds.",
+             num_cond, conditions.c_str(), snapshot->duration);
     printout(ALWAYS,"Statistics","+=========================================================================");
   }
-  catch(const exception& e)    {
-    printout(ERROR,"ConditionsExample","Failed to import ROOT object(s): %s",e.what());    
-    throw;
+  else if ( restore == "loader" )  {
+    // Nothing is imported: all conditions are read by the loader when first required
+    // The same snapshot may be declared several times under different names
+    // to have it read by several loaders concurrently.
+    cond::ConditionsDataLoader& loader = manager.loader();
+    string prefix;
+    manager.registerIOVType(0,"run");
+    for(int i=0; i<num_sources; ++i, prefix += "./")
+      loader.addSource("mmap_snapshot:"+prefix+conditions);
+    if ( num_threads > 0 ) loader["NumThreads"] = num_threads;
+    printout(ALWAYS,"Statistics","+  Conditions are loaded on demand from mapped snapshot %s [%d sources].",
+             conditions.c_str(), num_sources);
+  }
+  else  {
+    try  {
+      printout(INFO,"ConditionsExample","+  Start conditions import from ROOT object(s): %s",
+               conditions.c_str());
+      auto pers = cond::ConditionsRootPersistency::load(conditions.c_str(),"DD4hep Conditions");
+      printout(ALWAYS,"Statistics","+=========================================================================");
+      printout(ALWAYS,"Statistics","+  Loaded conditions object from file %s. Took %8.3f seconds.",
+               conditions.c_str(),pers->duration);
+      size_t num_cond = 0;
+      if      ( restore == "iovpool" )
+        num_cond = pers->importIOVPool("ConditionsIOVPool No 1","run",manager);
+      else if ( restore == "userpool" )
+        num_cond = pers->importUserPool("*","run",manager);
+      else if ( restore == "condpool" )
+        num_cond = pers->importConditionsPool("*","run",manager);
+      else
+        help(argc,argv);
+
+      printout(ALWAYS,"Statistics","+  Imported %ld conditions from %s to IOV pool. Took %8.3f seconds.",
+               num_cond, restore.c_str(), pers->duration);
+      printout(ALWAYS,"Statistics","+=========================================================================");
+    }
+    catch(const exception& e)    {
+      printout(ERROR,"ConditionsExample","Failed to import ROOT object(s): %s",e.what());    
+      throw;
+    }
   }
   
   // ++++++++++++++++++++++++ Now compute the conditions for each of these IOVs
@@ -122,20 +175,62 @@ static int condition_example (Detector& description, int argc, char** argv)  {
     p.second->print("*");
 
   ConditionsManager::Result total;
+  cond::ConditionsPrefetcher prefetcher(manager, content);
+  int num_prefetched = 0;
   for(int i=0; i<num_iov; ++i)  {
     IOV req_iov(iov_typ,i*10+5);
-    // Select the proper set of conditions and attach them to the user pool
-    ConditionsManager::Result r = manager.prepare(req_iov,*slice);
+    ConditionsManager::Result r;
+    if ( prefetch )  {
+      // Take the prefetched slice and start preparing the next one
+      if ( prefetcher.isPrefetched(req_iov) ) ++num_prefetched;
+      slice = prefetcher.get(req_iov);
+      r = slice->status;
+      if ( i+1 < num_iov ) prefetcher.prefetch(IOV(iov_typ,(i+1)*10+5));
+    }
+    else  {
+      // Select the proper set of conditions and attach them to the user pool
+      r = manager.prepare(req_iov,*slice);
+    }
     total += r;
     if ( 0 == i )  { // First one we print...
       Scanner(ConditionsPrinter(slice.get(),"Example"),description.world());
     }
+    if ( snapshot )  { // Access the payloads referencing the mapped file
+      Scanner().scan(ConditionsDataAccess(req_iov,*slice),description.world());
+    }
     printout(ALWAYS,"Prepare","Total %ld conditions (S:%ld,L:%ld,C:%ld,M:%ld) of IOV %s",
              r.total(), r.selected, r.loaded, r.computed, r.missing, req_iov.str().c_str());
   }  
   printout(ALWAYS,"Statistics","+=========================================================================");
   printout(ALWAYS,"Statistics","+  Accessed a total of %ld conditions (S:%6ld,L:%6ld,C:%6ld,M:%ld)",
            total.total(), total.selected, total.loaded, total.computed, total.missing);
+  if ( restore == "loader" )  {
+    // Every condition may only be registered once, even if read by several loaders
+    size_t num_dup = 0, num_cond = 0;
+    for( const auto& p : pool->elements )  {
+      RangeConditions conds;
+      set<Condition::key_type> keys;
+      p.second->select_all(conds);
+      for( const auto& c : conds ) keys.insert(c.key());
+      num_cond += conds.size();
+      num_dup  += conds.size() - keys.size();
+    }
+    bool ok = num_dup == 0 && total.missing == 0 && total.loaded > 0;
+    printout(ALWAYS,"Statistics","+++ Test %s: %ld conditions registered from %d sources with %d threads. "
+             "Duplicates: %ld", ok ? "PASSED" : "FAILED", num_cond, num_sources, num_threads, num_dup);
+  }
+  if ( !arena.empty() )  {
+    bool ok = total.loaded > 0 && total.missing == 0;
+    printout(ALWAYS,"Statistics","+++ Test %s: Accessed %ld conditions, loaded %ld from shared conditions arena '%s', "
+             "%ld missing.", ok ? "PASSED" : "FAILED", total.total(), total.loaded, arena.c_str(), total.missing);
+  }
+  if ( prefetch )  {
+    bool ok = num_prefetched == num_iov-1 && total.missing == 0;
+    ok &= restore != "loader" || total.loaded > 0;
+    printout(ALWAYS,"Statistics","+++ Test %s: %d of %d slices were prepared in the background. "
+             "Loaded %ld conditions, %ld missing.", ok ? "PASSED" : "FAILED",
+             num_prefetched, num_iov, total.loaded, total.missing);
+  }
   printout(ALWAYS,"Statistics","+=========================================================================");
   // All done.
   return 1;
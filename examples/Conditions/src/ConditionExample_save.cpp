@@ -29,6 +29,7 @@
 #include "DDCond/ConditionsManager.h"
 #include "DDCond/ConditionsIOVPool.h"
 #include "DDCond/ConditionsRootPersistency.h"
+#include "DDCond/ConditionsMappedSnapshot.h"
 #include "DD4hep/Factories.h"
 
 using namespace std;
@@ -44,7 +45,7 @@ using namespace dd4hep::ConditionExamples;
  *  \date    01/12/2016
  */
 static int condition_example (Detector& description, int argc, char** argv)  {
-  string input, conditions;
+  string input, conditions, mapped, arena;
   int    num_iov = 10;
   bool   arg_error = false;
   bool   output_iovpool  = true;
@@ -58,6 +59,10 @@ static int condition_example (Detector& description, int argc, char** argv)  {
       conditions = argv[++i];
     else if ( 0 == ::strncmp("-iovs",argv[i],4) )
       num_iov = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-mapped",argv[i],4) )
+      mapped = argv[++i];
+    else if ( 0 == ::strncmp("-shared",argv[i],4) )
+      arena = argv[++i];
     else
       arg_error = true;
   }
@@ -69,6 +74,8 @@ static int condition_example (Detector& description, int argc, char** argv)  {
       "     -input       <string>    Geometry file                                   \n"
       "     -conditions  <string>    Conditions output file                          \n"
       "     -iovs        <number>    Number of parallel IOV slots for processing.    \n"
+      "     -mapped      <string>    Optional memory mapped snapshot output file     \n"
+      "     -shared      <string>    Optional shared conditions arena to be published\n"
       "\tArguments given: " << arguments(argc,argv) << endl << flush;
     ::exit(EINVAL);
   }
@@ -163,6 +170,25 @@ static int condition_example (Detector& description, int argc, char** argv)  {
              "+++ Successfully saved %ld condition to file.",total_count);
   }
   delete persist;
+
+  if ( !mapped.empty() || !arena.empty() )  {
+    /// Save the IOV pool also as a memory mapped snapshot
+    cond::ConditionsMappedSnapshot snapshot;
+    count = snapshot.add("ConditionsIOVPool No 1",*manager.iovPool(*iov_typ));
+    if ( !mapped.empty() )  {
+      size_t nbytes = snapshot.save(mapped);
+      printout(ALWAYS,"Example",
+               "+++ Wrote %ld Bytes (%ld conditions) of data to mapped snapshot '%s'  [%8.3f seconds].",
+               nbytes, count, mapped.c_str(), snapshot.duration);
+    }
+    if ( !arena.empty() )  {
+      /// Worker processes attach with: manager["SharedArena"] = arena
+      size_t nbytes = snapshot.publish(arena);
+      printout(ALWAYS,"Example",
+               "+++ Published %ld Bytes (%ld conditions) to shared conditions arena '%s'  [%8.3f seconds].",
+               nbytes, count, arena.c_str(), snapshot.duration);
+    }
+  }
   
   printout(ALWAYS,"Statistics","+=========================================================================");
   printout(ALWAYS,"Statistics","+  Accessed a total of %ld conditions (S:%6ld,L:%6ld,C:%6ld,M:%ld)",
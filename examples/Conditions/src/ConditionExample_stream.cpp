@@ -0,0 +1,186 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+/*
+   Plugin invocation:
+   ==================
+   This plugin behaves like a main program.
+   Invoke the plugin with something like this:
+
+   geoPluginRun -volmgr -destroy -plugin DD4hep_ConditionExample_stream \
+   -input file:${DD4hep_DIR}/examples/AlignDet/compact/Telescope.xml
+
+   Check the XML syntax handled by the streaming conditions reader:
+   character references, CDATA sections, comments, processing instructions
+   and the document type declaration. Malformed input must be rejected.
+   The test files are written to the current working directory.
+
+*/
+// Framework include files
+#include "ConditionExampleObjects.h"
+#include "DDCond/ConditionsPool.h"
+#include "DDCond/ConditionsXmlStreamReader.h"
+#include "DD4hep/Factories.h"
+
+// C/C++ include files
+#include <fstream>
+
+using namespace std;
+using namespace dd4hep;
+using namespace dd4hep::ConditionExamples;
+
+namespace {
+
+  /// Well formed input using the less common XML constructs
+  const char* s_wellFormed =
+    "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+    "<!DOCTYPE conditions [\n"
+    "  <!ELEMENT conditions ANY>\n"
+    "  <!ATTLIST value name CDATA #IMPLIED type CDATA #IMPLIED>\n"
+    "]>\n"
+    "<conditions>\n"
+    "  <!-- Comments may contain markup: <value name=\"hidden\" type=\"double\" value=\"1\"/> -->\n"
+    "  <?some-instruction data?>\n"
+    "  <iov validity=\"1,10#run\">\n"
+    "    <detelement path=\"/world/Telescope\">\n"
+    "      <value name=\"entities\" type=\"string\" value=\"a&lt;b &amp; &quot;c&quot; &apos;&#65;&#x42;&apos;\"/>\n"
+    "      <value name=\"cdata\" type=\"string\"><![CDATA[x < y && z > 0]]></value>\n"
+    "      <value name=\"text\" type=\"double\"><!-- ignored 7 -->4&#50;<!-- > --></value>\n"
+    "      <value name=\"expression\" type=\"double\" value=\"2*3\"/>\n"
+    "      <pressure name=\"pressure\" value=\"1.5\"/>\n"
+    "      <value\n"
+    "        name = 'quotes'\n"
+    "        type = 'string'\n"
+    "        value= 'say \"hi\"'  />\n"
+    "    </detelement>\n"
+    "  </iov>\n"
+    "</conditions>\n";
+
+  /// Malformed input: Each must be rejected by the reader
+  const pair<const char*,const char*> s_malformed[] = {
+    { "unclosed element",
+      "<conditions><iov validity=\"1,10#run\">" },
+    { "mismatched end tag",
+      "<conditions><iov validity=\"1,10#run\"></detelement></conditions>" },
+    { "unbalanced end tag",
+      "<conditions></conditions></conditions>" },
+    { "unterminated comment",
+      "<conditions><!-- comment </conditions>" },
+    { "unterminated CDATA section",
+      "<conditions><iov validity=\"1,10#run\"><value name=\"a\" type=\"string\"><![CDATA[ abc" },
+    { "unterminated document type declaration",
+      "<!DOCTYPE conditions [ <!ELEMENT conditions ANY> <conditions/>" },
+    { "unquoted attribute value",
+      "<conditions><iov validity=1,10#run></iov></conditions>" },
+    { "unterminated attribute value",
+      "<conditions><iov validity=\"1,10#run></iov></conditions>" },
+    { "malformed tag",
+      "<conditions>< iov/></conditions>" },
+    { "malformed character reference",
+      "<conditions>&amp</conditions>" },
+    { "value without type",
+      "<conditions><iov validity=\"1,10#run\"><detelement path=\"/world/Telescope\">"
+      "<value name=\"untyped\" value=\"1\"/></detelement></iov></conditions>" }
+  };
+
+  /// Write the test input to a file
+  string write_file(const string& name, const char* content)   {
+    ofstream out(name);
+    out << content;
+    return name;
+  }
+}
+
+/// Plugin function: Check the XML syntax handled by the streaming conditions reader
+/**
+ *  Factory: DD4hep_ConditionExample_stream
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \date    01/12/2016
+ */
+static int condition_example (Detector& description, int argc, char** argv)  {
+  string input;
+  bool   arg_error = false;
+  for(int i=0; i<argc && argv[i]; ++i)  {
+    if ( 0 == ::strncmp("-input",argv[i],4) )
+      input = argv[++i];
+    else
+      arg_error = true;
+  }
+  if ( arg_error || input.empty() )   {
+    /// Help printout describing the basic command line interface
+    cout <<
+      "Usage: -plugin <name> -arg [-arg]                                             \n"
+      "     name:   factory name     DD4hep_ConditionExample_stream                  \n"
+      "     -input       <string>    Geometry file                                   \n"
+      "\tArguments given: " << arguments(argc,argv) << endl << flush;
+    ::exit(EINVAL);
+  }
+
+  // First we load the geometry
+  description.fromXML(input);
+
+  /******************** Initialize the conditions manager *****************/
+  ConditionsManager manager = installManager(description);
+  manager.registerIOVType(0,"run");
+
+  /******************** Well formed input *********************************/
+  int num_errors = 0;
+  cond::ConditionsXmlStreamReader reader(description, manager);
+  size_t num_cond = reader.parse(write_file("StreamReader_wellformed.xml", s_wellFormed));
+
+  DetElement       det  = description.world().child("Telescope");
+  cond::ConditionsPool* pool = manager.registerIOV("1,10#run");
+  auto check = [&num_errors, det, pool](const char* name, auto expected)  {
+    typedef decltype(expected) value_t;
+    Condition cond = pool->exists(ConditionKey::hashCode(det, name));
+    bool ok = cond.isValid() && cond.typeInfo() == typeid(value_t) && cond.get<value_t>() == expected;
+    if ( !ok ) ++num_errors;
+    printout(ok ? INFO : ALWAYS,"ConditionsStream","+++ Condition %-12s %s", name, ok ? "OK" : "has wrong value");
+  };
+  check("entities",   string("a<b & \"c\" 'AB'"));
+  check("cdata",      string("x < y && z > 0"));
+  check("text",       42e0);
+  check("expression", 6e0);
+  check("pressure",   1.5e0);
+  check("quotes",     string("say \"hi\""));
+  if ( num_cond != 6 )   {
+    printout(ALWAYS,"ConditionsStream","+++ Read %ld conditions. Expected 6 (comments must be skipped)",
+             long(num_cond));
+    ++num_errors;
+  }
+
+  /******************** Malformed input must be rejected ******************/
+  for( const auto& m : s_malformed )   {
+    bool rejected = false;
+    PrintLevel lvl = setPrintLevel(FATAL);   // The reader reports the error before throwing
+    try  {
+      reader.parse(write_file("StreamReader_malformed.xml", m.second));
+    }
+    catch(const std::exception&)  {
+      rejected = true;
+    }
+    setPrintLevel(lvl);
+    if ( !rejected ) ++num_errors;
+    printout(rejected ? INFO : ALWAYS,"ConditionsStream","+++ Malformed input: %-40s %s",
+             m.first, rejected ? "rejected" : "NOT rejected");
+  }
+  printout(ALWAYS,"ConditionsStream","+++ Test %s: Read %ld conditions from well formed input. "
+           "Checked %ld malformed inputs. Errors: %d", num_errors == 0 ? "PASSED" : "FAILED",
+           long(num_cond), long(sizeof(s_malformed)/sizeof(s_malformed[0])), num_errors);
+  // All done.
+  return 1;
+}
+
+// first argument is the type from the xml file
+DECLARE_APPLY(DD4hep_ConditionExample_stream,condition_example)
@@ -22,9 +22,14 @@
    Populate the conditions store by hand for a set of IOVs.
    Then compute the corresponding alignment entries....
 
+   With the option -threads <n> the derived conditions are computed by n
+   worker threads. The same conditions are registered as well for a second
+   IOV type and computed sequentially. Both results must be identical.
+
 */
 // Framework include files
 #include "ConditionExampleObjects.h"
+#include "DDCond/ConditionsPrefetcher.h"
 #include "DD4hep/Factories.h"
 #include "TStatistic.h"
 #include "TTimeStamp.h"
@@ -33,6 +38,41 @@ using namespace std;
 using namespace dd4hep;
 using namespace dd4hep::ConditionExamples;
 
+namespace  {
+  /// Compare the derived conditions of two slices. Returns the number of differences
+  size_t compare_derived(const ConditionsSlice& slice, const ConditionsSlice& reference, size_t& checked)  {
+    size_t bad = 0;
+    for( const auto& d : slice.content->derived() )  {
+      DetElement de  = d.second->detector;
+      Condition  c   = slice.get(de, d.second->target.item_key());
+      Condition  r   = reference.get(de, d.second->target.item_key());
+      bool       ok  = c.isValid() && r.isValid() && c.typeInfo() == r.typeInfo();
+      if ( ok && c.typeInfo() == typeid(vector<int>) )  {
+        ok = c.get<vector<int> >() == r.get<vector<int> >();
+      }
+      else if ( ok && c.typeInfo() == typeid(NonDefaultCtorCond) )  {
+        const NonDefaultCtorCond& a = c.get<NonDefaultCtorCond>();
+        const NonDefaultCtorCond& b = r.get<NonDefaultCtorCond>();
+        ok = a.a == b.a && a.b == b.b && a.c == b.c && a.d == b.d;
+      }
+      else if ( ok && c.typeInfo() == typeid(vector<Condition>) )  {
+        const vector<Condition>& a = c.get<vector<Condition> >();
+        const vector<Condition>& b = r.get<vector<Condition> >();
+        ok = a.size() == b.size();
+        for( size_t i=0; ok && i<a.size(); ++i )
+          ok = a[i].get<string>() == b[i].get<string>();
+      }
+      if ( !ok )  {
+        printout(ERROR,"Compare","++ Derived condition %016llX of %s differs from the sequential result.",
+                 d.first, de.path().c_str());
+        ++bad;
+      }
+      ++checked;
+    }
+    return bad;
+  }
+}
+
 /// Plugin function: Condition program example
 /**
  *  Factory: DD4hep_ConditionExample_stress2
@@ -43,13 +83,19 @@ using namespace dd4hep::ConditionExamples;
  */
 static int condition_example (Detector& description, int argc, char** argv)  {
   string input;
-  int    num_iov = 10;
-  bool   arg_error = false;
+  int    num_iov = 10, num_threads = 0;
+  bool   arg_error = false, prefetch = false, arena = false;
   for(int i=0; i<argc && argv[i]; ++i)  {
     if ( 0 == ::strncmp("-input",argv[i],4) )
       input = argv[++i];
     else if ( 0 == ::strncmp("-iovs",argv[i],4) )
       num_iov = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-prefetch",argv[i],4) )
+      prefetch = true;
+    else if ( 0 == ::strncmp("-arena",argv[i],4) )
+      arena = true;
+    else if ( 0 == ::strncmp("-threads",argv[i],4) )
+      num_threads = ::atol(argv[++i]);
     else
       arg_error = true;
   }
@@ -60,6 +106,11 @@ static int condition_example (Detector& description, int argc, char** argv)  {
       "     name:   factory name     DD4hep_ConditionExample_stress2                 \n"
       "     -input   <string>        Geometry file                                   \n"
       "     -iovs    <number>        Number of collision loads to be performed.      \n"
+      "     -prefetch                Prepare the slice of the next IOV in the background.\n"
+      "                              All conditions are created before the first access.\n"
+      "     -arena                   Allocate the derived conditions from a slice arena.\n"
+      "     -threads <number>        Compute the derived conditions with worker threads\n"
+      "                              and compare them to the sequential result.      \n"
       "\tArguments given: " << arguments(argc,argv) << endl << flush;
     ::exit(EINVAL);
   }
@@ -72,26 +123,37 @@ static int condition_example (Detector& description, int argc, char** argv)  {
   const IOVType*    iov_typ = manager.registerIOVType(0,"run").second;
   if ( 0 == iov_typ )
     except("ConditionsPrepare","++ Unknown IOV type supplied.");
+  const IOVType*    ref_typ = num_threads > 0 ? manager.registerIOVType(1,"sequential").second : 0;
 
   /******************** Now as usual: create the slice ********************/
   shared_ptr<ConditionsContent> content(new ConditionsContent());
   shared_ptr<ConditionsSlice> slice(new ConditionsSlice(manager,content));
+  if ( arena ) slice->useArena();
+  shared_ptr<ConditionsSlice> reference(new ConditionsSlice(manager,content));
   Scanner(ConditionsKeys(*content,INFO),description.world());
   Scanner(ConditionsDependencyCreator(*content,DEBUG),description.world());
 
-  size_t total_created = 0;
+  size_t total_created = 0, num_checked = 0, num_bad = 0;
   ConditionsManager::Result total;
   TStatistic cr_stat("Creation"), acc_stat("Access");
+  ConditionsPrefetcher prefetcher(manager, content);
   // ++++++++++++++++++++++++ Now compute the conditions for each of these IOVs
   for(int i=0; i<num_iov; ++i)  {
-    {
+    // When prefetching, all conditions are created before the first access
+    int first = prefetch ? (i == 0 ? 0 : num_iov) : i;
+    int last  = prefetch ? num_iov : i+1;
+    for(int j=first; j<last; ++j)  {
       TTimeStamp start;
-      IOV iov(iov_typ, IOV::Key(1+i*10,(i+1)*10));
+      IOV iov(iov_typ, IOV::Key(1+j*10,(j+1)*10));
       ConditionsPool*   iov_pool = manager.registerIOV(*iov.iovType, iov.key());
       // Create conditions with all deltas. Use a generic creator
       int count = Scanner().scan(ConditionsCreator(*slice, *iov_pool, DEBUG),description.world());
       TTimeStamp stop;
       total_created += count;
+      if ( ref_typ )  {
+        ConditionsPool* ref_pool = manager.registerIOV(*ref_typ, iov.key());
+        Scanner().scan(ConditionsCreator(*reference, *ref_pool, DEBUG),description.world());
+      }
       cr_stat.Fill(stop.AsDouble()-start.AsDouble());
       printout(INFO,"Creating", "Setup %-6ld conditions for IOV:%-60s  [%8.3f sec]",
                count, iov.str().c_str(), stop.AsDouble()-start.AsDouble());
@@ -99,8 +161,23 @@ static int condition_example (Detector& description, int argc, char** argv)  {
       TTimeStamp start;
       IOV req_iov(iov_typ,i*10+5);
       // Attach the proper set of conditions to the user pool
-      ConditionsManager::Result res = manager.prepare(req_iov,*slice);
+      ConditionsManager::Result res;
+      if ( prefetch )  {
+        // Take the prefetched slice and start preparing the next one
+        res = prefetcher.get(req_iov)->status;
+        if ( i+1 < num_iov ) prefetcher.prefetch(IOV(iov_typ,(i+1)*10+5));
+      }
+      else  {
+        if ( ref_typ ) manager["DerivedConditionsThreads"] = num_threads;
+        res = manager.prepare(req_iov,*slice);
+      }
       TTimeStamp stop;
+      if ( ref_typ )  {
+        // Sequential reference computation of the same conditions
+        manager["DerivedConditionsThreads"] = 0;
+        manager.prepare(IOV(ref_typ,i*10+5),*reference);
+        num_bad += compare_derived(*slice, *reference, num_checked);
+      }
       total += res;
       acc_stat.Fill(stop.AsDouble()-start.AsDouble());
       // Now compute the tranformation matrices
@@ -116,7 +193,15 @@ static int condition_example (Detector& description, int argc, char** argv)  {
            acc_stat.GetName(), acc_stat.GetMean(), acc_stat.GetMeanErr(), acc_stat.GetRMS(), acc_stat.GetN());
   printout(INFO,"Statistics","+  Accessed a total of %ld conditions (S:%6ld,L:%6ld,C:%6ld,M:%ld)",
            total.total(), total.selected, total.loaded, total.computed, total.missing, total_created);
+  if ( slice->arena )  {
+    printout(INFO,"Statistics","+  Arena: %ld allocations [%ld bytes] from %ld chunks",
+             slice->arena->numAllocations(), slice->arena->numBytes(), slice->arena->numChunks());
+  }
   printout(INFO,"Statistics","+=========================================================================");
+  if ( ref_typ )  {
+    printout(ALWAYS,"Statistics","+++ Test %s: %ld derived conditions computed with %d threads. Differences: %ld",
+             num_bad == 0 && num_checked > 0 ? "PASSED" : "FAILED", num_checked, num_threads, num_bad);
+  }
   // All done.
   return 1;
 }